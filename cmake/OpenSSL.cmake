@@ -24,6 +24,8 @@ if (WITH_TLS)
             src/base/net/tls/TlsContext.h
             src/base/net/tls/TlsGen.cpp
             src/base/net/tls/TlsGen.h
+            src/base/net/tls/TlsHandshakePool.cpp
+            src/base/net/tls/TlsHandshakePool.h
             src/proxy/tls/MinerTls.cpp
             src/proxy/tls/MinerTls.h
             )
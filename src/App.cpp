@@ -23,16 +23,20 @@
 
 #include "App.h"
 #include "base/io/Console.h"
+#include "base/io/log/FileLogWriter.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/io/Signals.h"
+#include "base/kernel/Process.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "proxy/Proxy.h"
 #include "Summary.h"
 #include "version.h"
 
 
-xmrig::App::App(Process *process)
+xmrig::App::App(Process *process) :
+    m_process(process)
 {
     m_controller = std::make_shared<Controller>(process);
 }
@@ -110,6 +114,20 @@ void xmrig::App::onSignal(int signum)
         LOG_WARN("%s " YELLOW("SIGINT received, exiting"), Tags::signal());
         break;
 
+#   ifdef SIGUSR1
+    case SIGUSR1:
+        LOG_INFO("%s " WHITE_BOLD("reopening log files"), Tags::signal());
+        FileLogWriter::reopenAll();
+        return;
+#   endif
+
+#   ifdef XMRIG_OS_UNIX
+    case SIGUSR2:
+        LOG_INFO("%s " WHITE_BOLD("binary upgrade requested"), Tags::signal());
+        m_controller->proxy()->upgrade(m_process->arguments());
+        return;
+#   endif
+
     default:
         return;
     }
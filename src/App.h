@@ -58,6 +58,7 @@ private:
     std::shared_ptr<Console> m_console;
     std::shared_ptr<Controller> m_controller;
     std::shared_ptr<Signals> m_signals;
+    Process *m_process;
 };
 
 
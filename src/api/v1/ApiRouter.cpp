@@ -24,21 +24,40 @@
 
 #include "api/v1/ApiRouter.h"
 #include "3rdparty/rapidjson/document.h"
+#include "api/v1/ApiSnapshot.h"
 #include "base/api/interfaces/IApiRequest.h"
 #include "base/kernel/Platform.h"
-#include "base/tools/Buffer.h"
+#include "base/net/dns/Dns.h"
+#include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "proxy/Counters.h"
+#include "proxy/Metrics.h"
 #include "proxy/Miner.h"
+#include "proxy/Proxy.h"
 #include "version.h"
 
 
+#ifdef XMRIG_FEATURE_TLS
+#   include "base/net/tls/TlsContext.h"
+#endif
+
+
 #include <cmath>
 #include <cstring>
 #include <uv.h>
 
 
+namespace xmrig {
+
+
+// Optional tables are built while they were requested at least once during this period.
+static const uint64_t kDemandTimeout = 60 * 1000;
+
+
+} // namespace xmrig
+
+
 static inline double normalize(double d)
 {
     if (!std::isnormal(d)) {
@@ -52,43 +71,172 @@ static inline double normalize(double d)
 xmrig::ApiRouter::ApiRouter(Base *base) :
     m_base(base)
 {
+    for (auto &demand : m_demand) {
+        demand = 0;
+    }
 }
 
 
 xmrig::ApiRouter::~ApiRouter() = default;
 
 
+void xmrig::ApiRouter::tick()
+{
+    auto controller      = static_cast<Controller *>(m_base);
+    const auto &stats    = controller->statsData();
+    const auto &list     = controller->workers();
+    const uint64_t now   = Chrono::steadyMSecs();
+    const auto previous  = snapshot();
+
+    std::shared_ptr<ApiSnapshot> s = std::make_shared<ApiSnapshot>();
+    s->mode           = controller->config()->modeName();
+    s->workersMode    = Workers::modeName(controller->config()->workersMode());
+    s->fanout         = Metrics::fanout();
+    s->propagation    = Metrics::propagation();
+    s->slowJobs       = Metrics::slowJobs();
+    s->stats          = stats.counters();
+    s->pools          = controller->proxy()->metrics()->pools();
+    s->avgTime        = stats.avgTime();
+    s->donateLevel    = static_cast<uint32_t>(controller->config()->pools().donateLevel());
+    s->metricsWorkers = controller->config()->metricsWorkers();
+    s->miners         = Counters::miners();
+    s->workersCount   = list.size();
+    s->dns            = Dns::toJSON(s->doc);
+
+    s->phases.reserve(Metrics::PhaseMax);
+    for (size_t i = 0; i < Metrics::PhaseMax; ++i) {
+        s->phases.push_back(Metrics::phase(static_cast<Metrics::Phase>(i)));
+    }
+
+#   ifdef XMRIG_FEATURE_TLS
+    const TlsContext *tls = controller->proxy()->tls();
+    if (tls) {
+        s->tls = tls->toJSON(s->doc);
+    }
+#   endif
+
+    // The median latency needs a copy and a partial sort of all samples.
+    s->avgLatency = (previous && !isWanted(DemandResults, now)) ? previous->avgLatency : stats.avgLatency();
+
+    if (isWanted(DemandWorkers, now)) {
+        auto workers = std::make_shared<std::vector<ApiSnapshot::Worker>>();
+        workers->reserve(list.size());
+
+        for (const Worker &worker : list) {
+            workers->push_back({ { worker.hashrate(60), worker.hashrate(600), worker.hashrate(3600), worker.hashrate(3600 * 12), worker.hashrate(3600 * 24) },
+                                 worker.ip(), worker.name(), worker.accepted(), worker.connections(), worker.hashes(), worker.invalid(), worker.lastHash(), worker.rejected() });
+        }
+
+        s->workersTable = workers;
+    }
+
+    if (isWanted(DemandMiners, now)) {
+        auto miners = std::make_shared<std::vector<ApiSnapshot::Miner>>();
+
+        for (const Miner *miner : controller->miners()) {
+            if (miner->mapperId() == -1) {
+                continue;
+            }
+
+            miners->push_back({ miner->id(), miner->state(), miner->ip(), miner->agent(), miner->password(), miner->rigId(), miner->user(), miner->diff(), miner->rx(), miner->tx() });
+        }
+
+        s->minersTable = miners;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_snapshot = s;
+}
+
+
 void xmrig::ApiRouter::onRequest(IApiRequest &request)
 {
-    if (request.method() == IApiRequest::METHOD_GET) {
-        if (request.type() == IApiRequest::REQ_SUMMARY) {
+    if (request.method() != IApiRequest::METHOD_GET) {
+        return;
+    }
+
+    const auto s = snapshot();
+    if (!s) {
+        return;
+    }
+
+    if (request.type() == IApiRequest::REQ_SUMMARY) {
+        want(DemandResults);
+
+        request.accept();
+        getMiner(request.reply(), request.doc(), *s);
+        getHashrate(request.reply(), request.doc(), *s);
+        getMinersSummary(request.reply(), request.doc(), *s);
+        getResults(request.reply(), request.doc(), *s);
+        getPropagation(request.reply(), request.doc(), *s);
+        getTls(request.reply(), request.doc(), *s);
+    }
+    else if (request.url() == "/1/workers") {
+        want(DemandWorkers);
+
+        if (s->workersTable) {
             request.accept();
-            getMiner(request.reply(), request.doc());
-            getHashrate(request.reply(), request.doc());
-            getMinersSummary(request.reply(), request.doc());
-            getResults(request.reply(), request.doc());
+            getHashrate(request.reply(), request.doc(), *s);
+            getWorkers(request.reply(), request.doc(), *s);
         }
-        else if (request.url() == "/1/workers") {
+    }
+    else if (request.url() == "/1/miners") {
+        want(DemandMiners);
+
+        if (s->minersTable) {
             request.accept();
-            getHashrate(request.reply(), request.doc());
-            getWorkers(request.reply(), request.doc());
+            getMiners(request.reply(), request.doc(), *s);
         }
-        else if (request.url() == "/1/miners") {
-            request.accept();
-            getMiners(request.reply(), request.doc());
+    }
+    else if (request.url() == "/1/dns") {
+        request.accept();
+        request.reply().AddMember("dns", rapidjson::Value(s->dns, request.doc().GetAllocator()), request.doc().GetAllocator());
+    }
+    else if (request.url() == "/metrics") {
+        if (s->metricsWorkers > 0) {
+            want(DemandWorkers);
+
+            if (!s->workersTable && s->workersCount > 0) {
+                return;
+            }
         }
+
+        request.accept();
+        request.setText(Metrics::toText(*s), Metrics::kContentType);
     }
 }
 
 
-void xmrig::ApiRouter::getHashrate(rapidjson::Value &reply, rapidjson::Document &doc) const
+bool xmrig::ApiRouter::isWanted(Demand demand, uint64_t now) const
+{
+    const uint64_t ts = m_demand[demand];
+
+    return ts && now - ts < kDemandTimeout;
+}
+
+
+std::shared_ptr<const xmrig::ApiSnapshot> xmrig::ApiRouter::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_snapshot;
+}
+
+
+void xmrig::ApiRouter::want(Demand demand)
+{
+    m_demand[demand] = Chrono::steadyMSecs();
+}
+
+
+void xmrig::ApiRouter::getHashrate(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
 {
     auto &allocator = doc.GetAllocator();
 
     rapidjson::Value hashrate(rapidjson::kObjectType);
     rapidjson::Value total(rapidjson::kArrayType);
 
-    auto &stats = static_cast<Controller *>(m_base)->statsData();
+    auto &stats = snapshot.stats;
 
     for (size_t i = 0; i < sizeof(stats.hashrate) / sizeof(stats.hashrate[0]); i++) {
         total.PushBack(normalize(stats.hashrate[i]), allocator);
@@ -99,17 +247,17 @@ void xmrig::ApiRouter::getHashrate(rapidjson::Value &reply, rapidjson::Document
 }
 
 
-void xmrig::ApiRouter::getMiner(rapidjson::Value &reply, rapidjson::Document &doc) const
+void xmrig::ApiRouter::getMiner(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
 {
     auto &allocator = doc.GetAllocator();
-    auto &stats = static_cast<Controller *>(m_base)->statsData();
+    auto &stats = snapshot.stats;
 
     reply.AddMember("version",      APP_VERSION, allocator);
     reply.AddMember("kind",         APP_KIND, allocator);
     reply.AddMember("algo",         "invalid", allocator);
-    reply.AddMember("mode",         rapidjson::StringRef(m_base->config()->modeName()), allocator);
+    reply.AddMember("mode",         rapidjson::StringRef(snapshot.mode), allocator);
     reply.AddMember("ua",           Platform::userAgent().toJSON(), allocator);
-    reply.AddMember("donate_level", m_base->config()->pools().donateLevel(), allocator);
+    reply.AddMember("donate_level", snapshot.donateLevel, allocator);
 
     if (stats.hashes && stats.donateHashes) {
         reply.AddMember("donated", normalize((double) stats.donateHashes / stats.hashes * 100.0), allocator);
@@ -120,31 +268,26 @@ void xmrig::ApiRouter::getMiner(rapidjson::Value &reply, rapidjson::Document &do
 }
 
 
-void xmrig::ApiRouter::getMiners(rapidjson::Value &reply, rapidjson::Document &doc) const
+void xmrig::ApiRouter::getMiners(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
 {
     using namespace rapidjson;
 
     auto &allocator = doc.GetAllocator();
-    auto list       = static_cast<Controller *>(m_base)->miners();
 
     Value miners(kArrayType);
 
-    for (const xmrig::Miner *miner : list) {
-        if (miner->mapperId() == -1) {
-            continue;
-        }
-
+    for (const ApiSnapshot::Miner &miner : *snapshot.minersTable) {
         Value value(kArrayType);
-        value.PushBack(miner->id(),                allocator);
-        value.PushBack(StringRef(miner->ip()),     allocator);
-        value.PushBack(miner->tx(),                allocator);
-        value.PushBack(miner->rx(),                allocator);
-        value.PushBack(miner->state(),             allocator);
-        value.PushBack(miner->diff(),              allocator);
-        value.PushBack(miner->user().toJSON(),     allocator);
-        value.PushBack(miner->password().toJSON(), allocator);
-        value.PushBack(miner->rigId().toJSON(),    allocator);
-        value.PushBack(miner->agent().toJSON(),    allocator);
+        value.PushBack(miner.id,                            allocator);
+        value.PushBack(Value(miner.ip.c_str(), allocator),  allocator);
+        value.PushBack(miner.tx,                            allocator);
+        value.PushBack(miner.rx,                            allocator);
+        value.PushBack(miner.state,                         allocator);
+        value.PushBack(miner.diff,                          allocator);
+        value.PushBack(miner.user.toJSON(doc),              allocator);
+        value.PushBack(miner.password.toJSON(doc),          allocator);
+        value.PushBack(miner.rigId.toJSON(doc),             allocator);
+        value.PushBack(miner.agent.toJSON(doc),             allocator);
 
         miners.PushBack(value, allocator);
     }
@@ -166,10 +309,10 @@ void xmrig::ApiRouter::getMiners(rapidjson::Value &reply, rapidjson::Document &d
 }
 
 
-void xmrig::ApiRouter::getMinersSummary(rapidjson::Value &reply, rapidjson::Document &doc) const
+void xmrig::ApiRouter::getMinersSummary(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
 {
     auto &allocator = doc.GetAllocator();
-    auto &stats = static_cast<Controller *>(m_base)->statsData();
+    auto &stats = snapshot.stats;
 
     rapidjson::Value miners(rapidjson::kObjectType);
 
@@ -177,7 +320,7 @@ void xmrig::ApiRouter::getMinersSummary(rapidjson::Value &reply, rapidjson::Docu
     miners.AddMember("max", stats.maxMiners, allocator);
 
     reply.AddMember("miners",  miners, allocator);
-    reply.AddMember("workers", static_cast<uint64_t>(static_cast<Controller *>(m_base)->workers().size()), allocator);
+    reply.AddMember("workers", snapshot.workersCount, allocator);
 
     rapidjson::Value upstreams(rapidjson::kObjectType);
 
@@ -185,16 +328,60 @@ void xmrig::ApiRouter::getMinersSummary(rapidjson::Value &reply, rapidjson::Docu
     upstreams.AddMember("sleep",  stats.upstreams.sleep, allocator);
     upstreams.AddMember("error",  stats.upstreams.error, allocator);
     upstreams.AddMember("total",  stats.upstreams.total, allocator);
-    upstreams.AddMember("ratio",  normalize(stats.upstreams.ratio(Counters::miners())), allocator);
+    upstreams.AddMember("ratio",  normalize(stats.upstreams.ratio(snapshot.miners)), allocator);
 
     reply.AddMember("upstreams", upstreams, allocator);
+
+    rapidjson::Value reload(rapidjson::kObjectType);
+
+    reload.AddMember("state",   rapidjson::StringRef(ReloadStatus::stateName(stats.reload.state)), allocator);
+    reload.AddMember("done",    stats.reload.done, allocator);
+    reload.AddMember("pending", stats.reload.pending, allocator);
+    reload.AddMember("failed",  stats.reload.failed, allocator);
+    reload.AddMember("total",   stats.reload.total, allocator);
+
+    reply.AddMember("reload", reload, allocator);
 }
 
 
-void xmrig::ApiRouter::getResults(rapidjson::Value &reply, rapidjson::Document &doc) const
+/**
+ * New job propagation times in microseconds: average and estimated p50/p99 of each phase,
+ * serialize and enqueue are per miner, fanout is per mapper and total is from the pool message until the job is queued for the last miner.
+ */
+void xmrig::ApiRouter::getPropagation(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
+{
+    using namespace rapidjson;
+
+    auto &allocator = doc.GetAllocator();
+
+    auto summary = [&allocator](const Histogram &histogram) {
+        Value value(kObjectType);
+        value.AddMember("avg", static_cast<uint64_t>(histogram.count() ? histogram.sum() / histogram.count() * 1e6 : 0.0), allocator);
+        value.AddMember("p50", static_cast<uint64_t>(histogram.quantile(0.5) * 1e6), allocator);
+        value.AddMember("p99", static_cast<uint64_t>(histogram.quantile(0.99) * 1e6), allocator);
+
+        return value;
+    };
+
+    Value propagation(kObjectType);
+    propagation.AddMember("jobs",  snapshot.propagation.count(), allocator);
+    propagation.AddMember("slow",  snapshot.slowJobs, allocator);
+    propagation.AddMember("total", summary(snapshot.propagation), allocator);
+
+    for (size_t i = 0; i < snapshot.phases.size(); ++i) {
+        propagation.AddMember(StringRef(Metrics::phaseName(static_cast<Metrics::Phase>(i))), summary(snapshot.phases[i]), allocator);
+    }
+
+    propagation.AddMember("fanout", summary(snapshot.fanout), allocator);
+
+    reply.AddMember("propagation", propagation, allocator);
+}
+
+
+void xmrig::ApiRouter::getResults(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
 {
     auto &allocator = doc.GetAllocator();
-    auto &stats = static_cast<Controller *>(m_base)->statsData();
+    auto &stats = snapshot.stats;
 
     rapidjson::Value results(rapidjson::kObjectType);
 
@@ -202,8 +389,8 @@ void xmrig::ApiRouter::getResults(rapidjson::Value &reply, rapidjson::Document &
     results.AddMember("rejected",      stats.rejected, allocator);
     results.AddMember("invalid",       stats.invalid, allocator);
     results.AddMember("expired",       stats.expired, allocator);
-    results.AddMember("avg_time",      stats.avgTime(), allocator);
-    results.AddMember("latency",       stats.avgLatency(), allocator);
+    results.AddMember("avg_time",      snapshot.avgTime, allocator);
+    results.AddMember("latency",       snapshot.avgLatency, allocator);
     results.AddMember("hashes_total",  stats.hashes, allocator);
     results.AddMember("hashes_donate", stats.donateHashes, allocator);
 
@@ -218,34 +405,40 @@ void xmrig::ApiRouter::getResults(rapidjson::Value &reply, rapidjson::Document &
 }
 
 
-void xmrig::ApiRouter::getWorkers(rapidjson::Value &reply, rapidjson::Document &doc) const
+void xmrig::ApiRouter::getTls(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
+{
+    if (!snapshot.tls.IsNull()) {
+        reply.AddMember("tls", rapidjson::Value(snapshot.tls, doc.GetAllocator()), doc.GetAllocator());
+    }
+}
+
+
+void xmrig::ApiRouter::getWorkers(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot)
 {
     using namespace rapidjson;
 
     auto &allocator = doc.GetAllocator();
-    auto &list      = static_cast<Controller *>(m_base)->workers();
 
     Value workers(kArrayType);
 
-    for (const Worker &worker : list) {
+    for (const ApiSnapshot::Worker &worker : *snapshot.workersTable) {
          Value array(kArrayType);
-         array.PushBack(StringRef(worker.name()), allocator);
-         array.PushBack(StringRef(worker.ip()), allocator);
-         array.PushBack(worker.connections(), allocator);
-         array.PushBack(worker.accepted(), allocator);
-         array.PushBack(worker.rejected(), allocator);
-         array.PushBack(worker.invalid(), allocator);
-         array.PushBack(worker.hashes(), allocator);
-         array.PushBack(worker.lastHash(), allocator);
-         array.PushBack(normalize(worker.hashrate(60)), allocator);
-         array.PushBack(normalize(worker.hashrate(600)), allocator);
-         array.PushBack(normalize(worker.hashrate(3600)), allocator);
-         array.PushBack(normalize(worker.hashrate(3600 * 12)), allocator);
-         array.PushBack(normalize(worker.hashrate(3600 * 24)), allocator);
+         array.PushBack(Value(worker.name.c_str(), allocator), allocator);
+         array.PushBack(Value(worker.ip.c_str(), allocator), allocator);
+         array.PushBack(worker.connections, allocator);
+         array.PushBack(worker.accepted, allocator);
+         array.PushBack(worker.rejected, allocator);
+         array.PushBack(worker.invalid, allocator);
+         array.PushBack(worker.hashes, allocator);
+         array.PushBack(worker.lastHash, allocator);
+
+         for (double hashrate : worker.hashrate) {
+             array.PushBack(normalize(hashrate), allocator);
+         }
 
          workers.PushBack(array, allocator);
     }
 
-    reply.AddMember("mode", StringRef(Workers::modeName(static_cast<Controller *>(m_base)->config()->workersMode())), allocator);
+    reply.AddMember("mode", StringRef(snapshot.workersMode), allocator);
     reply.AddMember("workers", workers, allocator);
 }
@@ -26,18 +26,26 @@
 #define XMRIG_APIROUTER_H
 
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+
 #include "3rdparty/rapidjson/fwd.h"
 #include "base/api/interfaces/IApiListener.h"
 #include "base/tools/Object.h"
-#include "proxy/StatsData.h"
 
 
 namespace xmrig {
 
 
+class ApiSnapshot;
 class Base;
 
 
+/**
+ * Read-only v1 endpoints, served on the HTTP thread from the snapshot published by tick() on the main loop.
+ */
 class ApiRouter : public xmrig::IApiListener
 {
 public:
@@ -46,19 +54,36 @@ public:
     ApiRouter(Base *base);
     ~ApiRouter() override;
 
+    void tick();
+
 protected:
     void onRequest(IApiRequest &request) override;
 
 private:
-    void getHashrate(rapidjson::Value &reply, rapidjson::Document &doc) const;
-    void getIdentify(rapidjson::Value &reply, rapidjson::Document &doc) const;
-    void getMiner(rapidjson::Value &reply, rapidjson::Document &doc) const;
-    void getMiners(rapidjson::Value &reply, rapidjson::Document &doc) const;
-    void getMinersSummary(rapidjson::Value &reply, rapidjson::Document &doc) const;
-    void getResults(rapidjson::Value &reply, rapidjson::Document &doc) const;
-    void getWorkers(rapidjson::Value &reply, rapidjson::Document &doc) const;
+    enum Demand {
+        DemandResults,
+        DemandWorkers,
+        DemandMiners,
+        DemandMax
+    };
+
+    bool isWanted(Demand demand, uint64_t now) const;
+    std::shared_ptr<const ApiSnapshot> snapshot() const;
+    void want(Demand demand);
+
+    static void getHashrate(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getMiner(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getMiners(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getMinersSummary(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getPropagation(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getResults(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getTls(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
+    static void getWorkers(rapidjson::Value &reply, rapidjson::Document &doc, const ApiSnapshot &snapshot);
 
     Base *m_base;
+    mutable std::mutex m_mutex;
+    std::atomic<uint64_t> m_demand[DemandMax];
+    std::shared_ptr<const ApiSnapshot> m_snapshot;
 };
 
 
@@ -0,0 +1,104 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_APISNAPSHOT_H
+#define XMRIG_APISNAPSHOT_H
+
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+#include "3rdparty/rapidjson/document.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "proxy/Histogram.h"
+#include "proxy/Metrics.h"
+#include "proxy/StatsData.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Immutable copy of the proxy state, built on the main loop once per tick and read by the HTTP thread.
+ *
+ * Miner and worker tables are optional, the router fills them only while somebody is asking for them.
+ */
+class ApiSnapshot
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(ApiSnapshot)
+
+    struct Miner
+    {
+        int64_t id;
+        int state;
+        std::string ip;
+        String agent;
+        String password;
+        String rigId;
+        String user;
+        uint64_t diff;
+        uint64_t rx;
+        uint64_t tx;
+    };
+
+    struct Worker
+    {
+        double hashrate[5];
+        std::string ip;
+        std::string name;
+        uint64_t accepted;
+        uint64_t connections;
+        uint64_t hashes;
+        uint64_t invalid;
+        uint64_t lastHash;
+        uint64_t rejected;
+    };
+
+    ApiSnapshot() = default;
+
+    const char *mode        = nullptr;
+    const char *workersMode = nullptr;
+    Histogram fanout{};
+    Histogram propagation{};
+    rapidjson::Document doc;
+    rapidjson::Value dns;
+    rapidjson::Value tls;
+    StatsData stats;
+    std::map<std::string, Metrics::Pool> pools;
+    std::shared_ptr<const std::vector<Miner>> minersTable;
+    std::shared_ptr<const std::vector<Worker>> workersTable;
+    std::vector<Histogram> phases;
+    uint32_t avgLatency     = 0;
+    uint32_t avgTime        = 0;
+    uint32_t donateLevel    = 0;
+    uint32_t metricsWorkers = 0;
+    uint64_t miners         = 0;
+    uint64_t slowJobs       = 0;
+    uint64_t workersCount   = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_APISNAPSHOT_H */
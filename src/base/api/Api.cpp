@@ -24,11 +24,13 @@
 #include "base/api/interfaces/IApiListener.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
+#include "base/io/Async.h"
 #include "base/io/Env.h"
 #include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Base.h"
+#include "base/net/http/HttpData.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -83,10 +85,185 @@ static rapidjson::Value getResources(rapidjson::Document &doc)
 }
 
 
+static inline bool isSummary(const HttpData &req)
+{
+    return static_cast<IApiRequest::Method>(req.method) == IApiRequest::METHOD_GET && (req.url == "/1/summary" || req.url == "/2/summary" || req.url == "/api.json");
+}
+
+
+/**
+ * If-None-Match is a comma separated list of entity-tags, compared weakly (W/ prefix ignored).
+ */
+static bool isNotModified(const std::string &header, const std::string &etag)
+{
+    size_t pos = 0;
+
+    while (pos < header.size()) {
+        size_t end = header.find(',', pos);
+        if (end == std::string::npos) {
+            end = header.size();
+        }
+
+        size_t first = header.find_first_not_of(" \t", pos);
+        size_t last  = header.find_last_not_of(" \t", end - 1);
+
+        if (first != std::string::npos && first < end && last >= first) {
+            if (header.compare(first, 2, "W/") == 0) {
+                first += 2;
+            }
+
+            const size_t size = last - first + 1;
+            if ((size == 1 && header[first] == '*') || header.compare(first, size, etag) == 0) {
+                return true;
+            }
+        }
+
+        pos = end + 1;
+    }
+
+    return false;
+}
+
+
+/**
+ * Summary request that is not bound to any HTTP connection, the reply is rendered once and shared by all clients.
+ */
+class SummaryRequest : public ApiRequest
+{
+public:
+    inline SummaryRequest(bool restricted) : ApiRequest(SOURCE_HTTP, restricted), m_doc(rapidjson::kObjectType), m_url("/1/summary")
+    {
+        m_type = REQ_SUMMARY;
+    }
+
+    inline bool hasParseError() const override                  { return false; }
+    inline const rapidjson::Value &json() const override        { return m_body; }
+    inline const String &url() const override                   { return m_url; }
+    inline Method method() const override                       { return METHOD_GET; }
+    inline rapidjson::Document &doc() override                  { return m_doc; }
+    inline rapidjson::Value &reply() override                   { return m_doc; }
+    inline void setRpcError(int, const char *) override         {}
+    inline void setRpcResult(rapidjson::Value &) override       {}
+    inline void setText(std::string &&, const char *) override  {}
+
+private:
+    rapidjson::Document m_doc;
+    rapidjson::Value m_body;
+    String m_url;
+};
+
+
+/**
+ * Request executed on the main loop on behalf of a request that belongs to the HTTP thread.
+ *
+ * The reply document is shared with the original request, which the HTTP thread does not touch in the meantime.
+ * Completion is recorded and replayed on the HTTP thread by finish(), only that thread may write the response.
+ */
+class DeferredRequest : public IApiRequest
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(DeferredRequest)
+
+    inline DeferredRequest(IApiRequest &request) : m_request(request) {}
+
+    inline bool accept() override                               { return m_request.accept(); }
+    inline bool hasParseError() const override                  { return m_request.hasParseError(); }
+    inline bool isDone() const override                         { return m_completion != NONE || m_request.isDone(); }
+    inline bool isNew() const override                          { return m_request.isNew(); }
+    inline bool isRestricted() const override                   { return m_request.isRestricted(); }
+    inline const rapidjson::Value &json() const override        { return m_request.json(); }
+    inline const String &rpcMethod() const override             { return m_request.rpcMethod(); }
+    inline const String &url() const override                   { return m_request.url(); }
+    inline int version() const override                         { return m_request.version(); }
+    inline Method method() const override                       { return m_request.method(); }
+    inline rapidjson::Document &doc() override                  { return m_request.doc(); }
+    inline rapidjson::Value &reply() override                   { return m_request.reply(); }
+    inline RequestType type() const override                    { return m_request.type(); }
+    inline Source source() const override                       { return m_request.source(); }
+
+    inline void done(int status) override                       { complete(DONE, status); }
+    inline void setRpcError(int code, const char *message) override             { m_message = message; complete(RPC_ERROR, code); }
+    inline void setRpcResult(rapidjson::Value &result) override                 { m_result = result; complete(RPC_RESULT, 0); }
+    inline void setText(std::string &&text, const char *contentType) override   { m_text = std::move(text); m_contentType = contentType; }
+
+    void finish()
+    {
+        if (m_contentType) {
+            m_request.setText(std::move(m_text), m_contentType);
+        }
+
+        switch (m_completion) {
+        case RPC_ERROR:
+            return m_request.setRpcError(m_status, m_message.data());
+
+        case RPC_RESULT:
+            return m_request.setRpcResult(m_result);
+
+        default:
+            return m_request.done(m_status);
+        }
+    }
+
+private:
+    enum Completion {
+        NONE,
+        DONE,
+        RPC_ERROR,
+        RPC_RESULT
+    };
+
+    inline void complete(Completion completion, int status) { m_completion = completion; m_status = status; }
+
+    Completion m_completion     = NONE;
+    const char *m_contentType   = nullptr;
+    IApiRequest &m_request;
+    int m_status                = 0;
+    rapidjson::Value m_result;
+    std::string m_text;
+    String m_message;
+};
+
+
+/**
+ * Copy of an HTTP request that can outlive the HTTP thread callback, the response is still written by id.
+ */
+class ApiCall : public HttpData
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ApiCall)
+
+    inline ApiCall(const HttpData &req, bool restricted) : HttpData(req.id())
+    {
+        method = req.method;
+        body   = req.body;
+        url    = req.url;
+
+        m_request.reset(new HttpApiRequest(*this, restricted));
+        m_deferred.reset(new DeferredRequest(*m_request));
+    }
+
+    inline DeferredRequest &deferred()                  { return *m_deferred; }
+    inline IApiRequest &request()                       { return *m_request; }
+
+    inline bool isRequest() const override              { return true; }
+    inline const char *host() const override            { return nullptr; }
+    inline const char *tlsFingerprint() const override  { return nullptr; }
+    inline const char *tlsVersion() const override      { return nullptr; }
+    inline std::string ip() const override              { return {}; }
+    inline uint16_t port() const override               { return 0; }
+    inline void write(std::string &&, bool) override    {}
+
+private:
+    std::unique_ptr<HttpApiRequest> m_request;
+    std::unique_ptr<DeferredRequest> m_deferred;
+};
+
+
 } // namespace xmrig
 
 
 xmrig::Api::Api(Base *base) :
+    m_async(new Async([this]() { onCalls(); })),
     m_base(base),
     m_timestamp(Chrono::currentMSecsSinceEpoch())
 {
@@ -105,14 +282,38 @@ xmrig::Api::~Api()
         m_httpd = nullptr; // Ensure the pointer is set to nullptr after deletion
     }
 #   endif
+
+    delete m_async;
 }
 
 
-void xmrig::Api::request(const HttpData &req)
+void xmrig::Api::request(const HttpData &req, bool restricted)
 {
-    HttpApiRequest request(req, m_base->config()->http().isRestricted());
+    if (isSummary(req)) {
+        return summary(req, restricted);
+    }
+
+    auto call = std::make_shared<ApiCall>(req, restricted);
+    if (dispatch(call->request(), m_snapshotListeners)) {
+        return;
+    }
 
-    exec(request);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_calls.emplace_back(std::move(call));
+    }
+
+    m_async->send();
+}
+
+
+void xmrig::Api::resume()
+{
+#   ifdef XMRIG_FEATURE_HTTP
+    if (m_httpd && !m_httpd->isBound()) {
+        m_httpd->start();
+    }
+#   endif
 }
 
 
@@ -136,6 +337,20 @@ void xmrig::Api::start()
 
 void xmrig::Api::stop()
 {
+#   ifdef XMRIG_FEATURE_HTTP
+    if (m_httpd) {
+        m_httpd->stop();
+    }
+#   endif
+
+    // The HTTP thread is gone, nothing can send to the main loop anymore.
+    delete m_async;
+    m_async = nullptr;
+}
+
+
+void xmrig::Api::suspend()
+{
 #   ifdef XMRIG_FEATURE_HTTP
     if (m_httpd) {
         m_httpd->stop();
@@ -146,7 +361,13 @@ void xmrig::Api::stop()
 
 void xmrig::Api::tick()
 {
+    ++m_generation;
+
 #   ifdef XMRIG_FEATURE_HTTP
+    if (m_httpd && m_httpd->isBound()) {
+        m_httpd->post([this]() { onSnapshot(); });
+    }
+
     if (!m_httpd || !m_base->config()->http().isEnabled() || m_httpd->isBound()) {
         return;
     }
@@ -173,6 +394,30 @@ void xmrig::Api::onConfigChanged(Config *config, Config *previousConfig)
 }
 
 
+bool xmrig::Api::dispatch(IApiRequest &request, const std::vector<IApiListener *> &listeners)
+{
+    for (IApiListener *listener : listeners) {
+        if (request.isDone()) {
+            return true;
+        }
+
+        listener->onRequest(request);
+    }
+
+    if (request.isDone()) {
+        return true;
+    }
+
+    if (request.isNew()) {
+        return false;
+    }
+
+    request.done(200);
+
+    return true;
+}
+
+
 void xmrig::Api::exec(IApiRequest &request)
 {
     using namespace rapidjson;
@@ -183,8 +428,14 @@ void xmrig::Api::exec(IApiRequest &request)
         request.accept();
 
         auto &reply = request.reply();
-        reply.AddMember("id",         StringRef(m_id),       allocator);
-        reply.AddMember("worker_id",  m_workerId.toJSON(), allocator);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            reply.AddMember("id",         Value(m_id, allocator), allocator);
+            reply.AddMember("worker_id",  m_workerId.toJSON(request.doc()), allocator);
+        }
+
         reply.AddMember("uptime",     (Chrono::currentMSecsSinceEpoch() - m_timestamp) / 1000, allocator);
         reply.AddMember("restricted", request.isRestricted(), allocator);
         reply.AddMember("resources",  getResources(request.doc()), allocator);
@@ -214,20 +465,16 @@ void xmrig::Api::exec(IApiRequest &request)
         reply.AddMember("features", features, allocator);
     }
 
-    for (IApiListener *listener : m_listeners) {
-        listener->onRequest(request);
-
-        if (request.isDone()) {
-            return;
-        }
+    if (!dispatch(request, m_snapshotListeners)) {
+        request.done(404);
     }
-
-    request.done(request.isNew() ? 404 : 200);
 }
 
 
 void xmrig::Api::genId(const String &id)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     memset(m_id, 0, sizeof(m_id));
 
     if (id.size() > 0) {
@@ -266,10 +513,97 @@ void xmrig::Api::genId(const String &id)
 }
 
 
+/**
+ * Executes requests that no snapshot listener could handle, on the main loop.
+ */
+void xmrig::Api::onCalls()
+{
+    std::vector<std::shared_ptr<ApiCall> > calls;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        calls.swap(m_calls);
+    }
+
+    for (auto &call : calls) {
+        dispatch(call->deferred(), m_listeners);
+
+        if (!m_httpd) {
+            continue;
+        }
+
+        // Requests nobody handled wait for the next snapshot, a listener may have asked for data it does not publish yet.
+        m_httpd->post([this, call]() {
+            if (call->deferred().isDone()) {
+                return call->deferred().finish();
+            }
+
+            m_parked.emplace_back(call);
+        });
+    }
+}
+
+
+void xmrig::Api::onSnapshot()
+{
+    std::vector<std::shared_ptr<ApiCall> > parked;
+    parked.swap(m_parked);
+
+    for (auto &call : parked) {
+        if (!dispatch(call->request(), m_snapshotListeners)) {
+            call->request().done(404);
+        }
+    }
+}
+
+
+/**
+ * Summary is rendered at most once per snapshot, no matter how many clients poll it.
+ */
+void xmrig::Api::summary(const HttpData &req, bool restricted)
+{
+    const uint64_t generation = m_generation.load();
+
+    if (m_summary.empty() || m_summaryGeneration != generation || m_summaryRestricted != restricted) {
+        SummaryRequest request(restricted);
+        exec(request);
+
+        m_summary           = HttpApiResponse::serialize(request.doc());
+        m_summaryGeneration = generation;
+        m_summaryRestricted = restricted;
+
+        uint8_t hash[200];
+        char etag[19] = { '"' };
+
+        keccak(reinterpret_cast<const uint8_t *>(m_summary.data()), m_summary.size(), hash);
+        Cvt::toHex(etag + 1, 17, hash, 8);
+        etag[17] = '"';
+
+        m_summaryETag.assign(etag, 18);
+    }
+
+    HttpApiResponse response(req.id());
+    response.setHeader("ETag", m_summaryETag);
+    response.setHeader("Cache-Control", "no-cache");
+
+    auto it = req.headers.find("if-none-match");
+    if (it != req.headers.end() && isNotModified(it->second, m_summaryETag)) {
+        response.setStatus(304 /* NOT_MODIFIED */);
+
+        return response.end();
+    }
+
+    response.end(m_summary);
+}
+
+
 void xmrig::Api::genWorkerId(const String &id)
 {
-    m_workerId = Env::expand(id);
-    if (m_workerId.isEmpty()) {
-        m_workerId = Env::hostname();
+    String workerId = Env::expand(id);
+    if (workerId.isEmpty()) {
+        workerId = Env::hostname();
     }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_workerId = std::move(workerId);
 }
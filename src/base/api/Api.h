@@ -20,6 +20,10 @@
 #define XMRIG_API_H
 
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 
@@ -30,6 +34,8 @@
 namespace xmrig {
 
 
+class ApiCall;
+class Async;
 class Base;
 class Httpd;
 class HttpData;
@@ -38,6 +44,10 @@ class IApiRequest;
 class String;
 
 
+/**
+ * HTTP requests arrive on the HTTP thread. Snapshot listeners are called there first and must only read data
+ * published by the main loop, requests they leave unhandled are executed by the other listeners on the main loop.
+ */
 class Api : public IBaseListener
 {
 public:
@@ -46,30 +56,48 @@ public:
     explicit Api(Base *base);
     ~Api() override;
 
-    inline const char *id() const                   { return m_id; }
-    inline const char *workerId() const             { return m_workerId; }
-    inline void addListener(IApiListener *listener) { m_listeners.push_back(listener); }
+    inline const char *id() const                           { return m_id; }
+    inline const char *workerId() const                     { return m_workerId; }
+    inline void addListener(IApiListener *listener)         { m_listeners.push_back(listener); }
+    inline void addSnapshotListener(IApiListener *listener) { m_snapshotListeners.push_back(listener); }
 
-    void request(const HttpData &req);
+    void request(const HttpData &req, bool restricted);
+    void resume();
     void start();
     void stop();
+    void suspend();
     void tick();
 
 protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
 
 private:
+    static bool dispatch(IApiRequest &request, const std::vector<IApiListener *> &listeners);
+
     void exec(IApiRequest &request);
     void genId(const String &id);
     void genWorkerId(const String &id);
+    void onCalls();
+    void onSnapshot();
+    void summary(const HttpData &req, bool restricted);
 
+    Async *m_async;
     Base *m_base;
     char m_id[32]{};
     const uint64_t m_timestamp;
     Httpd *m_httpd  = nullptr;
+    std::atomic<uint64_t> m_generation{1};
+    std::mutex m_mutex;
+    std::string m_summary;
+    std::string m_summaryETag;
     std::vector<IApiListener *> m_listeners;
+    std::vector<IApiListener *> m_snapshotListeners;
+    std::vector<std::shared_ptr<ApiCall> > m_calls;
+    std::vector<std::shared_ptr<ApiCall> > m_parked;
     String m_workerId;
+    uint64_t m_summaryGeneration = 0;
     uint8_t m_ticks = 0;
+    bool m_summaryRestricted = false;
 };
 
 
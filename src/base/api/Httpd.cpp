@@ -22,7 +22,9 @@
 #include "base/io/log/Log.h"
 #include "base/net/http/HttpApiResponse.h"
 #include "base/net/http/HttpData.h"
+#include "base/net/tools/NetBuffer.h"
 #include "base/net/tools/TcpServer.h"
+#include "base/tools/Handle.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 
@@ -55,12 +57,17 @@ xmrig::Httpd::Httpd(Base *base) :
 }
 
 
-xmrig::Httpd::~Httpd() = default;
+xmrig::Httpd::~Httpd()
+{
+    stop();
+}
 
 
 bool xmrig::Httpd::start()
 {
-    const auto &config = m_base->config()->http();
+    m_config = m_base->config()->http();
+
+    const auto &config = m_config;
 
     if (!config.isEnabled()) {
         return true;
@@ -68,6 +75,13 @@ bool xmrig::Httpd::start()
 
     bool tls = false;
 
+    m_loop  = new uv_loop_t;
+    m_async = new uv_async_t;
+    m_async->data = this;
+
+    uv_loop_init(m_loop);
+    uv_async_init(m_loop, m_async, onAsync);
+
 #   ifdef XMRIG_FEATURE_TLS
     m_http = new HttpsServer(m_httpListener);
     tls = m_http->setTls(m_base->config()->tls());
@@ -75,7 +89,7 @@ bool xmrig::Httpd::start()
     m_http = new HttpServer(m_httpListener);
 #   endif
 
-    m_server = new TcpServer(config.host(), config.port(), m_http);
+    m_server = new TcpServer(config.host(), config.port(), m_http, m_loop);
 
     const int rc = m_server->bind();
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CSI "1;%dm%s:%d" " " RED_BOLD("%s"),
@@ -92,7 +106,8 @@ bool xmrig::Httpd::start()
         return false;
     }
 
-    m_port = static_cast<uint16_t>(rc);
+    m_port   = static_cast<uint16_t>(rc);
+    m_thread = std::thread(&Httpd::run, this);
 
 #   ifdef _WIN32
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast, performance-no-int-to-ptr)
@@ -110,18 +125,77 @@ bool xmrig::Httpd::start()
 }
 
 
+void xmrig::Httpd::post(Task &&task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_thread.joinable() || m_stop) {
+            return;
+        }
+
+        m_tasks.emplace_back(std::move(task));
+    }
+
+    uv_async_send(m_async);
+}
+
+
 void xmrig::Httpd::stop()
 {
-    delete m_server;
-    delete m_http;
+    if (!m_loop) {
+        return;
+    }
 
-    m_server = nullptr;
-    m_http   = nullptr;
-    m_port   = 0;
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        uv_async_send(m_async);
+        m_thread.join();
+    }
+    else {
+        close();
+        uv_run(m_loop, UV_RUN_DEFAULT);
+    }
+
+    uv_loop_close(m_loop);
+    delete m_loop;
+
+    m_loop  = nullptr;
+    m_async = nullptr;
+    m_port  = 0;
+    m_stop  = false;
+    m_tasks.clear();
 }
 
 
 
+void xmrig::Httpd::onAsync(uv_async_t *handle)
+{
+    auto httpd = static_cast<Httpd *>(handle->data);
+
+    std::vector<Task> tasks;
+    bool stop = false;
+
+    {
+        std::lock_guard<std::mutex> lock(httpd->m_mutex);
+        tasks.swap(httpd->m_tasks);
+        stop = httpd->m_stop;
+    }
+
+    for (auto &task : tasks) {
+        task();
+    }
+
+    if (stop) {
+        httpd->close();
+    }
+}
+
+
 void xmrig::Httpd::onConfigChanged(Config *config, Config *previousConfig)
 {
     if (config->http() == previousConfig->http()) {
@@ -162,7 +236,7 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
     }
 
     if (data.method != HTTP_GET) {
-        if (m_base->config()->http().isRestricted()) {
+        if (m_config.isRestricted()) {
             return HttpApiResponse(data.id(), 403 /* FORBIDDEN */).end();
         }
 
@@ -171,13 +245,13 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
         }
     }
 
-    m_base->api()->request(data);
+    m_base->api()->request(data, m_config.isRestricted());
 }
 
 
 int xmrig::Httpd::auth(const HttpData &req) const
 {
-    const Http &config = m_base->config()->http();
+    const Http &config = m_config;
 
     if (!req.headers.count(kAuthorization)) {
         return config.isAuthRequired() ? 401 /* UNAUTHORIZED */ : 200;
@@ -196,3 +270,23 @@ int xmrig::Httpd::auth(const HttpData &req) const
 
     return strncmp(config.token().data(), token.c_str() + 7, config.token().size()) == 0 ? 200 : 403 /* FORBIDDEN */;
 }
+
+
+void xmrig::Httpd::close()
+{
+    delete m_server;
+    delete m_http;
+
+    m_server = nullptr;
+    m_http   = nullptr;
+
+    Handle::close(m_async);
+}
+
+
+void xmrig::Httpd::run()
+{
+    uv_run(m_loop, UV_RUN_DEFAULT);
+
+    NetBuffer::destroy();
+}
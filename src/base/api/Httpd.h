@@ -21,9 +21,20 @@
 
 
 #include "base/kernel/interfaces/IBaseListener.h"
+#include "base/net/http/Http.h"
 #include "base/net/http/HttpListener.h"
 
 
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using uv_async_t    = struct uv_async_s;
+using uv_loop_t     = struct uv_loop_s;
+
+
 namespace xmrig {
 
 
@@ -33,17 +44,24 @@ class HttpsServer;
 class TcpServer;
 
 
+/**
+ * HTTP API server, runs its own event loop on a dedicated thread so API clients never share a loop
+ * with miner connections. Requests are handed to Api on that thread.
+ */
 class Httpd : public IBaseListener, public IHttpListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Httpd)
 
+    using Task = std::function<void()>;
+
     explicit Httpd(Base *base);
     ~Httpd() override;
 
     inline bool isBound() const { return m_server != nullptr; }
 
     bool start();
+    void post(Task &&task);
     void stop();
 
 protected:
@@ -51,12 +69,23 @@ protected:
     void onHttpData(const HttpData &data) override;
 
 private:
+    static void onAsync(uv_async_t *handle);
+
     int auth(const HttpData &req) const;
+    void close();
+    void run();
 
+    bool m_stop             = false;
     const Base *m_base;
+    Http m_config;
+    std::mutex m_mutex;
     std::shared_ptr<IHttpListener> m_httpListener;
+    std::thread m_thread;
+    std::vector<Task> m_tasks;
     TcpServer *m_server     = nullptr;
     uint16_t m_port         = 0;
+    uv_async_t *m_async     = nullptr;
+    uv_loop_t *m_loop       = nullptr;
 
 #   ifdef XMRIG_FEATURE_TLS
     HttpsServer *m_http     = nullptr;
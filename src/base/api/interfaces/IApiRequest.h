@@ -24,6 +24,9 @@
 #include "base/tools/Object.h"
 
 
+#include <string>
+
+
 namespace xmrig {
 
 
@@ -84,6 +87,7 @@ public:
     virtual void done(int status)                                       = 0;
     virtual void setRpcError(int code, const char *message = nullptr)   = 0;
     virtual void setRpcResult(rapidjson::Value &result)                 = 0;
+    virtual void setText(std::string &&text, const char *contentType)   = 0;
 };
 
 
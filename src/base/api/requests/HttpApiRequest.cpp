@@ -191,6 +191,12 @@ void xmrig::HttpApiRequest::setRpcResult(rapidjson::Value &result)
 }
 
 
+void xmrig::HttpApiRequest::setText(std::string &&text, const char *contentType)
+{
+    m_res.setText(std::move(text), contentType);
+}
+
+
 void xmrig::HttpApiRequest::rpcDone(const char *key, rapidjson::Value &value)
 {
     ApiRequest::done(0);
@@ -49,6 +49,7 @@ protected:
     void done(int status) override;
     void setRpcError(int code, const char *message = nullptr) override;
     void setRpcResult(rapidjson::Value &result) override;
+    void setText(std::string &&text, const char *contentType) override;
 
 private:
     void rpcDone(const char *key, rapidjson::Value &value);
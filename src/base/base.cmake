@@ -15,6 +15,7 @@ set(HEADERS_BASE
     src/base/io/log/backends/FileLog.h
     src/base/io/log/FileLogWriter.h
     src/base/io/log/Log.h
+    src/base/io/log/LogQueue.h
     src/base/io/log/Tags.h
     src/base/io/Signals.h
     src/base/io/Watcher.h
@@ -54,12 +55,15 @@ set(HEADERS_BASE
     src/base/net/stratum/BaseClient.h
     src/base/net/stratum/Client.h
     src/base/net/stratum/Job.h
+    src/base/net/stratum/MuxClient.h
+    src/base/net/stratum/MuxConnection.h
     src/base/net/stratum/NetworkState.h
     src/base/net/stratum/Pool.h
     src/base/net/stratum/Pools.h
     src/base/net/stratum/ProxyUrl.h
     src/base/net/stratum/Socks5.h
     src/base/net/stratum/strategies/FailoverStrategy.h
+    src/base/net/stratum/strategies/LatencyStrategy.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
     src/base/net/stratum/strategies/StrategyProxy.h
     src/base/net/stratum/SubmitResult.h
@@ -81,6 +85,7 @@ set(HEADERS_BASE
     src/base/tools/cryptonote/umul128.h
     src/base/tools/cryptonote/WalletAddress.h
     src/base/tools/Cvt.h
+    src/base/tools/CvtKernels.h
     src/base/tools/Handle.h
     src/base/tools/Span.h
     src/base/tools/String.h
@@ -103,6 +108,7 @@ set(SOURCES_BASE
     src/base/io/log/backends/FileLog.cpp
     src/base/io/log/FileLogWriter.cpp
     src/base/io/log/Log.cpp
+    src/base/io/log/LogQueue.cpp
     src/base/io/log/Tags.cpp
     src/base/io/Signals.cpp
     src/base/io/Watcher.cpp
@@ -122,12 +128,15 @@ set(SOURCES_BASE
     src/base/net/stratum/BaseClient.cpp
     src/base/net/stratum/Client.cpp
     src/base/net/stratum/Job.cpp
+    src/base/net/stratum/MuxClient.cpp
+    src/base/net/stratum/MuxConnection.cpp
     src/base/net/stratum/NetworkState.cpp
     src/base/net/stratum/Pool.cpp
     src/base/net/stratum/Pools.cpp
     src/base/net/stratum/ProxyUrl.cpp
     src/base/net/stratum/Socks5.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
+    src/base/net/stratum/strategies/LatencyStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
     src/base/net/stratum/Url.cpp
     src/base/net/tools/LineReader.cpp
@@ -145,6 +154,22 @@ set(SOURCES_BASE
    )
 
 
+# SIMD kernels of the hex codec in Cvt, AVX2 is selected at runtime.
+if (XMRIG_64_BIT AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64)$")
+    add_definitions(/DXMRIG_CVT_SSE2 /DXMRIG_CVT_AVX2)
+    list(APPEND SOURCES_BASE src/base/tools/Cvt_sse2.cpp src/base/tools/Cvt_avx2.cpp)
+
+    if (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
+        set_source_files_properties(src/base/tools/Cvt_avx2.cpp PROPERTIES COMPILE_FLAGS /arch:AVX2)
+    else()
+        set_source_files_properties(src/base/tools/Cvt_avx2.cpp PROPERTIES COMPILE_FLAGS -mavx2)
+    endif()
+elseif (XMRIG_ARM AND ARM_TARGET EQUAL 8)
+    add_definitions(/DXMRIG_CVT_NEON)
+    list(APPEND SOURCES_BASE src/base/tools/Cvt_neon.cpp)
+endif()
+
+
 if (WIN32)
     set(SOURCES_OS
         src/base/io/json/Json_win.cpp
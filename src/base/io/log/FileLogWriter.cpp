@@ -19,21 +19,37 @@
 
 #include "base/io/log/FileLogWriter.h"
 #include "base/io/Env.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Handle.h"
 
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 
 
 namespace xmrig {
 
 
-static void fsWriteCallback(uv_fs_t *req)
+struct FileLogWriter::Block
 {
-    delete [] static_cast<char *>(req->data);
+    size_t size = 0;
+    char data[kBlockSize];
+};
 
-    uv_fs_req_cleanup(req);
-    delete req;
-}
+
+struct FileLogWriter::Batch
+{
+    bool active             = false;
+    FileLogWriter *writer   = nullptr;
+    int file                = -1;
+    std::vector<Block *> blocks;
+    std::vector<Block *> tail;
+    std::vector<uv_buf_t> bufs;
+    uv_fs_t req{};
+};
 
 
 } // namespace xmrig
@@ -52,7 +68,25 @@ xmrig::FileLogWriter::FileLogWriter(const char* fileName)
 
 xmrig::FileLogWriter::~FileLogWriter()
 {
-    uv_close(reinterpret_cast<uv_handle_t*>(&m_flushAsync), nullptr);
+    Handle::close(m_flushAsync);
+
+    auto &list = writers();
+    list.erase(std::remove(list.begin(), list.end(), this), list.end());
+
+    // Whatever is still pending is written synchronously. If a batch is in flight the pending blocks go after it,
+    // its callback writes them once the batch is done, so the last lines can't overtake earlier ones.
+    if (m_batch->active) {
+        m_batch->writer = nullptr;
+        m_batch->file   = m_file;
+        m_batch->tail.swap(m_blocks);
+    }
+    else {
+        writeSync(m_file, m_blocks);
+        delete m_batch;
+    }
+
+    release(m_blocks);
+    release(m_free);
 
     uv_mutex_destroy(&m_buffersLock);
 }
@@ -61,8 +95,23 @@ void xmrig::FileLogWriter::init()
 {
     uv_mutex_init(&m_buffersLock);
 
-    uv_async_init(uv_default_loop(), &m_flushAsync, on_flush);
-    m_flushAsync.data = this;
+    m_batch         = new Batch();
+    m_batch->writer = this;
+    m_batch->req.data = m_batch;
+
+    m_flushAsync = new uv_async_t;
+    uv_async_init(uv_default_loop(), m_flushAsync, on_flush);
+    m_flushAsync->data = this;
+
+    writers().emplace_back(this);
+}
+
+
+void xmrig::FileLogWriter::reopenAll()
+{
+    for (auto writer : writers()) {
+        writer->reopen();
+    }
 }
 
 bool xmrig::FileLogWriter::open(const char *fileName)
@@ -72,24 +121,31 @@ bool xmrig::FileLogWriter::open(const char *fileName)
         return false;
     }
 
-    uv_fs_t req{};
-    const auto path = Env::expand(fileName);
-    m_file          = uv_fs_open(uv_default_loop(), &req, path, O_CREAT | O_WRONLY, 0644, nullptr);
+    m_path = Env::expand(fileName).data();
 
-    if (req.result < 0 || !isOpen()) {
-        uv_fs_req_cleanup(&req);
-        m_file = -1;
+    return openFile();
+}
 
-        return false;
+
+void xmrig::FileLogWriter::reopen()
+{
+    if (!isOpen()) {
+        return;
     }
 
-    uv_fs_req_cleanup(&req);
+    uv_mutex_lock(&m_buffersLock);
+    m_reopen = true;
+    uv_async_send(m_flushAsync);
+    uv_mutex_unlock(&m_buffersLock);
+}
 
-    uv_fs_stat(uv_default_loop(), &req, path, nullptr);
-    m_pos = req.statbuf.st_size;
-    uv_fs_req_cleanup(&req);
 
-    return true;
+void xmrig::FileLogWriter::setRotate(uint32_t sizeMiB, uint32_t interval, bool compress)
+{
+    m_size     = sizeMiB * 1024ULL * 1024ULL;
+    m_interval = interval * 1000ULL;
+    m_rotateAt = m_interval ? (Chrono::currentMSecsSinceEpoch() / m_interval + 1) * m_interval : 0;
+    m_compress = compress;
 }
 
 
@@ -99,13 +155,10 @@ bool xmrig::FileLogWriter::write(const char *data, size_t size)
         return false;
     }
 
-    uv_buf_t buf = uv_buf_init(new char[size], size);
-    memcpy(buf.base, data, size);
-
     uv_mutex_lock(&m_buffersLock);
 
-    m_buffers.emplace_back(buf);
-    uv_async_send(&m_flushAsync);
+    append(data, size);
+    uv_async_send(m_flushAsync);
 
     uv_mutex_unlock(&m_buffersLock);
 
@@ -119,34 +172,318 @@ bool xmrig::FileLogWriter::writeLine(const char *data, size_t size)
         return false;
     }
 
-    constexpr size_t N = sizeof(m_endl) - 1;
+    uv_mutex_lock(&m_buffersLock);
+
+    append(data, size);
+    append(m_endl, sizeof(m_endl) - 1);
+    uv_async_send(m_flushAsync);
+
+    uv_mutex_unlock(&m_buffersLock);
+
+    return true;
+}
+
+
+void xmrig::FileLogWriter::append(const char *data, size_t size)
+{
+    while (size > 0) {
+        if (m_blocks.empty() || m_blocks.back()->size == kBlockSize) {
+            if (m_free.empty()) {
+                m_blocks.emplace_back(new Block);
+            }
+            else {
+                m_blocks.emplace_back(m_free.back());
+                m_free.pop_back();
+            }
+        }
+
+        Block *block    = m_blocks.back();
+        const size_t n  = std::min(size, kBlockSize - block->size);
+
+        memcpy(block->data + block->size, data, n);
+        block->size += n;
+        data        += n;
+        size        -= n;
+    }
+}
 
-    uv_buf_t buf = uv_buf_init(new char[size + N], size + N);
-    memcpy(buf.base, data, size);
-    memcpy(buf.base + size, m_endl, N);
 
+void xmrig::FileLogWriter::done()
+{
     uv_mutex_lock(&m_buffersLock);
 
-    m_buffers.emplace_back(buf);
-    uv_async_send(&m_flushAsync);
+    for (auto block : m_batch->blocks) {
+        if (m_free.size() < kMaxFree) {
+            block->size = 0;
+            m_free.emplace_back(block);
+        }
+        else {
+            delete block;
+        }
+    }
+
+    m_batch->blocks.clear();
+    m_batch->active = false;
 
     uv_mutex_unlock(&m_buffersLock);
 
+    flush();
+}
+
+
+bool xmrig::FileLogWriter::isRotateNeeded()
+{
+    if (m_rotateAt && Chrono::currentMSecsSinceEpoch() >= m_rotateAt) {
+        return true;
+    }
+
+    if (!m_size || m_pos < static_cast<int64_t>(m_size)) {
+        return false;
+    }
+
+    // The file may have been truncated by an external tool (logrotate copytruncate), the real size wins.
+    uv_fs_t req{};
+    if (uv_fs_fstat(uv_default_loop(), &req, m_file, nullptr) == 0) {
+        m_pos = static_cast<int64_t>(req.statbuf.st_size);
+    }
+
+    uv_fs_req_cleanup(&req);
+
+    return m_pos >= static_cast<int64_t>(m_size);
+}
+
+
+bool xmrig::FileLogWriter::openFile()
+{
+    uv_fs_t req{};
+    const int file = uv_fs_open(uv_default_loop(), &req, m_path.c_str(), O_CREAT | O_WRONLY | O_APPEND, 0644, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    if (file < 0) {
+        return false;
+    }
+
+    m_pos = uv_fs_fstat(uv_default_loop(), &req, file, nullptr) == 0 ? static_cast<int64_t>(req.statbuf.st_size) : 0;
+    uv_fs_req_cleanup(&req);
+
+    if (isOpen()) {
+        uv_fs_close(uv_default_loop(), &req, m_file, nullptr);
+        uv_fs_req_cleanup(&req);
+    }
+
+    m_file = file;
+
     return true;
 }
 
+
 void xmrig::FileLogWriter::flush()
 {
     uv_mutex_lock(&m_buffersLock);
 
-    for (uv_buf_t buf : m_buffers) {
-        uv_fs_t* req = new uv_fs_t;
-        req->data = buf.base;
+    if (m_batch->active) {
+        uv_mutex_unlock(&m_buffersLock);
+
+        return;
+    }
+
+    const bool reopen = m_reopen;
+    m_reopen          = false;
+
+    uv_mutex_unlock(&m_buffersLock);
+
+    // No batch is in flight here, the descriptor can be replaced safely.
+    if (reopen) {
+        openFile();
+    }
+    else if (isOpen() && (m_rotateAt || m_size) && isRotateNeeded()) {
+        rotate();
+    }
+
+    uv_mutex_lock(&m_buffersLock);
+
+    if (m_blocks.empty()) {
+        uv_mutex_unlock(&m_buffersLock);
+
+        return;
+    }
+
+    const size_t count = std::min(m_blocks.size(), kMaxBatch);
+    size_t size        = 0;
+
+    m_batch->active = true;
+    m_batch->blocks.assign(m_blocks.begin(), m_blocks.begin() + static_cast<ptrdiff_t>(count));
+    m_batch->bufs.clear();
+    m_blocks.erase(m_blocks.begin(), m_blocks.begin() + static_cast<ptrdiff_t>(count));
 
-        uv_fs_write(uv_default_loop(), req, m_file, &buf, 1, m_pos, fsWriteCallback);
-        m_pos += buf.len;
+    for (auto block : m_batch->blocks) {
+        m_batch->bufs.emplace_back(uv_buf_init(block->data, static_cast<unsigned int>(block->size)));
+        size += block->size;
     }
-    m_buffers.clear();
+
+    m_pos += static_cast<int64_t>(size);
 
     uv_mutex_unlock(&m_buffersLock);
+
+    uv_fs_write(uv_default_loop(), &m_batch->req, m_file, m_batch->bufs.data(), static_cast<unsigned int>(m_batch->bufs.size()), -1, onWrite);
+}
+
+
+void xmrig::FileLogWriter::rotate()
+{
+    if (m_interval) {
+        m_rotateAt = (Chrono::currentMSecsSinceEpoch() / m_interval + 1) * m_interval;
+    }
+
+    if (m_pos == 0) {
+        return;
+    }
+
+    time_t now = time(nullptr);
+    tm stime{};
+
+#   ifdef XMRIG_OS_WIN
+    localtime_s(&stime, &now);
+#   else
+    localtime_r(&now, &stime);
+#   endif
+
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), ".%d%02d%02d-%02d%02d%02d", stime.tm_year + 1900, stime.tm_mon + 1, stime.tm_mday, stime.tm_hour, stime.tm_min, stime.tm_sec);
+
+    const std::string base = m_path + suffix;
+    std::string target     = base;
+    uv_fs_t req{};
+
+    for (int i = 1; uv_fs_stat(uv_default_loop(), &req, target.c_str(), nullptr) == 0; ++i) {
+        uv_fs_req_cleanup(&req);
+        target = base + "." + std::to_string(i);
+    }
+
+    uv_fs_req_cleanup(&req);
+
+    // Writers keep the old descriptor until the new file is open, no line is lost between rename and open.
+    const int rc = uv_fs_rename(uv_default_loop(), &req, m_path.c_str(), target.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+
+    if (rc != 0 || !openFile()) {
+        return;
+    }
+
+    if (m_compress) {
+        compress(target);
+    }
+}
+
+
+std::vector<xmrig::FileLogWriter *> &xmrig::FileLogWriter::writers()
+{
+    static std::vector<FileLogWriter *> list;
+
+    return list;
+}
+
+
+void xmrig::FileLogWriter::compress(const std::string &path)
+{
+    char *args[] = { const_cast<char *>("gzip"), const_cast<char *>("-f"), const_cast<char *>(path.c_str()), nullptr };
+
+    uv_stdio_container_t stdio[3]{};
+    for (auto &container : stdio) {
+        container.flags = UV_IGNORE;
+    }
+
+    uv_process_options_t options{};
+    options.file        = args[0];
+    options.args        = args;
+    options.stdio       = stdio;
+    options.stdio_count = 3;
+    options.flags       = UV_PROCESS_DETACHED;
+    options.exit_cb     = [](uv_process_t *process, int64_t, int) { Handle::close(process); };
+
+    auto process = new uv_process_t;
+    if (uv_spawn(uv_default_loop(), process, &options) != 0) {
+        Handle::close(process);
+
+        return;
+    }
+
+    uv_unref(reinterpret_cast<uv_handle_t *>(process));
+}
+
+
+void xmrig::FileLogWriter::writeSync(int file, const std::vector<Block *> &blocks)
+{
+    if (file < 0 || blocks.empty()) {
+        return;
+    }
+
+    std::vector<uv_buf_t> bufs;
+    bufs.reserve(blocks.size());
+
+    for (auto block : blocks) {
+        bufs.emplace_back(uv_buf_init(block->data, static_cast<unsigned int>(block->size)));
+    }
+
+    uv_fs_t req{};
+    uv_fs_write(uv_default_loop(), &req, file, bufs.data(), static_cast<unsigned int>(bufs.size()), -1, nullptr);
+    uv_fs_req_cleanup(&req);
+}
+
+
+void xmrig::FileLogWriter::release(std::vector<Block *> &blocks)
+{
+    for (auto block : blocks) {
+        delete block;
+    }
+
+    blocks.clear();
+}
+
+
+void xmrig::FileLogWriter::finish(Batch *batch)
+{
+    writeSync(batch->file, batch->tail);
+
+    release(batch->blocks);
+    release(batch->tail);
+    delete batch;
+}
+
+
+void xmrig::FileLogWriter::onFsync(uv_fs_t *req)
+{
+    auto batch = static_cast<Batch *>(req->data);
+    uv_fs_req_cleanup(req);
+
+    if (!batch->writer) {
+        return finish(batch);
+    }
+
+    batch->writer->done();
+}
+
+
+void xmrig::FileLogWriter::onWrite(uv_fs_t *req)
+{
+    auto batch = static_cast<Batch *>(req->data);
+    uv_fs_req_cleanup(req);
+
+    FileLogWriter *writer = batch->writer;
+    if (!writer) {
+        return finish(batch);
+    }
+
+    if (writer->m_fsync) {
+        const uint64_t now = Chrono::steadyMSecs();
+
+        if (now >= writer->m_fsyncAt) {
+            writer->m_fsyncAt = now + writer->m_fsync;
+
+            uv_fs_fsync(uv_default_loop(), req, writer->m_file, onFsync);
+            return;
+        }
+    }
+
+    writer->done();
 }
@@ -22,6 +22,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 #include <uv.h>
 
@@ -29,39 +30,83 @@
 namespace xmrig {
 
 
+/**
+ * Appends lines to a file without blocking the caller.
+ *
+ * Data is copied to reusable fixed-size blocks, pending blocks are written by one uv_fs_write request
+ * with up to kMaxBatch buffers, the next batch starts when the previous one completes.
+ *
+ * The file is opened in append mode, so external truncation is safe. Built-in rotation renames the file
+ * to "<name>.<YYYYMMDD-HHMMSS>" between batches, reopenAll() (SIGUSR1) reopens every writer after an
+ * external rename.
+ */
 class FileLogWriter
 {
 public:
+    constexpr static size_t kBlockSize  = 64 * 1024;
+    constexpr static size_t kMaxBatch   = 64;
+    constexpr static size_t kMaxFree    = 16;
+
     FileLogWriter();
     FileLogWriter(const char* fileName);
 
     ~FileLogWriter();
 
-    inline bool isOpen() const  { return m_file >= 0; }
-    inline int64_t pos() const  { return m_pos; }
+    inline bool isOpen() const                  { return m_file >= 0; }
+    inline int64_t pos() const                  { return m_pos; }
+    inline void setFsync(uint32_t seconds)      { m_fsync = seconds * 1000ULL; }
+
+    static void reopenAll();
 
     bool open(const char *fileName);
+    void reopen();
+    void setRotate(uint32_t sizeMiB, uint32_t interval, bool compress);
     bool write(const char *data, size_t size);
     bool writeLine(const char *data, size_t size);
 
 private:
+    struct Block;
+    struct Batch;
+
 #   ifdef XMRIG_OS_WIN
     const char m_endl[3]  = {'\r', '\n', 0};
 #   else
     const char m_endl[2]  = {'\n', 0};
 #   endif
 
-    int m_file      = -1;
-    int64_t m_pos   = 0;
+    bool m_compress     = false;
+    bool m_reopen       = false;
+    int m_file          = -1;
+    int64_t m_pos       = 0;
+    std::string m_path;
+    uint64_t m_fsync    = 0;
+    uint64_t m_fsyncAt  = 0;
+    uint64_t m_interval = 0;
+    uint64_t m_rotateAt = 0;
+    uint64_t m_size     = 0;
 
     uv_mutex_t m_buffersLock;
-    std::vector<uv_buf_t> m_buffers;
+    std::vector<Block *> m_blocks;
+    std::vector<Block *> m_free;
+    Batch *m_batch      = nullptr;
 
-    uv_async_t m_flushAsync;
+    uv_async_t *m_flushAsync = nullptr;
 
+    bool isRotateNeeded();
+    bool openFile();
     void init();
+    void append(const char *data, size_t size);
+    void done();
+    void rotate();
 
     static void on_flush(uv_async_t* async) { reinterpret_cast<FileLogWriter*>(async->data)->flush(); }
+    static std::vector<FileLogWriter *> &writers();
+    static void compress(const std::string &path);
+    static void finish(Batch *batch);
+    static void onFsync(uv_fs_t *req);
+    static void release(std::vector<Block *> &blocks);
+    static void onWrite(uv_fs_t *req);
+    static void writeSync(int file, const std::vector<Block *> &blocks);
     void flush();
 };
 
@@ -24,16 +24,20 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstring>
 #include <ctime>
+#include <memory>
 #include <mutex>
-#include <string>
+#include <thread>
 #include <uv.h>
 #include <vector>
 
 
 #include "base/io/log/Log.h"
+#include "base/io/log/LogQueue.h"
 #include "base/kernel/interfaces/ILogBackend.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Object.h"
@@ -70,17 +74,35 @@ public:
 
     inline ~LogPrivate()
     {
+        stop();
+
         for (auto backend : m_backends) {
             delete backend;
         }
     }
 
 
-    inline void add(ILogBackend *backend) { m_backends.push_back(backend); }
+    inline void add(ILogBackend *backend)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_backends.push_back(backend);
+
+        // Log thread is started with the first backend, after the process is forked to background.
+        if (!m_thread) {
+            m_queue.reset(new LogQueue());
+            m_thread.reset(new std::thread(&LogPrivate::run, this));
+            m_async.store(true, std::memory_order_release);
+        }
+    }
 
 
     void print(Log::Level level, const char *fmt, va_list args)
     {
+        if (m_async.load(std::memory_order_acquire)) {
+            return enqueue(level, fmt, args);
+        }
+
         size_t size   = 0;
         size_t offset = 0;
 
@@ -90,7 +112,7 @@ public:
             return;
         }
 
-        const uint64_t ts = timestamp(level, size, offset);
+        timestamp(level, Chrono::currentMSecsSinceEpoch(), size, offset);
         color(level, size);
 
         const int rc = vsnprintf(m_buf + size, sizeof (m_buf) - offset - 32, fmt, args);
@@ -101,58 +123,157 @@ public:
         size += std::min(static_cast<size_t>(rc), sizeof (m_buf) - offset - 32);
         endl(size);
 
-        std::string txt(m_buf);
-        size_t i = 0;
-        while ((i = txt.find(CSI)) != std::string::npos) {
-            txt.erase(i, txt.find('m', i) - i + 1);
-        }
+        strip(size);
 
-        if (!m_backends.empty()) {
-            for (auto backend : m_backends) {
-                backend->print(ts, level, m_buf, offset, size, true);
-                backend->print(ts, level, txt.c_str(), offset ? (offset - 11) : 0, txt.size(), false);
-            }
+        fputs(m_txt, stdout);
+        fflush(stdout);
+    }
+
+
+    void stop()
+    {
+        if (!m_thread) {
+            return;
         }
-        else {
-            fputs(txt.c_str(), stdout);
-            fflush(stdout);
+
+        {
+            std::lock_guard<std::mutex> lock(m_waitMutex);
+            m_stop = true;
         }
+
+        m_cv.notify_one();
+        m_thread->join();
+        m_thread.reset();
+
+        m_async.store(false, std::memory_order_release);
     }
 
 
 private:
-    inline uint64_t timestamp(Log::Level level, size_t &size, size_t &offset)
+    void enqueue(Log::Level level, const char *fmt, va_list args)
     {
-        const uint64_t ms = Chrono::currentMSecsSinceEpoch();
+        const uint64_t ts = Chrono::currentMSecsSinceEpoch();
 
-        if (level == Log::NONE) {
-            return ms;
+        // Queue is full only if the log thread can't keep up, messages are never dropped.
+        while (!m_queue->push(ts, level, fmt, args)) {
+            wake();
+            std::this_thread::yield();
         }
 
-        time_t now = ms / 1000;
-        tm stime{};
+        wake();
+    }
 
-#       ifdef _WIN32
-        localtime_s(&stime, &now);
-#       else
-        localtime_r(&now, &stime);
-#       endif
 
-        const int rc = snprintf(m_buf, sizeof(m_buf) - 1, "[%d-%02d-%02d %02d:%02d:%02d" BLACK_BOLD(".%03d") "] ",
-                                stime.tm_year + 1900,
-                                stime.tm_mon + 1,
-                                stime.tm_mday,
-                                stime.tm_hour,
-                                stime.tm_min,
-                                stime.tm_sec,
-                                static_cast<int>(ms % 1000)
-                                );
+    inline void wake()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (m_waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(m_waitMutex);
+            m_cv.notify_one();
+        }
+    }
+
+
+    void run()
+    {
+        uint64_t ts = 0;
+        int level   = 0;
+        size_t size = 0;
+
+        while (true) {
+            while (m_queue->pop(m_msg, sizeof(m_msg), ts, level, size)) {
+                write(ts, static_cast<Log::Level>(level), size);
+            }
+
+            std::unique_lock<std::mutex> lock(m_waitMutex);
+            if (m_stop && m_queue->isEmpty()) {
+                break;
+            }
+
+            m_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!m_stop && m_queue->isEmpty()) {
+                m_cv.wait_for(lock, std::chrono::seconds(1));
+            }
+
+            m_waiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+
+    void write(uint64_t ts, Log::Level level, size_t msgSize)
+    {
+        size_t size   = 0;
+        size_t offset = 0;
+
+        timestamp(level, ts, size, offset);
+        color(level, size);
+
+        msgSize = std::min(msgSize, sizeof (m_buf) - offset - 32);
+        memcpy(m_buf + size, m_msg, msgSize);
+        size += msgSize;
+
+        endl(size);
+
+        const size_t txtOffset = strip(size, offset);
 
-        if (rc > 0) {
-            size = offset = static_cast<size_t>(rc);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto backend : m_backends) {
+            backend->print(ts, level, m_buf, offset, size, true);
+            backend->print(ts, level, m_txt, txtOffset, m_txtSize, false);
+        }
+    }
+
+
+    inline void timestamp(Log::Level level, uint64_t ms, size_t &size, size_t &offset)
+    {
+        if (level == Log::NONE) {
+            return;
         }
 
-        return ms;
+        // Date and time part of the prefix changes once per second.
+        const auto sec = static_cast<time_t>(ms / 1000);
+        if (sec != m_tsSec || m_tsSize == 0) {
+            tm stime{};
+
+#           ifdef _WIN32
+            localtime_s(&stime, &sec);
+#           else
+            localtime_r(&sec, &stime);
+#           endif
+
+            const int rc = snprintf(m_ts, sizeof(m_ts), "[%d-%02d-%02d %02d:%02d:%02d",
+                                    stime.tm_year + 1900,
+                                    stime.tm_mon + 1,
+                                    stime.tm_mday,
+                                    stime.tm_hour,
+                                    stime.tm_min,
+                                    stime.tm_sec
+                                    );
+
+            m_tsSec  = sec;
+            m_tsSize = rc > 0 ? static_cast<size_t>(rc) : 0;
+        }
+
+        memcpy(m_buf, m_ts, m_tsSize);
+        size = m_tsSize;
+
+        const auto msec = static_cast<unsigned>(ms % 1000);
+
+        memcpy(m_buf + size, BLACK_BOLD_S ".", sizeof(BLACK_BOLD_S ".") - 1);
+        size += sizeof(BLACK_BOLD_S ".") - 1;
+
+        m_buf[size++] = static_cast<char>('0' + msec / 100);
+        m_buf[size++] = static_cast<char>('0' + msec / 10 % 10);
+        m_buf[size++] = static_cast<char>('0' + msec % 10);
+
+        memcpy(m_buf + size, CLEAR "] ", sizeof(CLEAR "] ") - 1);
+        size += sizeof(CLEAR "] ") - 1;
+
+        offset = size;
     }
 
 
@@ -186,9 +307,51 @@ private:
     }
 
 
+    // Copies the line without escape sequences to m_txt in a single pass, returns the stripped prefix offset.
+    size_t strip(size_t size, size_t offset = 0)
+    {
+        size_t out       = 0;
+        size_t txtOffset = 0;
+
+        for (size_t i = 0; i < size; ++i) {
+            if (i == offset) {
+                txtOffset = out;
+            }
+
+            if (m_buf[i] == '\x1B' && i + 1 < size && m_buf[i + 1] == '[') {
+                while (i < size && m_buf[i] != 'm') {
+                    ++i;
+                }
+
+                continue;
+            }
+
+            m_txt[out++] = m_buf[i];
+        }
+
+        m_txt[out] = '\0';
+        m_txtSize  = out;
+
+        return txtOffset;
+    }
+
+
     char m_buf[Log::kMaxBufferSize]{};
+    char m_msg[Log::kMaxBufferSize]{};
+    char m_ts[32]{};
+    char m_txt[Log::kMaxBufferSize]{};
+    size_t m_tsSize             = 0;
+    size_t m_txtSize            = 0;
+    std::atomic<bool> m_async{ false };
+    std::atomic<bool> m_waiting{ false };
+    std::condition_variable m_cv;
     std::mutex m_mutex;
+    std::mutex m_waitMutex;
+    std::unique_ptr<LogQueue> m_queue;
+    std::unique_ptr<std::thread> m_thread;
     std::vector<ILogBackend*> m_backends;
+    bool m_stop                 = false;
+    time_t m_tsSec              = 0;
 };
 
 
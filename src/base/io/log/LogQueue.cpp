@@ -0,0 +1,590 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/io/log/LogQueue.h"
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+struct LogQueue::Record
+{
+    std::atomic<size_t> seq{ 0 };
+    uint64_t ts         = 0;
+    const char *fmt     = nullptr;
+    char *text          = nullptr;  // preformatted message if the arguments did not fit
+    int level           = 0;
+    uint8_t args[kRecordSize - 40]{};
+};
+
+
+namespace {
+
+
+enum class Length : uint8_t { None, HH, H, L, LL, Z, J, T, LongDouble };
+
+
+// Single printf conversion specification, "%-*.*llu" is split into flags+width "-*", precision ".*", length "ll" and conversion 'u'.
+struct Spec
+{
+    const char *flags       = nullptr;
+    size_t flagsSize        = 0;
+    const char *precision   = nullptr;
+    size_t precisionSize    = 0;
+    bool widthStar          = false;
+    bool precisionStar      = false;
+    int precisionValue      = -1;
+    Length length           = Length::None;
+    char conv               = 0;
+};
+
+
+static const char *parseSpec(const char *p, Spec &spec)
+{
+    spec.flags = p;
+
+    while (*p && strchr("-+ #0'", *p)) {
+        ++p;
+    }
+
+    if (*p == '*') {
+        spec.widthStar = true;
+        ++p;
+    }
+    else {
+        while (*p >= '0' && *p <= '9') {
+            ++p;
+        }
+    }
+
+    spec.flagsSize = static_cast<size_t>(p - spec.flags);
+
+    if (*p == '.') {
+        spec.precision = p++;
+
+        if (*p == '*') {
+            spec.precisionStar = true;
+            ++p;
+        }
+        else {
+            spec.precisionValue = 0;
+
+            while (*p >= '0' && *p <= '9') {
+                spec.precisionValue = spec.precisionValue * 10 + (*p++ - '0');
+            }
+        }
+
+        spec.precisionSize = static_cast<size_t>(p - spec.precision);
+    }
+
+    switch (*p) {
+    case 'h':
+        spec.length = p[1] == 'h' ? Length::HH : Length::H;
+        p += spec.length == Length::HH ? 2 : 1;
+        break;
+
+    case 'l':
+        spec.length = p[1] == 'l' ? Length::LL : Length::L;
+        p += spec.length == Length::LL ? 2 : 1;
+        break;
+
+    case 'q':
+        spec.length = Length::LL;
+        ++p;
+        break;
+
+    case 'z':
+        spec.length = Length::Z;
+        ++p;
+        break;
+
+    case 'j':
+        spec.length = Length::J;
+        ++p;
+        break;
+
+    case 't':
+        spec.length = Length::T;
+        ++p;
+        break;
+
+    case 'L':
+        spec.length = Length::LongDouble;
+        ++p;
+        break;
+
+    default:
+        break;
+    }
+
+    spec.conv = *p;
+
+    return *p ? p + 1 : p;
+}
+
+
+class Writer
+{
+public:
+    inline Writer(uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+    inline bool isValid() const { return m_valid; }
+
+    template<typename T>
+    inline void put(T value)
+    {
+        write(&value, sizeof(T));
+    }
+
+    inline void write(const void *data, size_t size)
+    {
+        if (!m_valid || m_pos + size > m_size) {
+            m_valid = false;
+            return;
+        }
+
+        memcpy(m_data + m_pos, data, size);
+        m_pos += size;
+    }
+
+    inline void setInvalid() { m_valid = false; }
+
+private:
+    bool m_valid    = true;
+    size_t m_pos    = 0;
+    uint8_t *m_data;
+    const size_t m_size;
+};
+
+
+class Reader
+{
+public:
+    inline Reader(const uint8_t *data) : m_data(data) {}
+
+    template<typename T>
+    inline T get()
+    {
+        T value;
+        memcpy(&value, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+
+        return value;
+    }
+
+    inline const char *data(size_t size)
+    {
+        const char *out = reinterpret_cast<const char *>(m_data + m_pos);
+        m_pos += size;
+
+        return out;
+    }
+
+private:
+    const uint8_t *m_data;
+    size_t m_pos = 0;
+};
+
+
+static bool encode(Writer &writer, const char *fmt, va_list args)
+{
+    const char *p = fmt;
+
+    while ((p = strchr(p, '%')) != nullptr) {
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+
+        Spec spec;
+        p = parseSpec(p + 1, spec);
+
+        if (spec.widthStar) {
+            writer.put(va_arg(args, int));
+        }
+
+        if (spec.precisionStar) {
+            spec.precisionValue = va_arg(args, int);
+            writer.put(spec.precisionValue);
+        }
+
+        switch (spec.conv) {
+        case 'd':
+        case 'i':
+            switch (spec.length) {
+            case Length::HH: writer.put(static_cast<long long>(static_cast<signed char>(va_arg(args, int)))); break;
+            case Length::H:  writer.put(static_cast<long long>(static_cast<short>(va_arg(args, int)))); break;
+            case Length::L:  writer.put(static_cast<long long>(va_arg(args, long))); break;
+            case Length::LL: writer.put(va_arg(args, long long)); break;
+            case Length::Z:  writer.put(static_cast<long long>(va_arg(args, ptrdiff_t))); break;
+            case Length::J:  writer.put(static_cast<long long>(va_arg(args, intmax_t))); break;
+            case Length::T:  writer.put(static_cast<long long>(va_arg(args, ptrdiff_t))); break;
+            default:         writer.put(static_cast<long long>(va_arg(args, int))); break;
+            }
+            break;
+
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            switch (spec.length) {
+            case Length::HH: writer.put(static_cast<unsigned long long>(static_cast<unsigned char>(va_arg(args, unsigned int)))); break;
+            case Length::H:  writer.put(static_cast<unsigned long long>(static_cast<unsigned short>(va_arg(args, unsigned int)))); break;
+            case Length::L:  writer.put(static_cast<unsigned long long>(va_arg(args, unsigned long))); break;
+            case Length::LL: writer.put(va_arg(args, unsigned long long)); break;
+            case Length::Z:  writer.put(static_cast<unsigned long long>(va_arg(args, size_t))); break;
+            case Length::J:  writer.put(static_cast<unsigned long long>(va_arg(args, uintmax_t))); break;
+            case Length::T:  writer.put(static_cast<unsigned long long>(va_arg(args, ptrdiff_t))); break;
+            default:         writer.put(static_cast<unsigned long long>(va_arg(args, unsigned int))); break;
+            }
+            break;
+
+        case 'c':
+            writer.put(va_arg(args, int));
+            break;
+
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (spec.length == Length::LongDouble) {
+                writer.put(va_arg(args, long double));
+            }
+            else {
+                writer.put(va_arg(args, double));
+            }
+            break;
+
+        case 's':
+            {
+                const char *str = va_arg(args, const char *);
+                if (!str) {
+                    str = "(null)";
+                }
+
+                const size_t size = spec.precisionValue >= 0 ? strnlen(str, static_cast<size_t>(spec.precisionValue)) : strlen(str);
+
+                writer.put(static_cast<uint32_t>(size));
+                writer.write(str, size);
+            }
+            break;
+
+        case 'p':
+            writer.put(va_arg(args, void *));
+            break;
+
+        default:
+            writer.setInvalid();
+            break;
+        }
+
+        if (!writer.isValid()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+template<typename T>
+static inline int format(char *out, size_t size, const char *spec, const int *stars, size_t count, T value)
+{
+    switch (count) {
+    case 0:
+        return snprintf(out, size, spec, value);
+
+    case 1:
+        return snprintf(out, size, spec, stars[0], value);
+
+    default:
+        return snprintf(out, size, spec, stars[0], stars[1], value);
+    }
+}
+
+
+static size_t decode(char *out, size_t size, const char *fmt, Reader &reader)
+{
+    size_t pos      = 0;
+    const char *p   = fmt;
+
+    auto append = [&](const char *data, size_t n) {
+        n = std::min(n, size - 1 - pos);
+        memcpy(out + pos, data, n);
+        pos += n;
+    };
+
+    while (*p && pos < size - 1) {
+        const char *next = strchr(p, '%');
+        if (!next) {
+            append(p, strlen(p));
+            break;
+        }
+
+        append(p, static_cast<size_t>(next - p));
+
+        if (next[1] == '%') {
+            append("%", 1);
+            p = next + 2;
+            continue;
+        }
+
+        Spec spec;
+        p = parseSpec(next + 1, spec);
+
+        int stars[2]{};
+        size_t count = 0;
+
+        if (spec.widthStar) {
+            stars[count++] = reader.get<int>();
+        }
+
+        if (spec.precisionStar) {
+            stars[count++] = reader.get<int>();
+        }
+
+        // Conversion specification is rebuilt with the normalized argument type.
+        char buf[64] = { '%' };
+        size_t n = 1;
+
+        const auto add = [&](const char *data, size_t s) {
+            s = std::min(s, sizeof(buf) - n - 4);
+            memcpy(buf + n, data, s);
+            n += s;
+        };
+
+        add(spec.flags, spec.flagsSize);
+
+        if (spec.conv == 's') {
+            count = spec.widthStar ? 1 : 0;
+            add(".*s", 3);
+        }
+        else {
+            add(spec.precision, spec.precisionSize);
+
+            switch (spec.conv) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+                add("ll", 2);
+                break;
+
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                if (spec.length == Length::LongDouble) {
+                    add("L", 1);
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            buf[n++] = spec.conv;
+        }
+
+        buf[n] = '\0';
+
+        char *dst         = out + pos;
+        const size_t left = size - pos;
+        int rc            = 0;
+
+        switch (spec.conv) {
+        case 'd':
+        case 'i':
+            rc = format(dst, left, buf, stars, count, reader.get<long long>());
+            break;
+
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            rc = format(dst, left, buf, stars, count, reader.get<unsigned long long>());
+            break;
+
+        case 'c':
+            rc = format(dst, left, buf, stars, count, reader.get<int>());
+            break;
+
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (spec.length == Length::LongDouble) {
+                rc = format(dst, left, buf, stars, count, reader.get<long double>());
+            }
+            else {
+                rc = format(dst, left, buf, stars, count, reader.get<double>());
+            }
+            break;
+
+        case 's':
+            {
+                const auto s    = reader.get<uint32_t>();
+                stars[count++]  = static_cast<int>(s);
+                rc              = format(dst, left, buf, stars, count, reader.data(s));
+            }
+            break;
+
+        case 'p':
+            rc = format(dst, left, buf, stars, count, reader.get<void *>());
+            break;
+
+        default:
+            break;
+        }
+
+        if (rc > 0) {
+            pos += std::min(static_cast<size_t>(rc), left - 1);
+        }
+    }
+
+    out[pos] = '\0';
+
+    return pos;
+}
+
+
+} // namespace
+
+
+} // namespace xmrig
+
+
+xmrig::LogQueue::LogQueue() :
+    m_enqueue(0),
+    m_records(new Record[kCapacity])
+{
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of 2");
+    static_assert(sizeof(Record) <= kRecordSize, "Record size mismatch");
+
+    for (size_t i = 0; i < kCapacity; ++i) {
+        m_records[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+xmrig::LogQueue::~LogQueue()
+{
+    for (size_t i = 0; i < kCapacity; ++i) {
+        delete [] m_records[i].text;
+    }
+
+    delete [] m_records;
+}
+
+
+bool xmrig::LogQueue::isEmpty() const
+{
+    return m_records[m_dequeue & (kCapacity - 1)].seq.load(std::memory_order_acquire) != m_dequeue + 1;
+}
+
+
+bool xmrig::LogQueue::pop(char *buf, size_t size, uint64_t &ts, int &level, size_t &written)
+{
+    Record &record = m_records[m_dequeue & (kCapacity - 1)];
+    if (record.seq.load(std::memory_order_acquire) != m_dequeue + 1) {
+        return false;
+    }
+
+    ts    = record.ts;
+    level = record.level;
+
+    if (record.text) {
+        written = std::min(strlen(record.text), size - 1);
+        memcpy(buf, record.text, written);
+        buf[written] = '\0';
+
+        delete [] record.text;
+        record.text = nullptr;
+    }
+    else {
+        Reader reader(record.args);
+        written = decode(buf, size, record.fmt, reader);
+    }
+
+    record.seq.store(m_dequeue + kCapacity, std::memory_order_release);
+    ++m_dequeue;
+
+    return true;
+}
+
+
+bool xmrig::LogQueue::push(uint64_t ts, int level, const char *fmt, va_list args)
+{
+    Record *record = nullptr;
+    size_t pos     = m_enqueue.load(std::memory_order_relaxed);
+
+    while (true) {
+        record = &m_records[pos & (kCapacity - 1)];
+
+        const size_t seq    = record->seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            pos = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->ts      = ts;
+    record->level   = level;
+    record->fmt     = fmt;
+
+    va_list copy;
+    va_copy(copy, args);
+
+    Writer writer(record->args, sizeof(record->args));
+    const bool encoded = encode(writer, fmt, copy);
+
+    va_end(copy);
+
+    if (!encoded) {
+        // Arguments are too large for the record (long strings), fall back to formatting in place.
+        va_copy(copy, args);
+        const int rc = vsnprintf(nullptr, 0, fmt, copy);
+        va_end(copy);
+
+        const size_t size = rc > 0 ? static_cast<size_t>(rc) : 0;
+
+        record->text = new char[size + 1]{};
+        vsnprintf(record->text, size + 1, fmt, args);
+    }
+
+    record->seq.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
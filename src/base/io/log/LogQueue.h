@@ -0,0 +1,68 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_LOGQUEUE_H
+#define XMRIG_LOGQUEUE_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * Bounded lock-free multi producer, single consumer queue of log records.
+ *
+ * Producers store only the format pointer and a binary copy of the arguments (strings are copied by value),
+ * the actual printf formatting is done by the consumer in pop(). Format strings must be literals.
+ */
+class LogQueue
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(LogQueue)
+
+    constexpr static size_t kCapacity   = 4096;
+    constexpr static size_t kRecordSize = 512;
+
+    LogQueue();
+    ~LogQueue();
+
+    bool isEmpty() const;
+    bool pop(char *buf, size_t size, uint64_t &ts, int &level, size_t &written);
+    bool push(uint64_t ts, int level, const char *fmt, va_list args);
+
+private:
+    struct Record;
+
+    std::atomic<size_t> m_enqueue;
+    Record *m_records;
+    size_t m_dequeue = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_LOGQUEUE_H */
@@ -25,9 +25,10 @@
 #include <cstring>
 
 
-xmrig::FileLog::FileLog(const char *fileName) :
+xmrig::FileLog::FileLog(const char *fileName, uint32_t fsync) :
     m_writer(fileName)
 {
+    m_writer.setFsync(fsync);
 }
 
 
@@ -31,7 +31,9 @@ namespace xmrig {
 class FileLog : public ILogBackend
 {
 public:
-    FileLog(const char *fileName);
+    FileLog(const char *fileName, uint32_t fsync = 0);
+
+    inline FileLogWriter &writer()  { return m_writer; }
 
 protected:
     void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) override;
@@ -197,7 +197,10 @@ int xmrig::Base::init()
     }
 
     if (config()->logFile()) {
-        Log::add(new FileLog(config()->logFile()));
+        auto log = new FileLog(config()->logFile(), config()->logFsync());
+        log->writer().setRotate(config()->logRotateSize(), config()->logRotateInterval(), config()->isLogRotateCompress());
+
+        Log::add(log);
     }
 
 #   ifdef HAVE_SYSLOG_H
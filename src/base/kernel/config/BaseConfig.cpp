@@ -56,6 +56,10 @@ const char *BaseConfig::kColors         = "colors";
 const char *BaseConfig::kDryRun         = "dry-run";
 const char *BaseConfig::kHttp           = "http";
 const char *BaseConfig::kLogFile        = "log-file";
+const char *BaseConfig::kLogFsync       = "log-fsync";
+const char *BaseConfig::kLogRotateCompress = "log-rotate-compress";
+const char *BaseConfig::kLogRotateInterval = "log-rotate-interval";
+const char *BaseConfig::kLogRotateSize  = "log-rotate-size";
 const char *BaseConfig::kPrintTime      = "print-time";
 const char *BaseConfig::kSyslog         = "syslog";
 const char *BaseConfig::kTitle          = "title";
@@ -86,6 +90,10 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
     m_syslog            = reader.getBool(kSyslog, m_syslog);
     m_watch             = reader.getBool(kWatch, m_watch);
     m_logFile           = reader.getString(kLogFile);
+    m_logFsync          = reader.getUint(kLogFsync, m_logFsync);
+    m_logRotateSize     = reader.getUint(kLogRotateSize, m_logRotateSize);
+    m_logRotateInterval = reader.getUint(kLogRotateInterval, m_logRotateInterval);
+    m_logRotateCompress = reader.getBool(kLogRotateCompress, m_logRotateCompress);
     m_userAgent         = reader.getString(kUserAgent);
     m_printTime         = std::min(reader.getUint(kPrintTime, m_printTime), 3600U);
     m_title             = reader.getValue(kTitle);
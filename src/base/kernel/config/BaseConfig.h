@@ -49,6 +49,10 @@ public:
     static const char *kDryRun;
     static const char *kHttp;
     static const char *kLogFile;
+    static const char *kLogFsync;
+    static const char *kLogRotateCompress;
+    static const char *kLogRotateInterval;
+    static const char *kLogRotateSize;
     static const char *kPrintTime;
     static const char *kSyslog;
     static const char *kTitle;
@@ -65,6 +69,7 @@ public:
     inline bool isAutoSave() const                          { return m_autoSave; }
     inline bool isBackground() const                        { return m_background; }
     inline bool isDryRun() const                            { return m_dryRun; }
+    inline bool isLogRotateCompress() const                 { return m_logRotateCompress; }
     inline bool isSyslog() const                            { return m_syslog; }
     inline const char *logFile() const                      { return m_logFile.data(); }
     inline const char *userAgent() const                    { return m_userAgent.data(); }
@@ -73,6 +78,9 @@ public:
     inline const String &apiId() const                      { return m_apiId; }
     inline const String &apiWorkerId() const                { return m_apiWorkerId; }
     inline const Title &title() const                       { return m_title; }
+    inline uint32_t logFsync() const                        { return m_logFsync; }
+    inline uint32_t logRotateInterval() const               { return m_logRotateInterval; }
+    inline uint32_t logRotateSize() const                   { return m_logRotateSize; }
     inline uint32_t printTime() const                       { return m_printTime; }
 
 #   ifdef XMRIG_FEATURE_TLS
@@ -92,6 +100,7 @@ protected:
     bool m_autoSave         = true;
     bool m_background       = false;
     bool m_dryRun           = false;
+    bool m_logRotateCompress = false;
     bool m_syslog           = false;
     bool m_upgrade          = false;
     bool m_watch            = true;
@@ -103,6 +112,9 @@ protected:
     String m_logFile;
     String m_userAgent;
     Title m_title;
+    uint32_t m_logFsync     = 0;
+    uint32_t m_logRotateInterval = 0;
+    uint32_t m_logRotateSize = 0;
     uint32_t m_printTime    = 60;
 
 #   ifdef XMRIG_FEATURE_TLS
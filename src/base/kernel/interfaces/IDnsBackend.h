@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "3rdparty/rapidjson/fwd.h"
 #include "base/tools/Object.h"
 
 
@@ -38,6 +39,7 @@ public:
     IDnsBackend()           = default;
     virtual ~IDnsBackend()  = default;
 
+    virtual rapidjson::Value toJSON(rapidjson::Document &doc) const                                                  = 0;
     virtual void resolve(const String &host, const std::weak_ptr<IDnsListener> &listener, const DnsConfig &config)  = 0;
 };
 
@@ -18,6 +18,7 @@
 
 
 #include "base/net/dns/Dns.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/net/dns/DnsRequest.h"
 #include "base/net/dns/DnsUvBackend.h"
 
@@ -32,6 +33,24 @@ std::map<String, std::shared_ptr<IDnsBackend>> Dns::m_backends;
 } // namespace xmrig
 
 
+rapidjson::Value xmrig::Dns::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    auto &allocator = doc.GetAllocator();
+    Value out(kArrayType);
+
+    for (const auto &kv : m_backends) {
+        Value value = kv.second->toJSON(doc);
+        value.AddMember("host", kv.first.toJSON(doc), allocator);
+
+        out.PushBack(value, allocator);
+    }
+
+    return out;
+}
+
+
 std::shared_ptr<xmrig::DnsRequest> xmrig::Dns::resolve(const String &host, IDnsListener *listener)
 {
     auto req = std::make_shared<DnsRequest>(listener);
@@ -43,6 +43,7 @@ public:
     inline static const DnsConfig &config()             { return m_config; }
     inline static void set(const DnsConfig &config)     { m_config = config; }
 
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
     static std::shared_ptr<DnsRequest> resolve(const String &host, IDnsListener *listener);
 
 private:
@@ -28,8 +28,10 @@ namespace xmrig {
 
 
 const char *DnsConfig::kField   = "dns";
-const char *DnsConfig::kIPv     = "ip_version";
-const char *DnsConfig::kTTL     = "ttl";
+const char *DnsConfig::kIPv         = "ip_version";
+const char *DnsConfig::kNegativeTTL = "negative_ttl";
+const char *DnsConfig::kPrefetch    = "prefetch";
+const char *DnsConfig::kTTL         = "ttl";
 
 
 } // namespace xmrig
@@ -42,7 +44,9 @@ xmrig::DnsConfig::DnsConfig(const rapidjson::Value &value)
         m_ipv = ipv;
     }
 
-    m_ttl = std::max(Json::getUint(value, kTTL, m_ttl), 1U);
+    m_ttl         = std::max(Json::getUint(value, kTTL, m_ttl), 1U);
+    m_negativeTtl = std::min(Json::getUint(value, kNegativeTTL, m_negativeTtl), m_ttl);
+    m_prefetch    = Json::getBool(value, kPrefetch, m_prefetch);
 }
 
 
@@ -69,6 +73,8 @@ rapidjson::Value xmrig::DnsConfig::toJSON(rapidjson::Document &doc) const
 
     obj.AddMember(StringRef(kIPv), m_ipv, allocator);
     obj.AddMember(StringRef(kTTL), m_ttl, allocator);
+    obj.AddMember(StringRef(kNegativeTTL), m_negativeTtl, allocator);
+    obj.AddMember(StringRef(kPrefetch), m_prefetch, allocator);
 
     return obj;
 }
@@ -29,20 +29,26 @@ class DnsConfig
 public:
     static const char *kField;
     static const char *kIPv;
+    static const char *kNegativeTTL;
+    static const char *kPrefetch;
     static const char *kTTL;
 
     DnsConfig() = default;
     DnsConfig(const rapidjson::Value &value);
 
-    inline uint32_t ipv() const { return m_ipv; }
-    inline uint32_t ttl() const { return m_ttl * 1000U; }
+    inline bool isPrefetch() const      { return m_prefetch; }
+    inline uint32_t ipv() const         { return m_ipv; }
+    inline uint32_t negativeTtl() const { return m_negativeTtl * 1000U; }
+    inline uint32_t ttl() const         { return m_ttl * 1000U; }
 
     int ai_family() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
 
 private:
-    uint32_t m_ttl = 30U;
-    uint32_t m_ipv = 0U;
+    bool m_prefetch         = true;
+    uint32_t m_negativeTtl  = 5U;
+    uint32_t m_ttl          = 30U;
+    uint32_t m_ipv          = 0U;
 };
 
 
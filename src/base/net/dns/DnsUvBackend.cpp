@@ -19,6 +19,7 @@
 #include <uv.h>
 
 #include "base/net/dns/DnsUvBackend.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/net/dns/DnsConfig.h"
 #include "base/tools/Chrono.h"
@@ -71,34 +72,81 @@ xmrig::DnsUvBackend::~DnsUvBackend()
 }
 
 
+rapidjson::Value xmrig::DnsUvBackend::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    auto &allocator = doc.GetAllocator();
+    Value out(kObjectType);
+
+    out.AddMember("records",    static_cast<uint64_t>(m_records.size()), allocator);
+    out.AddMember("status",     m_status, allocator);
+    out.AddMember("age",        m_ts ? (Chrono::steadyMSecs() - m_ts) / 1000 : 0, allocator);
+    out.AddMember("queries",    m_stats.queries, allocator);
+    out.AddMember("hits",       m_stats.hits, allocator);
+    out.AddMember("misses",     m_stats.misses, allocator);
+    out.AddMember("coalesced",  m_stats.coalesced, allocator);
+    out.AddMember("prefetches", m_stats.prefetches, allocator);
+    out.AddMember("failures",   m_stats.failures, allocator);
+    out.AddMember("latency",    m_stats.latency, allocator);
+
+    return out;
+}
+
+
 void xmrig::DnsUvBackend::resolve(const String &host, const std::weak_ptr<IDnsListener> &listener, const DnsConfig &config)
 {
+    m_stats.queries++;
     m_queue.emplace_back(listener);
 
-    if (Chrono::currentMSecsSinceEpoch() - m_ts <= config.ttl()) {
+    const uint64_t age = Chrono::steadyMSecs() - m_ts;
+
+    if (m_ts && age <= (m_status < 0 ? config.negativeTtl() : config.ttl())) {
+        m_stats.hits++;
+
+        // Refresh ahead of expiry, so reconnecting clients never wait for getaddrinfo.
+        if (!m_req && m_status == 0 && config.isPrefetch() && age > config.ttl() / 4 * 3) {
+            m_stats.prefetches++;
+            m_ai_family = config.ai_family();
+            resolve(host);
+        }
+
         return notify();
     }
 
     if (m_req) {
+        m_stats.coalesced++;
+
         return;
     }
 
+    m_stats.misses++;
     m_ai_family = config.ai_family();
 
-    if (!resolve(host)) {
+    const int rc = resolve(host);
+    if (rc < 0) {
+        m_stats.failures++;
+        m_status  = rc;
+        m_ts      = Chrono::steadyMSecs();
+        m_records = {};
+
         notify();
     }
 }
 
 
-bool xmrig::DnsUvBackend::resolve(const String &host)
+int xmrig::DnsUvBackend::resolve(const String &host)
 {
     m_req = std::make_shared<uv_getaddrinfo_t>();
     m_req->data = getStorage().ptr(m_key);
+    m_started   = Chrono::steadyMSecs();
 
-    m_status = uv_getaddrinfo(uv_default_loop(), m_req.get(), DnsUvBackend::onResolved, host.data(), nullptr, &hints);
+    const int rc = uv_getaddrinfo(uv_default_loop(), m_req.get(), DnsUvBackend::onResolved, host.data(), nullptr, &hints);
+    if (rc < 0) {
+        m_req.reset();
+    }
 
-    return m_status == 0;
+    return rc;
 }
 
 
@@ -114,21 +162,34 @@ void xmrig::DnsUvBackend::notify()
     }
 
     m_queue.clear();
-    m_req.reset();
 }
 
 
 void xmrig::DnsUvBackend::onResolved(int status, addrinfo *res)
 {
-    m_status = status;
-    m_ts     = Chrono::currentMSecsSinceEpoch();
+    const uint64_t now = Chrono::steadyMSecs();
+
+    m_req.reset();
+    m_stats.latency = now - m_started;
 
-    if (m_status < 0) {
+    if (status < 0) {
+        m_stats.failures++;
+
+        // A failed refresh keeps serving the previous records until they expire.
+        if (m_status == 0 && !m_records.isEmpty() && m_queue.empty()) {
+            return;
+        }
+
+        m_status  = status;
+        m_ts      = now;
         m_records = {};
 
         return notify();
     }
 
+    m_status = status;
+    m_ts     = now;
+
     m_records = { res, m_ai_family };
 
     if (m_records.isEmpty()) {
@@ -40,20 +40,34 @@ public:
     ~DnsUvBackend() override;
 
 protected:
+    rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void resolve(const String &host, const std::weak_ptr<IDnsListener> &listener, const DnsConfig &config) override;
 
 private:
-    bool resolve(const String &host);
+    int resolve(const String &host);
     void notify();
     void onResolved(int status, addrinfo *res);
 
     static void onResolved(uv_getaddrinfo_t *req, int status, addrinfo *res);
 
+    struct Stats
+    {
+        uint64_t coalesced  = 0;
+        uint64_t failures   = 0;
+        uint64_t hits       = 0;
+        uint64_t latency    = 0;
+        uint64_t misses     = 0;
+        uint64_t prefetches = 0;
+        uint64_t queries    = 0;
+    };
+
     DnsRecords m_records;
     int m_ai_family         = 0;
     int m_status            = 0;
+    Stats m_stats;
     std::deque<std::weak_ptr<IDnsListener>> m_queue;
     std::shared_ptr<uv_getaddrinfo_t> m_req;
+    uint64_t m_started      = 0;
     uint64_t m_ts           = 0;
     uintptr_t m_key;
 
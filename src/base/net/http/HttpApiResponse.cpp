@@ -46,13 +46,24 @@ xmrig::HttpApiResponse::HttpApiResponse(uint64_t id, int status) :
 }
 
 
-void xmrig::HttpApiResponse::end()
+std::string xmrig::HttpApiResponse::serialize(const rapidjson::Value &value)
 {
     using namespace rapidjson;
 
-    setHeader("Access-Control-Allow-Origin", "*");
-    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
-    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
+    StringBuffer buffer(nullptr, 4096);
+    PrettyWriter<StringBuffer> writer(buffer);
+    writer.SetMaxDecimalPlaces(10);
+    writer.SetFormatOptions(kFormatSingleLineArray);
+
+    value.Accept(writer);
+
+    return { buffer.GetString(), buffer.GetSize() };
+}
+
+
+void xmrig::HttpApiResponse::end()
+{
+    using namespace rapidjson;
 
     if (statusCode() >= 400) {
         if (!m_doc.HasMember(kStatus)) {
@@ -64,18 +75,48 @@ void xmrig::HttpApiResponse::end()
         }
     }
 
+    if (m_contentType && statusCode() < 400) {
+        setHeaders();
+        setHeader(HttpData::kContentType, m_contentType);
+
+        return HttpResponse::end(m_text.data(), m_text.size());
+    }
+
     if (m_doc.IsObject() && m_doc.ObjectEmpty()) {
+        setHeaders();
+
         return HttpResponse::end();
     }
 
+    end(serialize(m_doc));
+}
+
+
+/**
+ * Send an already serialized JSON body, used for cached responses.
+ */
+void xmrig::HttpApiResponse::end(const std::string &body)
+{
+    setHeaders();
     setHeader(HttpData::kContentType, HttpData::kApplicationJson);
 
-    StringBuffer buffer(nullptr, 4096);
-    PrettyWriter<StringBuffer> writer(buffer);
-    writer.SetMaxDecimalPlaces(10);
-    writer.SetFormatOptions(kFormatSingleLineArray);
+    HttpResponse::end(body.data(), body.size());
+}
 
-    m_doc.Accept(writer);
 
-    HttpResponse::end(buffer.GetString(), buffer.GetSize());
+/**
+ * Replace the JSON document with a plain text body, used by non JSON endpoints like /metrics.
+ */
+void xmrig::HttpApiResponse::setText(std::string &&text, const char *contentType)
+{
+    m_text        = std::move(text);
+    m_contentType = contentType;
+}
+
+
+void xmrig::HttpApiResponse::setHeaders()
+{
+    setHeader("Access-Control-Allow-Origin", "*");
+    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
+    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
 }
@@ -36,10 +36,18 @@ public:
 
     inline rapidjson::Document &doc() { return m_doc; }
 
+    static std::string serialize(const rapidjson::Value &value);
+
     void end();
+    void end(const std::string &body);
+    void setText(std::string &&text, const char *contentType);
 
 private:
+    void setHeaders();
+
+    const char *m_contentType = nullptr;
     rapidjson::Document m_doc;
+    std::string m_text;
 };
 
 
@@ -26,6 +26,8 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <uv.h>
 
 
@@ -33,8 +35,11 @@ namespace xmrig {
 
 
 static llhttp_settings_t http_settings;
-static std::map<uint64_t, HttpContext *> storage;
-static uint64_t SEQUENCE = 0;
+static std::once_flag http_settings_flag;
+static std::atomic<uint64_t> SEQUENCE{0};
+
+// Contexts are only accessed from the thread of the loop they belong to.
+static thread_local std::map<uint64_t, HttpContext *> storage;
 
 
 class HttpWriteBaton : public Baton<uv_write_t>
@@ -71,7 +76,7 @@ private:
 } // namespace xmrig
 
 
-xmrig::HttpContext::HttpContext(int parser_type, const std::weak_ptr<IHttpListener> &listener) :
+xmrig::HttpContext::HttpContext(int parser_type, const std::weak_ptr<IHttpListener> &listener, uv_loop_t *loop) :
     HttpData(SEQUENCE++),
     m_timestamp(Chrono::steadyMSecs()),
     m_listener(listener)
@@ -81,16 +86,14 @@ xmrig::HttpContext::HttpContext(int parser_type, const std::weak_ptr<IHttpListen
     m_parser = new llhttp_t;
     m_tcp    = new uv_tcp_t;
 
-    uv_tcp_init(uv_default_loop(), m_tcp);
+    uv_tcp_init(loop ? loop : uv_default_loop(), m_tcp);
     uv_tcp_nodelay(m_tcp, 1);
 
+    std::call_once(http_settings_flag, [] { attach(&http_settings); });
+
     llhttp_init(m_parser, static_cast<llhttp_type_t>(parser_type), &http_settings);
 
     m_parser->data = m_tcp->data = this;
-
-    if (http_settings.on_message_complete == nullptr) {
-        attach(&http_settings);
-    }
 }
 
 
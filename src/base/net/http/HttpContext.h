@@ -26,6 +26,7 @@ using llhttp_settings_t     = struct llhttp_settings_s;
 using llhttp_t              = struct llhttp__internal_s;
 using uv_connect_t          = struct uv_connect_s;
 using uv_handle_t           = struct uv_handle_s;
+using uv_loop_t             = struct uv_loop_s;
 using uv_stream_t           = struct uv_stream_s;
 using uv_tcp_t              = struct uv_tcp_s;
 
@@ -48,7 +49,7 @@ class HttpContext : public HttpData
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpContext)
 
-    HttpContext(int parser_type, const std::weak_ptr<IHttpListener> &listener);
+    HttpContext(int parser_type, const std::weak_ptr<IHttpListener> &listener, uv_loop_t *loop = nullptr);
     ~HttpContext() override;
 
     inline uv_stream_t *stream() const { return reinterpret_cast<uv_stream_t *>(m_tcp); }
@@ -42,7 +42,7 @@ xmrig::HttpServer::~HttpServer()
 
 void xmrig::HttpServer::onConnection(uv_stream_t *stream, uint16_t)
 {
-    auto ctx = new HttpContext(HTTP_REQUEST, m_listener);
+    auto ctx = new HttpContext(HTTP_REQUEST, m_listener, stream->loop);
     uv_accept(stream, ctx->stream());
 
     uv_read_start(ctx->stream(), NetBuffer::onAlloc,
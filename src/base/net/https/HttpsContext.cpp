@@ -21,12 +21,11 @@
 #include "base/net/tls/TlsContext.h"
 
 
-#include <openssl/bio.h>
 #include <uv.h>
 
 
-xmrig::HttpsContext::HttpsContext(TlsContext *tls, const std::weak_ptr<IHttpListener> &listener) :
-    HttpContext(HTTP_REQUEST, listener),
+xmrig::HttpsContext::HttpsContext(TlsContext *tls, const std::weak_ptr<IHttpListener> &listener, uv_loop_t *loop) :
+    HttpContext(HTTP_REQUEST, listener, loop),
     ServerTls(tls ? tls->ctx() : nullptr)
 {
     if (!tls) {
@@ -53,19 +52,19 @@ void xmrig::HttpsContext::append(char *data, size_t size)
 }
 
 
-bool xmrig::HttpsContext::write(BIO *bio)
+bool xmrig::HttpsContext::write(const char *data, size_t size)
 {
     if (uv_is_writable(stream()) != 1) {
         return false;
     }
 
-    char *data        = nullptr;
-    const size_t size = BIO_get_mem_data(bio, &data); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
-    std::string body(data, size);
-
-    (void) BIO_reset(bio);
-
-    HttpContext::write(std::move(body), m_close);
+    // Records of a single response are collected and written at once.
+    if (m_sending) {
+        m_output.append(data, size);
+    }
+    else {
+        HttpContext::write(std::string(data, size), false);
+    }
 
     return true;
 }
@@ -87,10 +86,13 @@ void xmrig::HttpsContext::shutdown()
 
 void xmrig::HttpsContext::write(std::string &&data, bool close)
 {
-    m_close = close;
-
     if (m_mode == TLS_ON) {
+        m_sending = true;
         send(data.data(), data.size());
+        m_sending = false;
+
+        HttpContext::write(std::move(m_output), close);
+        m_output.clear();
     }
     else {
         HttpContext::write(std::move(data), close);
@@ -21,7 +21,6 @@
 #define XMRIG_HTTPSCONTEXT_H
 
 
-using BIO = struct bio_st;
 using SSL = struct ssl_st;
 
 
@@ -40,14 +39,14 @@ class HttpsContext : public HttpContext, public ServerTls
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpsContext)
 
-    HttpsContext(TlsContext *tls, const std::weak_ptr<IHttpListener> &listener);
+    HttpsContext(TlsContext *tls, const std::weak_ptr<IHttpListener> &listener, uv_loop_t *loop = nullptr);
     ~HttpsContext() override;
 
     void append(char *data, size_t size);
 
 protected:
     // ServerTls
-    bool write(BIO *bio) override;
+    bool write(const char *data, size_t size) override;
     void parse(char *data, size_t size) override;
     void shutdown() override;
 
@@ -61,7 +60,8 @@ private:
       TLS_ON
     };
 
-    bool m_close    = false;
+    bool m_sending  = false;
+    std::string m_output;
     TlsMode m_mode  = TLS_AUTO;
 };
 
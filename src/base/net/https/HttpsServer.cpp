@@ -42,14 +42,20 @@ xmrig::HttpsServer::~HttpsServer()
 bool xmrig::HttpsServer::setTls(const TlsConfig &config)
 {
     m_tls = TlsContext::create(config);
+    if (!m_tls) {
+        return false;
+    }
+
+    // The HTTP server already has a thread of its own, handshakes are done inline.
+    m_tls->setHandshakeThreads(0);
 
-    return m_tls != nullptr;
+    return true;
 }
 
 
 void xmrig::HttpsServer::onConnection(uv_stream_t *stream, uint16_t)
 {
-    auto ctx = new HttpsContext(m_tls, m_listener);
+    auto ctx = new HttpsContext(m_tls, m_listener, stream->loop);
     uv_accept(stream, ctx->stream());
 
     uv_read_start(ctx->stream(), NetBuffer::onAlloc, onRead); // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -17,6 +17,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <iterator>
@@ -50,6 +51,8 @@
 #include "base/tools/Chrono.h"
 #include "base/tools/cryptonote/BlobReader.h"
 #include "base/tools/Cvt.h"
+#include "base/tools/Handle.h"
+#include "base/tools/Timer.h"
 #include "net/JobResult.h"
 
 
@@ -84,12 +87,14 @@ xmrig::Client::Client(int id, const char *agent, IClientListener *listener) :
     m_tempBuf(320)
 {
     m_reader.setListener(this);
-    m_key = m_storage.add(this);
+    m_key   = m_storage.add(this);
+    m_timer = new Timer(this);
 }
 
 
 xmrig::Client::~Client()
 {
+    delete m_timer;
     delete m_socket;
 }
 
@@ -339,10 +344,44 @@ void xmrig::Client::onResolved(const DnsRecords &records, int status, const char
         return reconnect();
     }
 
-    const auto &record = records.get();
-    m_ip = record.ip();
+    // RFC 8305: start with the preferred record and interleave address families.
+    const auto &first = records.get();
+    const auto &all   = records.records();
+    const size_t size = all.size();
+    const size_t from = static_cast<size_t>(&first - all.data());
 
-    connect(record.addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()));
+    std::vector<DnsRecord> primary;
+    std::vector<DnsRecord> secondary;
+
+    for (size_t i = 0; i < size; ++i) {
+        const auto &record = all[(from + i) % size];
+        (record.family() == first.family() ? primary : secondary).push_back(record);
+    }
+
+    m_addrs.clear();
+    m_addrIndex = 0;
+
+    for (size_t i = 0; i < std::max(primary.size(), secondary.size()); ++i) {
+        if (i < primary.size()) {
+            m_addrs.push_back(primary[i]);
+        }
+
+        if (i < secondary.size()) {
+            m_addrs.push_back(secondary[i]);
+        }
+    }
+
+    m_ip = first.ip();
+
+    connectNext();
+}
+
+
+void xmrig::Client::onTimer(const Timer *)
+{
+    if (m_state == ConnectingState && m_addrIndex < m_addrs.size()) {
+        connectNext();
+    }
 }
 
 
@@ -352,11 +391,23 @@ bool xmrig::Client::close()
         return m_socket != nullptr;
     }
 
-    if (m_state == UnconnectedState || m_socket == nullptr) {
+    if (m_state == UnconnectedState || (m_socket == nullptr && m_attempts.empty())) {
         return false;
     }
 
     setState(ClosingState);
+    m_timer->stop();
+
+    if (m_socket == nullptr) {
+        m_socket = m_attempts.back().first;
+        m_attempts.pop_back();
+    }
+
+    for (const auto &attempt : m_attempts) {
+        Handle::close(attempt.first);
+    }
+
+    m_attempts.clear();
 
     if (uv_is_closing(reinterpret_cast<uv_handle_t*>(m_socket)) == 0) {
         if (Platform::hasKeepalive()) {
@@ -434,9 +485,18 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
 
     job.setSigKey(Json::getString(params, "sig_key"));
 
+#   ifdef XMRIG_PROXY_PROJECT
+    // Granted block starts at the fixed byte and can't wrap past the last value of the byte.
+    job.setSlots(static_cast<uint16_t>(std::min<uint32_t>(Json::getUint(params, "slots"), Pool::kCascadeSlots - job.fixedByte())));
+#   endif
+
     m_job.setClientId(m_rpcId);
 
     if (m_job != job) {
+#       ifdef XMRIG_PROXY_PROJECT
+        job.setTimestamps(m_receivedAt, Chrono::highResolutionMSecs());
+#       endif
+
         m_jobs++;
         m_job = std::move(job);
         return true;
@@ -581,17 +641,92 @@ void xmrig::Client::connect(const sockaddr *addr)
     auto req = new uv_connect_t;
     req->data = m_storage.ptr(m_key);
 
-    m_socket = new uv_tcp_t;
-    m_socket->data = m_storage.ptr(m_key);
+    auto socket  = new uv_tcp_t;
+    socket->data = m_storage.ptr(m_key);
 
-    uv_tcp_init(uv_default_loop(), m_socket);
-    uv_tcp_nodelay(m_socket, 1);
+    uv_tcp_init(uv_default_loop(), socket);
+    uv_tcp_nodelay(socket, 1);
 
     if (Platform::hasKeepalive()) {
-        uv_tcp_keepalive(m_socket, 1, 60);
+        uv_tcp_keepalive(socket, 1, 60);
+    }
+
+    m_attempts.emplace_back(socket, m_ip);
+
+    const int rc = uv_tcp_connect(req, socket, addr, onConnect);
+    if (rc < 0) {
+        delete req;
+
+        connected(socket, rc);
+    }
+}
+
+
+void xmrig::Client::connectNext()
+{
+    const auto &record = m_addrs[m_addrIndex++];
+    m_ip = record.ip();
+
+    if (m_addrIndex < m_addrs.size()) {
+        m_timer->singleShot(kAttemptDelay);
+    }
+
+    connect(record.addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()));
+}
+
+
+void xmrig::Client::connected(uv_tcp_t *socket, int status)
+{
+    auto it = std::find_if(m_attempts.begin(), m_attempts.end(), [socket](const std::pair<uv_tcp_t *, String> &attempt) { return attempt.first == socket; });
+    if (it == m_attempts.end()) {
+        return;
+    }
+
+    m_ip = it->second;
+    m_attempts.erase(it);
+
+    if (status < 0) {
+        if (!isQuiet()) {
+            LOG_ERR("%s %s " RED("connect error: ") RED_BOLD("\"%s\""), tag(), m_ip.data(), uv_strerror(status));
+        }
+
+        Handle::close(socket);
+
+        if (m_state != ConnectingState) {
+            return;
+        }
+
+        if (m_addrIndex < m_addrs.size()) {
+            return connectNext();
+        }
+
+        if (m_attempts.empty()) {
+            onClose();
+        }
+
+        return;
+    }
+
+    if (m_state != ConnectingState) {
+        Handle::close(socket);
+
+        return;
+    }
+
+    m_timer->stop();
+
+    for (const auto &attempt : m_attempts) {
+        Handle::close(attempt.first);
     }
 
-    uv_tcp_connect(req, m_socket, addr, onConnect);
+    m_attempts.clear();
+    m_socket = socket;
+
+    setState(ConnectedState);
+
+    uv_read_start(stream(), NetBuffer::onAlloc, onRead);
+
+    handshake();
 }
 
 
@@ -677,6 +812,8 @@ void xmrig::Client::onClose()
 
 void xmrig::Client::parse(char *line, size_t len)
 {
+    m_receivedAt = Chrono::highResolutionMSecs();
+
     LOG_DEBUG("[%s] received (%d bytes): \"%.*s\"", url(), len, static_cast<int>(len), line);
 
     if (len < 22 || line[0] != '{') {
@@ -700,6 +837,12 @@ void xmrig::Client::parse(char *line, size_t len)
         return;
     }
 
+    parseMessage(doc);
+}
+
+
+void xmrig::Client::parseMessage(const rapidjson::Value &doc)
+{
     const auto &id    = Json::getValue(doc, "id");
     const auto &error = Json::getValue(doc, "error");
     const char *method = Json::getString(doc, "method");
@@ -1026,38 +1169,14 @@ void xmrig::Client::onClose(uv_handle_t *handle)
 void xmrig::Client::onConnect(uv_connect_t *req, int status)
 {
     auto client = getClient(req->data);
+    auto socket = reinterpret_cast<uv_tcp_t *>(req->handle);
     delete req;
 
     if (!client) {
         return;
     }
 
-    if (status < 0) {
-        if (!client->isQuiet()) {
-            LOG_ERR("%s %s " RED("connect error: ") RED_BOLD("\"%s\""), client->tag(), client->ip().data(), uv_strerror(status));
-        }
-
-        if (client->state() == ReconnectingState || client->state() == ClosingState) {
-            return;
-        }
-
-        if (client->state() != ConnectingState) {
-            return;
-        }
-
-        client->close();
-        return;
-    }
-
-    if (client->state() == ConnectedState) {
-        return;
-    }
-
-    client->setState(ConnectedState);
-
-    uv_read_start(client->stream(), NetBuffer::onAlloc, onRead);
-
-    client->handshake();
+    client->connected(socket, status);
 }
 
 
@@ -29,6 +29,8 @@
 
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/ILineListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/dns/DnsRecord.h"
 #include "base/net/stratum/BaseClient.h"
 #include "base/net/stratum/Job.h"
 #include "base/net/stratum/Pool.h"
@@ -49,11 +51,12 @@ class IClientListener;
 class JobResult;
 
 
-class Client : public BaseClient, public IDnsListener, public ILineListener
+class Client : public BaseClient, public IDnsListener, public ILineListener, public ITimerListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Client)
 
+    constexpr static uint64_t kAttemptDelay     = 250;
     constexpr static uint64_t kConnectTimeout   = 20 * 1000;
     constexpr static uint64_t kResponseTimeout  = 20 * 1000;
     constexpr static size_t kMaxSendBufferSize  = 1024 * 16;
@@ -75,22 +78,26 @@ protected:
     void tick(uint64_t now) override;
 
     void onResolved(const DnsRecords &records, int status, const char *error) override;
+    void onTimer(const Timer *timer) override;
 
     inline bool hasExtension(Extension extension) const noexcept override   { return m_extensions.test(extension); }
     inline const char *mode() const override                                { return "pool"; }
     inline void onLine(char *line, size_t size) override                    { parse(line, size); }
 
     inline const char *agent() const                                        { return m_agent; }
+    inline double receivedAt() const                                        { return m_receivedAt; }
     inline const char *url() const                                          { return m_pool.url(); }
     inline const String &rpcId() const                                      { return m_rpcId; }
     inline void setRpcId(const char *id)                                    { m_rpcId = id; }
     inline void setPoolUrl(const char *url)                                 { m_pool.setUrl(url); }
+    inline void setReceivedAt(double ts)                                    { m_receivedAt = ts; }
 
     virtual bool parseLogin(const rapidjson::Value &result, int *code);
     virtual void login();
+    virtual void parseMessage(const rapidjson::Value &doc);
     virtual void parseNotification(const char* method, const rapidjson::Value& params, const rapidjson::Value& error);
 
-    bool close();
+    virtual bool close();
     virtual void onClose();
 
 private:
@@ -104,6 +111,8 @@ private:
     int resolve(const String &host);
     int64_t send(size_t size);
     void connect(const sockaddr *addr);
+    void connectNext();
+    void connected(uv_tcp_t *socket, int status);
     void handshake();
     void parse(char *line, size_t len);
     void parseExtensions(const rapidjson::Value &result);
@@ -127,13 +136,18 @@ private:
     static inline Client *getClient(void *data) { return m_storage.get(data); }
 
     const char *m_agent;
+    double m_receivedAt         = 0.0;
     LineReader m_reader;
+    size_t m_addrIndex          = 0;
     Socks5 *m_socks5            = nullptr;
     std::bitset<EXT_MAX> m_extensions;
     std::shared_ptr<DnsRequest> m_dns;
+    std::vector<DnsRecord> m_addrs;
+    std::vector<std::pair<uv_tcp_t *, String> > m_attempts;
     std::vector<char> m_sendBuf;
     std::vector<char> m_tempBuf;
     String m_rpcId;
+    Timer *m_timer;
     Tls *m_tls                  = nullptr;
     uint64_t m_expire           = 0;
     uint64_t m_jobs             = 0;
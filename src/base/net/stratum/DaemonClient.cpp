@@ -42,6 +42,7 @@
 #include "base/net/stratum/SubmitResult.h"
 #include "base/net/tools/NetBuffer.h"
 #include "base/tools/bswap_64.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/cryptonote/Signatures.h"
 #include "base/tools/Cvt.h"
 #include "base/tools/Timer.h"
@@ -246,6 +247,8 @@ void xmrig::DaemonClient::setPool(const Pool &pool)
 
 void xmrig::DaemonClient::onHttpData(const HttpData &data)
 {
+    m_receivedAt = Chrono::highResolutionMSecs();
+
     if (data.status != 200) {
         return retry();
     }
@@ -487,6 +490,10 @@ bool xmrig::DaemonClient::parseJob(const rapidjson::Value &params, int *code)
     m_currentJobId = Cvt::toHex(Cvt::randomBytes(4));
     job.setId(m_currentJobId);
 
+#   ifdef XMRIG_PROXY_PROJECT
+    job.setTimestamps(m_receivedAt, Chrono::highResolutionMSecs());
+#   endif
+
     m_job              = std::move(job);
     m_blocktemplateStr = std::move(blocktemplate);
     m_prevHash         = Json::getString(params, "prev_hash");
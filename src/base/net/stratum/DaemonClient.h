@@ -105,6 +105,7 @@ private:
     String m_currentJobId;
     String m_prevHash;
     uint64_t m_jobSteadyMs = 0;
+    double m_receivedAt    = 0.0;
     String m_tlsFingerprint;
     String m_tlsVersion;
     Timer *m_timer;
@@ -36,9 +36,16 @@
 #include "base/crypto/keccak.h"
 
 
+xmrig::Job::Job() :
+    m_payload(emptyPayload())
+{
+}
+
+
 xmrig::Job::Job(bool nicehash, const Algorithm &algorithm, const String &clientId) :
     m_algorithm(algorithm),
     m_nicehash(nicehash),
+    m_payload(emptyPayload()),
     m_clientId(clientId)
 {
 }
@@ -52,7 +59,7 @@ bool xmrig::Job::isEqual(const Job &other) const
 
 bool xmrig::Job::isEqualBlob(const Job &other) const
 {
-    return (m_size == other.m_size) && (memcmp(m_blob, other.m_blob, m_size) == 0);
+    return (m_size == other.m_size) && (m_payload == other.m_payload || memcmp(m_payload->blob, other.m_payload->blob, m_size) == 0);
 }
 
 
@@ -70,11 +77,13 @@ bool xmrig::Job::setBlob(const char *blob)
     size /= 2;
 
     const size_t minSize = nonceOffset() + nonceSize();
-    if (size < minSize || size >= sizeof(m_blob)) {
+    if (size < minSize || size >= kMaxBlobSize) {
         return false;
     }
 
-    if (!Cvt::fromHex(m_blob, sizeof(m_blob), blob, size * 2)) {
+    Payload &data = payload();
+
+    if (!Cvt::fromHex(data.blob, sizeof(data.blob), blob, size * 2)) {
         return false;
     }
 
@@ -83,8 +92,8 @@ bool xmrig::Job::setBlob(const char *blob)
     }
 
 #   ifdef XMRIG_PROXY_PROJECT
-    memset(m_rawBlob, 0, sizeof(m_rawBlob));
-    memcpy(m_rawBlob, blob, size * 2);
+    memset(data.rawBlob, 0, sizeof(data.rawBlob));
+    memcpy(data.rawBlob, blob, size * 2);
 #   endif
 
     m_size = size;
@@ -98,13 +107,15 @@ bool xmrig::Job::setSeedHash(const char *hash)
         return false;
     }
 
+    Payload &data = payload();
+
 #   ifdef XMRIG_PROXY_PROJECT
-    m_rawSeedHash = hash;
+    data.rawSeedHash = hash;
 #   endif
 
-    m_seed = Cvt::fromHex(hash, kMaxSeedSize * 2);
+    data.seed = Cvt::fromHex(hash, kMaxSeedSize * 2);
 
-    return !m_seed.empty();
+    return !data.seed.empty();
 }
 
 
@@ -198,7 +209,7 @@ void xmrig::Job::setSigKey(const char *sig_key)
         setEphemeralKeys(buf.data(), buf.data() + 32);
     }
 #   else
-    m_rawSigKey = sig_key;
+    payload().rawSigKey = sig_key;
 #   endif
 }
 
@@ -216,7 +227,7 @@ uint32_t xmrig::Job::getNumTransactions() const
 
     if ((m_size > expected_tx_offset) && (m_size <= expected_tx_offset + 4)) {
         for (size_t i = expected_tx_offset, k = 0; i < m_size; ++i, k += 7) {
-            const uint8_t b = m_blob[i];
+            const uint8_t b = m_payload->blob[i];
             num_transactions |= static_cast<uint32_t>(b & 0x7F) << k;
             if ((b & 0x80) == 0) {
                 break;
@@ -233,6 +244,7 @@ void xmrig::Job::copy(const Job &other)
     m_algorithm  = other.m_algorithm;
     m_nicehash   = other.m_nicehash;
     m_size       = other.m_size;
+    m_payload    = other.m_payload;
     m_clientId   = other.m_clientId;
     m_id         = other.m_id;
     m_backend    = other.m_backend;
@@ -240,17 +252,14 @@ void xmrig::Job::copy(const Job &other)
     m_height     = other.m_height;
     m_target     = other.m_target;
     m_index      = other.m_index;
-    m_seed       = other.m_seed;
     m_extraNonce = other.m_extraNonce;
     m_poolWallet = other.m_poolWallet;
 
-    memcpy(m_blob, other.m_blob, sizeof(m_blob));
-
 #   ifdef XMRIG_PROXY_PROJECT
-    m_rawSeedHash = other.m_rawSeedHash;
-    m_rawSigKey   = other.m_rawSigKey;
+    m_slots      = other.m_slots;
+    m_parsedAt   = other.m_parsedAt;
+    m_receivedAt = other.m_receivedAt;
 
-    memcpy(m_rawBlob, other.m_rawBlob, sizeof(m_rawBlob));
     memcpy(m_rawTarget, other.m_rawTarget, sizeof(m_rawTarget));
 #   endif
 
@@ -258,24 +267,6 @@ void xmrig::Job::copy(const Job &other)
     m_benchSize = other.m_benchSize;
 #   endif
 
-#   ifdef XMRIG_PROXY_PROJECT
-    memcpy(m_spendSecretKey, other.m_spendSecretKey, sizeof(m_spendSecretKey));
-    memcpy(m_viewSecretKey, other.m_viewSecretKey, sizeof(m_viewSecretKey));
-    memcpy(m_spendPublicKey, other.m_spendPublicKey, sizeof(m_spendPublicKey));
-    memcpy(m_viewPublicKey, other.m_viewPublicKey, sizeof(m_viewPublicKey));
-    m_minerTxPrefix = other.m_minerTxPrefix;
-    m_minerTxEphPubKeyOffset = other.m_minerTxEphPubKeyOffset;
-    m_minerTxPubKeyOffset = other.m_minerTxPubKeyOffset;
-    m_minerTxExtraNonceOffset = other.m_minerTxExtraNonceOffset;
-    m_minerTxExtraNonceSize = other.m_minerTxExtraNonceSize;
-    m_minerTxMerkleTreeBranch = other.m_minerTxMerkleTreeBranch;
-    m_minerTxMerkleTreePath = other.m_minerTxMerkleTreePath;
-    m_hasViewTag = other.m_hasViewTag;
-#   else
-    memcpy(m_ephPublicKey, other.m_ephPublicKey, sizeof(m_ephPublicKey));
-    memcpy(m_ephSecretKey, other.m_ephSecretKey, sizeof(m_ephSecretKey));
-#   endif
-
     m_hasMinerSignature = other.m_hasMinerSignature;
 }
 
@@ -285,6 +276,7 @@ void xmrig::Job::move(Job &&other)
     m_algorithm  = other.m_algorithm;
     m_nicehash   = other.m_nicehash;
     m_size       = other.m_size;
+    m_payload    = std::move(other.m_payload);
     m_clientId   = std::move(other.m_clientId);
     m_id         = std::move(other.m_id);
     m_backend    = other.m_backend;
@@ -292,21 +284,19 @@ void xmrig::Job::move(Job &&other)
     m_height     = other.m_height;
     m_target     = other.m_target;
     m_index      = other.m_index;
-    m_seed       = std::move(other.m_seed);
     m_extraNonce = std::move(other.m_extraNonce);
     m_poolWallet = std::move(other.m_poolWallet);
 
-    memcpy(m_blob, other.m_blob, sizeof(m_blob));
-
     other.m_size        = 0;
     other.m_diff        = 0;
     other.m_algorithm   = Algorithm::INVALID;
+    other.m_payload     = emptyPayload();
 
 #   ifdef XMRIG_PROXY_PROJECT
-    m_rawSeedHash = std::move(other.m_rawSeedHash);
-    m_rawSigKey   = std::move(other.m_rawSigKey);
+    m_slots       = other.m_slots;
+    m_parsedAt    = other.m_parsedAt;
+    m_receivedAt  = other.m_receivedAt;
 
-    memcpy(m_rawBlob, other.m_rawBlob, sizeof(m_rawBlob));
     memcpy(m_rawTarget, other.m_rawTarget, sizeof(m_rawTarget));
 #   endif
 
@@ -314,72 +304,109 @@ void xmrig::Job::move(Job &&other)
     m_benchSize = other.m_benchSize;
 #   endif
 
-#   ifdef XMRIG_PROXY_PROJECT
-    memcpy(m_spendSecretKey, other.m_spendSecretKey, sizeof(m_spendSecretKey));
-    memcpy(m_viewSecretKey, other.m_viewSecretKey, sizeof(m_viewSecretKey));
-    memcpy(m_spendPublicKey, other.m_spendPublicKey, sizeof(m_spendPublicKey));
-    memcpy(m_viewPublicKey, other.m_viewPublicKey, sizeof(m_viewPublicKey));
-
-    m_minerTxPrefix             = std::move(other.m_minerTxPrefix);
-    m_minerTxEphPubKeyOffset    = other.m_minerTxEphPubKeyOffset;
-    m_minerTxPubKeyOffset       = other.m_minerTxPubKeyOffset;
-    m_minerTxExtraNonceOffset   = other.m_minerTxExtraNonceOffset;
-    m_minerTxExtraNonceSize     = other.m_minerTxExtraNonceSize;
-    m_minerTxMerkleTreeBranch   = std::move(other.m_minerTxMerkleTreeBranch);
-    m_minerTxMerkleTreePath     = other.m_minerTxMerkleTreePath;
-    m_hasViewTag                = other.m_hasViewTag;
-#   else
-    memcpy(m_ephPublicKey, other.m_ephPublicKey, sizeof(m_ephPublicKey));
-    memcpy(m_ephSecretKey, other.m_ephSecretKey, sizeof(m_ephSecretKey));
-#   endif
-
     m_hasMinerSignature = other.m_hasMinerSignature;
 }
 
 
+const std::shared_ptr<xmrig::Job::Payload> &xmrig::Job::emptyPayload()
+{
+    static const std::shared_ptr<Payload> payload = std::make_shared<Payload>();
+
+    return payload;
+}
+
+
+xmrig::Job::Payload &xmrig::Job::payload()
+{
+    // The shared empty payload always has more than one owner, so it is never changed.
+    if (m_payload.use_count() > 1) {
+        m_payload = std::make_shared<Payload>(*m_payload);
+    }
+
+    return *m_payload;
+}
+
+
 #ifdef XMRIG_PROXY_PROJECT
 
 
+/**
+ * Adopts the payload of another job with the same template (blob, seed and signature key), so both jobs point to
+ * the same memory. Jobs with miner signatures carry per connection keys and are never shared.
+ */
+bool xmrig::Job::share(const Job &other)
+{
+    if (m_payload == other.m_payload) {
+        return true;
+    }
+
+    if (m_hasMinerSignature || other.m_hasMinerSignature || !isEqualBlob(other)) {
+        return false;
+    }
+
+    const Payload &a = *m_payload;
+    const Payload &b = *other.m_payload;
+
+    if (a.rawSeedHash != b.rawSeedHash || a.rawSigKey != b.rawSigKey || !a.minerTxPrefix.empty() || !b.minerTxPrefix.empty()) {
+        return false;
+    }
+
+    m_payload = other.m_payload;
+
+    return true;
+}
+
+
 void xmrig::Job::setSpendSecretKey(const uint8_t *key)
 {
+    Payload &data = payload();
+
     m_hasMinerSignature = true;
-    memcpy(m_spendSecretKey, key, sizeof(m_spendSecretKey));
+    memcpy(data.spendSecretKey, key, sizeof(data.spendSecretKey));
 
-    derive_view_secret_key(m_spendSecretKey, m_viewSecretKey);
-    secret_key_to_public_key(m_spendSecretKey, m_spendPublicKey);
-    secret_key_to_public_key(m_viewSecretKey, m_viewPublicKey);
+    derive_view_secret_key(data.spendSecretKey, data.viewSecretKey);
+    secret_key_to_public_key(data.spendSecretKey, data.spendPublicKey);
+    secret_key_to_public_key(data.viewSecretKey, data.viewPublicKey);
 }
 
 
 void xmrig::Job::setMinerTx(const uint8_t *begin, const uint8_t *end, size_t minerTxEphPubKeyOffset, size_t minerTxPubKeyOffset, size_t minerTxExtraNonceOffset, size_t minerTxExtraNonceSize, const Buffer &minerTxMerkleTreeBranch, uint32_t minerTxMerkleTreePath, bool hasViewTag)
 {
-    m_minerTxPrefix.assign(begin, end);
-    m_minerTxEphPubKeyOffset    = minerTxEphPubKeyOffset;
-    m_minerTxPubKeyOffset       = minerTxPubKeyOffset;
-    m_minerTxExtraNonceOffset   = minerTxExtraNonceOffset;
-    m_minerTxExtraNonceSize     = minerTxExtraNonceSize;
-    m_minerTxMerkleTreeBranch   = minerTxMerkleTreeBranch;
-    m_minerTxMerkleTreePath     = minerTxMerkleTreePath;
-    m_hasViewTag                = hasViewTag;
+    Payload &data = payload();
+
+    data.minerTxPrefix.assign(begin, end);
+    data.minerTxEphPubKeyOffset    = minerTxEphPubKeyOffset;
+    data.minerTxPubKeyOffset       = minerTxPubKeyOffset;
+    data.minerTxExtraNonceOffset   = minerTxExtraNonceOffset;
+    data.minerTxExtraNonceSize     = minerTxExtraNonceSize;
+    data.minerTxMerkleTreeBranch   = minerTxMerkleTreeBranch;
+    data.minerTxMerkleTreePath     = minerTxMerkleTreePath;
+    data.hasViewTag                = hasViewTag;
 }
 
 
 void xmrig::Job::setViewTagInMinerTx(uint8_t view_tag)
 {
-    memcpy(m_minerTxPrefix.data() + m_minerTxEphPubKeyOffset + 32, &view_tag, 1);
+    Payload &data = payload();
+
+    memcpy(data.minerTxPrefix.data() + data.minerTxEphPubKeyOffset + 32, &view_tag, 1);
 }
 
 
 void xmrig::Job::setExtraNonceInMinerTx(uint32_t extra_nonce)
 {
-    memcpy(m_minerTxPrefix.data() + m_minerTxExtraNonceOffset, &extra_nonce, std::min(m_minerTxExtraNonceSize, sizeof(uint32_t)));
+    Payload &data = payload();
+
+    memcpy(data.minerTxPrefix.data() + data.minerTxExtraNonceOffset, &extra_nonce, std::min(data.minerTxExtraNonceSize, sizeof(uint32_t)));
 }
 
 
-void xmrig::Job::generateSignatureData(String &signatureData, uint8_t& view_tag) const
+void xmrig::Job::generateSignatureData(String &signatureData, uint8_t& view_tag)
 {
-    uint8_t* eph_public_key = m_minerTxPrefix.data() + m_minerTxEphPubKeyOffset;
-    uint8_t* txkey_pub = m_minerTxPrefix.data() + m_minerTxPubKeyOffset;
+    Payload &data = payload();
+
+    uint8_t* eph_public_key = data.minerTxPrefix.data() + data.minerTxEphPubKeyOffset;
+    uint8_t* txkey_pub = data.minerTxPrefix.data() + data.minerTxPubKeyOffset;
 
     uint8_t txkey_sec[32];
 
@@ -387,24 +414,26 @@ void xmrig::Job::generateSignatureData(String &signatureData, uint8_t& view_tag)
 
     uint8_t derivation[32];
 
-    generate_key_derivation(m_viewPublicKey, txkey_sec, derivation, &view_tag);
-    derive_public_key(derivation, 0, m_spendPublicKey, eph_public_key);
+    generate_key_derivation(data.viewPublicKey, txkey_sec, derivation, &view_tag);
+    derive_public_key(derivation, 0, data.spendPublicKey, eph_public_key);
 
     uint8_t buf[32 * 3] = {};
     memcpy(buf, txkey_pub, 32);
     memcpy(buf + 32, eph_public_key, 32);
 
-    generate_key_derivation(txkey_pub, m_viewSecretKey, derivation, nullptr);
-    derive_secret_key(derivation, 0, m_spendSecretKey, buf + 64);
+    generate_key_derivation(txkey_pub, data.viewSecretKey, derivation, nullptr);
+    derive_secret_key(derivation, 0, data.spendSecretKey, buf + 64);
 
     signatureData = Cvt::toHex(buf, sizeof(buf));
 }
 
 void xmrig::Job::generateHashingBlob(String &blob) const
 {
+    const Payload &data = *m_payload;
+
     uint8_t root_hash[32];
-    const uint8_t* p = m_minerTxPrefix.data();
-    BlockTemplate::calculateRootHash(p, p + m_minerTxPrefix.size(), m_minerTxMerkleTreeBranch, m_minerTxMerkleTreePath, root_hash);
+    const uint8_t* p = data.minerTxPrefix.data();
+    BlockTemplate::calculateRootHash(p, p + data.minerTxPrefix.size(), data.minerTxMerkleTreeBranch, data.minerTxMerkleTreePath, root_hash);
 
     uint64_t root_hash_offset = nonceOffset() + nonceSize();
 
@@ -430,7 +459,7 @@ void xmrig::Job::generateMinerSignature(const uint8_t* blob, size_t size, uint8_
 
     uint8_t prefix_hash[32];
     xmrig::keccak(tmp, static_cast<int>(size), prefix_hash, sizeof(prefix_hash));
-    xmrig::generate_signature(prefix_hash, m_ephPublicKey, m_ephSecretKey, out_sig);
+    xmrig::generate_signature(prefix_hash, m_payload->ephPublicKey, m_payload->ephSecretKey, out_sig);
 }
 
 
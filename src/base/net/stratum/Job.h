@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 #include "base/crypto/Algorithm.h"
 #include "base/tools/Buffer.h"
@@ -38,6 +39,10 @@
 namespace xmrig {
 
 
+/**
+ * Mining job. Blobs, seed, keys and the miner transaction are an immutable payload shared by all copies of a job,
+ * so copying a job is cheap; the payload is copied only when one of the copies changes it (copy on write).
+ */
 class Job
 {
 public:
@@ -48,7 +53,7 @@ public:
     static constexpr const size_t kMaxBlobSize = 408;
     static constexpr const size_t kMaxSeedSize = 32;
 
-    Job() = default;
+    Job();
     Job(bool nicehash, const Algorithm &algorithm, const String &clientId);
 
     inline Job(const Job &other)        { copy(other); }
@@ -69,23 +74,23 @@ public:
     inline bool isValid() const                         { return (m_size > 0 && m_diff > 0) || !m_poolWallet.isEmpty(); }
     inline bool setId(const char *id)                   { return (m_id = id); }
     inline const Algorithm &algorithm() const           { return m_algorithm; }
-    inline const Buffer &seed() const                   { return m_seed; }
+    inline const Buffer &seed() const                   { return m_payload->seed; }
     inline const String &clientId() const               { return m_clientId; }
     inline const String &extraNonce() const             { return m_extraNonce; }
     inline const String &id() const                     { return m_id; }
     inline const String &poolWallet() const             { return m_poolWallet; }
-    inline const uint32_t *nonce() const                { return reinterpret_cast<const uint32_t*>(m_blob + nonceOffset()); }
-    inline const uint8_t *blob() const                  { return m_blob; }
+    inline const uint32_t *nonce() const                { return reinterpret_cast<const uint32_t*>(m_payload->blob + nonceOffset()); }
+    inline const uint8_t *blob() const                  { return m_payload->blob; }
     inline size_t nonceSize() const                     { return (algorithm().family() == Algorithm::KAWPOW) ?  8 :  4; }
     inline size_t size() const                          { return m_size; }
-    inline uint32_t *nonce()                            { return reinterpret_cast<uint32_t*>(m_blob + nonceOffset()); }
+    inline uint32_t *nonce()                            { return reinterpret_cast<uint32_t*>(payload().blob + nonceOffset()); }
     inline uint32_t backend() const                     { return m_backend; }
     inline uint64_t diff() const                        { return m_diff; }
     inline uint64_t height() const                      { return m_height; }
     inline uint64_t nonceMask() const                   { return isNicehash() ? 0xFFFFFFULL : (nonceSize() == sizeof(uint64_t) ? (static_cast<uint64_t>(-1LL) >> (extraNonce().size() * 4)) : 0xFFFFFFFFULL); }
     inline uint64_t target() const                      { return m_target; }
-    inline uint8_t *blob()                              { return m_blob; }
-    inline uint8_t fixedByte() const                    { return *(m_blob + 42); }
+    inline uint8_t *blob()                              { return payload().blob; }
+    inline uint8_t fixedByte() const                    { return *(m_payload->blob + 42); }
     inline uint8_t index() const                        { return m_index; }
     inline void reset()                                 { m_size = 0; m_diff = 0; }
     inline void setAlgorithm(const Algorithm::Id id)    { m_algorithm = id; }
@@ -98,11 +103,17 @@ public:
     inline void setPoolWallet(const String &poolWallet) { m_poolWallet = poolWallet; }
 
 #   ifdef XMRIG_PROXY_PROJECT
-    inline char *rawBlob()                              { return m_rawBlob; }
-    inline const char *rawBlob() const                  { return m_rawBlob; }
+    inline const char *rawBlob() const                  { return m_payload->rawBlob; }
+    inline double parsedAt() const                      { return m_parsedAt; }
+    inline double receivedAt() const                    { return m_receivedAt; }
     inline const char *rawTarget() const                { return m_rawTarget; }
-    inline const String &rawSeedHash() const            { return m_rawSeedHash; }
-    inline const String &rawSigKey() const              { return m_rawSigKey; }
+    inline const String &rawSeedHash() const            { return m_payload->rawSeedHash; }
+    inline const String &rawSigKey() const              { return m_payload->rawSigKey; }
+    inline uint16_t slots() const                       { return m_slots; }
+    inline void setSlots(uint16_t slots)                { m_slots = slots; }
+    inline void setTimestamps(double received, double parsed) { m_receivedAt = received; m_parsedAt = parsed; }
+
+    bool share(const Job &other);
 #   endif
 
     static inline uint64_t toDiff(uint64_t target)      { return target ? (0xFFFFFFFFFFFFFFFFULL / target) : 0; }
@@ -118,22 +129,22 @@ public:
 #   endif
 
 #   ifdef XMRIG_PROXY_PROJECT
-    inline bool hasViewTag() const                      { return m_hasViewTag; }
+    inline bool hasViewTag() const                      { return m_payload->hasViewTag; }
 
     void setSpendSecretKey(const uint8_t* key);
     void setMinerTx(const uint8_t* begin, const uint8_t* end, size_t minerTxEphPubKeyOffset, size_t minerTxPubKeyOffset, size_t minerTxExtraNonceOffset, size_t minerTxExtraNonceSize, const Buffer& minerTxMerkleTreeBranch, uint32_t minerTxMerkleTreePath, bool hasViewTag);
     void setViewTagInMinerTx(uint8_t view_tag);
     void setExtraNonceInMinerTx(uint32_t extra_nonce);
-    void generateSignatureData(String& signatureData, uint8_t& view_tag) const;
+    void generateSignatureData(String& signatureData, uint8_t& view_tag);
     void generateHashingBlob(String& blob) const;
 #   else
-    inline const uint8_t* ephSecretKey() const { return m_hasMinerSignature ? m_ephSecretKey : nullptr; }
+    inline const uint8_t* ephSecretKey() const { return m_hasMinerSignature ? m_payload->ephSecretKey : nullptr; }
 
     inline void setEphemeralKeys(const uint8_t *pub_key, const uint8_t *sec_key)
     {
         m_hasMinerSignature = true;
-        memcpy(m_ephPublicKey, pub_key, sizeof(m_ephSecretKey));
-        memcpy(m_ephSecretKey, sec_key, sizeof(m_ephSecretKey));
+        memcpy(payload().ephPublicKey, pub_key, sizeof(Payload::ephPublicKey));
+        memcpy(payload().ephSecretKey, sec_key, sizeof(Payload::ephSecretKey));
     }
 
     void generateMinerSignature(const uint8_t* blob, size_t size, uint8_t* out_sig) const;
@@ -144,13 +155,46 @@ public:
     uint32_t getNumTransactions() const;
 
 private:
+    struct Payload
+    {
+        Buffer seed;
+        uint8_t blob[kMaxBlobSize]{ 0 };
+
+#       ifdef XMRIG_PROXY_PROJECT
+        char rawBlob[kMaxBlobSize * 2 + 8]{};
+        String rawSeedHash;
+        String rawSigKey;
+
+        // Miner signatures
+        uint8_t spendSecretKey[32]{};
+        uint8_t viewSecretKey[32]{};
+        uint8_t spendPublicKey[32]{};
+        uint8_t viewPublicKey[32]{};
+        Buffer minerTxPrefix;
+        size_t minerTxEphPubKeyOffset = 0;
+        size_t minerTxPubKeyOffset = 0;
+        size_t minerTxExtraNonceOffset = 0;
+        size_t minerTxExtraNonceSize = 0;
+        Buffer minerTxMerkleTreeBranch;
+        uint32_t minerTxMerkleTreePath = 0;
+        bool hasViewTag = false;
+#       else
+        // Miner signatures
+        uint8_t ephPublicKey[32]{};
+        uint8_t ephSecretKey[32]{};
+#       endif
+    };
+
+    static const std::shared_ptr<Payload> &emptyPayload();
+
+    Payload &payload();
     void copy(const Job &other);
     void move(Job &&other);
 
     Algorithm m_algorithm;
     bool m_nicehash     = false;
-    Buffer m_seed;
     size_t m_size       = 0;
+    std::shared_ptr<Payload> m_payload;
     String m_clientId;
     String m_extraNonce;
     String m_id;
@@ -159,32 +203,13 @@ private:
     uint64_t m_diff     = 0;
     uint64_t m_height   = 0;
     uint64_t m_target   = 0;
-    uint8_t m_blob[kMaxBlobSize]{ 0 };
     uint8_t m_index     = 0;
 
 #   ifdef XMRIG_PROXY_PROJECT
-    char m_rawBlob[kMaxBlobSize * 2 + 8]{};
     char m_rawTarget[24]{};
-    String m_rawSeedHash;
-    String m_rawSigKey;
-
-    // Miner signatures
-    uint8_t m_spendSecretKey[32]{};
-    uint8_t m_viewSecretKey[32]{};
-    uint8_t m_spendPublicKey[32]{};
-    uint8_t m_viewPublicKey[32]{};
-    mutable Buffer m_minerTxPrefix;
-    size_t m_minerTxEphPubKeyOffset = 0;
-    size_t m_minerTxPubKeyOffset = 0;
-    size_t m_minerTxExtraNonceOffset = 0;
-    size_t m_minerTxExtraNonceSize = 0;
-    Buffer m_minerTxMerkleTreeBranch;
-    uint32_t m_minerTxMerkleTreePath = 0;
-    bool m_hasViewTag = false;
-#   else
-    // Miner signatures
-    uint8_t m_ephPublicKey[32]{};
-    uint8_t m_ephSecretKey[32]{};
+    double m_parsedAt   = 0.0;
+    double m_receivedAt = 0.0;
+    uint16_t m_slots    = 0;
 #   endif
 
     bool m_hasMinerSignature = false;
@@ -0,0 +1,239 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/MuxClient.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/JsonRequest.h"
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/net/stratum/MuxConnection.h"
+#include "base/tools/Chrono.h"
+
+
+#include <cstring>
+
+
+xmrig::MuxClient::MuxClient(int id, const char *agent, IClientListener *listener) :
+    Client(id, agent, listener)
+{
+}
+
+
+xmrig::MuxClient::~MuxClient()
+{
+    if (m_connection) {
+        m_connection->detach(m_mux);
+    }
+}
+
+
+void xmrig::MuxClient::onDisconnected(int failures)
+{
+    if (m_state == UnconnectedState) {
+        return;
+    }
+
+    m_state       = ReconnectingState;
+    m_failures    = failures;
+    m_keepAlive   = 0;
+    m_reconnectAt = 0;
+
+    if (m_listener) {
+        m_listener->onClose(this, failures);
+    }
+}
+
+
+void xmrig::MuxClient::onMessage(const rapidjson::Value &doc, double receivedAt)
+{
+    if (m_state == ConnectedState && m_listener) {
+        setReceivedAt(receivedAt);
+        parseMessage(doc);
+    }
+}
+
+
+void xmrig::MuxClient::onReady()
+{
+    if (!m_listener) {
+        return;
+    }
+
+    m_ip          = m_connection->ip();
+    m_state       = ConnectedState;
+    m_keepAlive   = Chrono::steadyMSecs() + keepAlive();
+    m_reconnectAt = 0;
+
+    setRpcId(nullptr);
+    login();
+}
+
+
+bool xmrig::MuxClient::close()
+{
+    if (m_state != ConnectedState) {
+        return false;
+    }
+
+    logout();
+
+    // Session level failure (login rejected, invalid job), the shared connection stays open.
+    m_state       = ReconnectingState;
+    m_keepAlive   = 0;
+    m_reconnectAt = Chrono::steadyMSecs() + m_retryPause;
+
+    if (m_listener) {
+        m_listener->onClose(this, static_cast<int>(++m_failures));
+    }
+
+    return false;
+}
+
+
+bool xmrig::MuxClient::disconnect()
+{
+    m_failures    = -1;
+    m_keepAlive   = 0;
+    m_reconnectAt = 0;
+
+    if (m_connection) {
+        if (m_state == ConnectedState) {
+            logout();
+        }
+
+        m_connection->detach(m_mux);
+        m_connection = nullptr;
+    }
+
+    m_state = UnconnectedState;
+
+    return false;
+}
+
+
+bool xmrig::MuxClient::isTLS() const
+{
+    return m_connection && m_connection->isTLS();
+}
+
+
+const char *xmrig::MuxClient::tlsFingerprint() const
+{
+    return m_connection ? m_connection->tlsFingerprint() : nullptr;
+}
+
+
+const char *xmrig::MuxClient::tlsVersion() const
+{
+    return m_connection ? m_connection->tlsVersion() : nullptr;
+}
+
+
+int64_t xmrig::MuxClient::send(const rapidjson::Value &obj)
+{
+    if (!m_connection) {
+        return -1;
+    }
+
+    return m_connection->send(m_mux, obj);
+}
+
+
+void xmrig::MuxClient::connect()
+{
+    if (!m_connection) {
+        m_connection = MuxConnection::attach(m_pool, m_retryPause, this, &m_mux);
+    }
+
+    if (m_failures == -1) {
+        m_failures = 0;
+    }
+
+    m_state       = ConnectingState;
+    m_reconnectAt = 0;
+
+    if (m_connection->isReady()) {
+        return onReady();
+    }
+
+    m_connection->open();
+}
+
+
+void xmrig::MuxClient::parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &error)
+{
+    if (strcmp(method, "logout") == 0) {
+        close();
+
+        return;
+    }
+
+    Client::parseNotification(method, params, error);
+}
+
+
+void xmrig::MuxClient::tick(uint64_t now)
+{
+    if (!m_connection) {
+        return;
+    }
+
+    m_connection->tick(now);
+
+    if (m_state == ReconnectingState && m_reconnectAt && now > m_reconnectAt && m_connection->isReady()) {
+        return onReady();
+    }
+
+    if (m_state == ConnectedState && m_keepAlive && now > m_keepAlive && !rpcId().isNull()) {
+        ping();
+    }
+}
+
+
+void xmrig::MuxClient::logout()
+{
+    using namespace rapidjson;
+
+    if (rpcId().isNull()) {
+        return;
+    }
+
+    Document doc(kObjectType);
+    Value params(kObjectType);
+    params.AddMember("id", rpcId().toJSON(), doc.GetAllocator());
+
+    JsonRequest::create(doc, m_sequence, "logout", params);
+
+    send(doc);
+}
+
+
+void xmrig::MuxClient::ping()
+{
+    using namespace rapidjson;
+
+    m_keepAlive = Chrono::steadyMSecs() + keepAlive();
+
+    Document doc(kObjectType);
+    Value params(kObjectType);
+    params.AddMember("id", rpcId().toJSON(), doc.GetAllocator());
+
+    JsonRequest::create(doc, m_sequence, "keepalived", params);
+
+    send(doc);
+}
@@ -0,0 +1,80 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_MUXCLIENT_H
+#define XMRIG_MUXCLIENT_H
+
+
+#include "base/net/stratum/Client.h"
+
+
+namespace xmrig {
+
+
+class MuxConnection;
+
+
+/**
+ * Logical stratum session carried over a connection shared with other sessions to the same pool.
+ *
+ * Protocol handling (login, jobs, submits) is inherited from Client, only the transport is replaced:
+ * every outgoing message is tagged with the session "mux" id and incoming messages are routed back
+ * by MuxConnection. See doc/STRATUM_EXT.md for the protocol extension.
+ */
+class MuxClient : public Client
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(MuxClient)
+
+    MuxClient(int id, const char *agent, IClientListener *listener);
+    ~MuxClient() override;
+
+    void onDisconnected(int failures);
+    void onMessage(const rapidjson::Value &doc, double receivedAt);
+    void onReady();
+
+protected:
+    inline const char *mode() const override { return "mux"; }
+
+    bool close() override;
+    bool disconnect() override;
+    bool isTLS() const override;
+    const char *tlsFingerprint() const override;
+    const char *tlsVersion() const override;
+    int64_t send(const rapidjson::Value &obj) override;
+    void connect() override;
+    void parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &error) override;
+    void tick(uint64_t now) override;
+
+private:
+    inline uint64_t keepAlive() const { return static_cast<uint64_t>(m_pool.keepAlive() > 0 ? m_pool.keepAlive() : Pool::kKeepAliveTimeout) * 1000; }
+
+    void logout();
+    void ping();
+
+    MuxConnection *m_connection = nullptr;
+    uint32_t m_mux              = 0;
+    uint64_t m_keepAlive        = 0;
+    uint64_t m_reconnectAt      = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_MUXCLIENT_H */
@@ -0,0 +1,188 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/MuxConnection.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "base/kernel/Platform.h"
+#include "base/net/stratum/MuxClient.h"
+
+
+namespace xmrig {
+
+
+std::map<std::string, MuxConnection *> MuxConnection::m_connections;
+
+
+static std::string connectionKey(const Pool &pool)
+{
+    std::string key = pool.url().data();
+
+    if (pool.isTLS()) {
+        key += "#tls";
+    }
+
+    if (pool.proxy().isValid()) {
+        key += "#" + std::string(pool.proxy().host().data()) + ":" + std::to_string(pool.proxy().port());
+    }
+
+    return key;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::MuxConnection::MuxConnection(const Pool &pool) :
+    Client(0, Platform::userAgent(), this)
+{
+    setPool(pool);
+}
+
+
+xmrig::MuxConnection *xmrig::MuxConnection::attach(const Pool &pool, uint64_t retryPause, MuxClient *client, uint32_t *mux)
+{
+    auto &connection = m_connections[connectionKey(pool)];
+    if (!connection) {
+        connection = new MuxConnection(pool);
+    }
+
+    connection->setRetryPause(retryPause);
+
+    *mux = connection->m_nextMux++;
+    connection->m_sessions[*mux] = client;
+
+    return connection;
+}
+
+
+int64_t xmrig::MuxConnection::send(uint32_t mux, const rapidjson::Value &obj)
+{
+    using namespace rapidjson;
+
+    if (!m_ready) {
+        return -1;
+    }
+
+    Document doc(kObjectType);
+    doc.CopyFrom(obj, doc.GetAllocator());
+    doc.AddMember("mux", mux, doc.GetAllocator());
+
+    return Client::send(doc);
+}
+
+
+void xmrig::MuxConnection::detach(uint32_t mux)
+{
+    m_sessions.erase(mux);
+
+    if (m_sessions.empty()) {
+        m_ready = false;
+        disconnect();
+    }
+}
+
+
+void xmrig::MuxConnection::open()
+{
+    if (m_state == UnconnectedState || (m_state == ReconnectingState && m_failures == -1)) {
+        connect();
+    }
+}
+
+
+void xmrig::MuxConnection::tick(uint64_t now)
+{
+    // Every attached session forwards its tick, the connection itself is ticked once.
+    if (now == m_ticked) {
+        return;
+    }
+
+    m_ticked = now;
+    Client::tick(now);
+}
+
+
+void xmrig::MuxConnection::login()
+{
+    if (m_sessions.empty()) {
+        disconnect();
+
+        return;
+    }
+
+    m_failures = 0;
+    m_ready    = true;
+
+    for (const uint32_t mux : sessions()) {
+        auto it = m_sessions.find(mux);
+        if (it != m_sessions.end()) {
+            it->second->onReady();
+        }
+    }
+}
+
+
+void xmrig::MuxConnection::parseMessage(const rapidjson::Value &doc)
+{
+    const auto &mux = Json::getValue(doc, "mux");
+    if (!mux.IsUint()) {
+        return Client::parseMessage(doc);
+    }
+
+    auto it = m_sessions.find(mux.GetUint());
+    if (it != m_sessions.end()) {
+        it->second->onMessage(doc, receivedAt());
+    }
+}
+
+
+void xmrig::MuxConnection::onClose(IClient *, int failures)
+{
+    m_ready = false;
+
+    if (failures == -1) {
+        if (!m_sessions.empty()) {
+            connect();
+        }
+
+        return;
+    }
+
+    for (const uint32_t mux : sessions()) {
+        auto it = m_sessions.find(mux);
+        if (it != m_sessions.end()) {
+            it->second->onDisconnected(failures);
+        }
+    }
+}
+
+
+std::vector<uint32_t> xmrig::MuxConnection::sessions() const
+{
+    // Sessions may detach from inside their callbacks, so iterate over a copy of the ids.
+    std::vector<uint32_t> out;
+    out.reserve(m_sessions.size());
+
+    for (const auto &kv : m_sessions) {
+        out.push_back(kv.first);
+    }
+
+    return out;
+}
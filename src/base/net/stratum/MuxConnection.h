@@ -0,0 +1,93 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_MUXCONNECTION_H
+#define XMRIG_MUXCONNECTION_H
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/net/stratum/Client.h"
+
+
+namespace xmrig {
+
+
+class MuxClient;
+
+
+/**
+ * Physical pool connection shared by all MuxClient sessions with the same pool URL.
+ *
+ * The connection itself never logs in, it only carries tagged messages of the attached sessions.
+ * Connections are kept in a process-wide registry and are never freed while the registry exists,
+ * an idle connection is just closed until a session attaches to it again.
+ */
+class MuxConnection : public Client, public IClientListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(MuxConnection)
+
+    using Client::ip;
+    using Client::isTLS;
+    using Client::tlsFingerprint;
+    using Client::tlsVersion;
+
+    MuxConnection(const Pool &pool);
+    ~MuxConnection() override = default;
+
+    static MuxConnection *attach(const Pool &pool, uint64_t retryPause, MuxClient *client, uint32_t *mux);
+
+    inline bool isReady() const     { return m_ready; }
+
+    int64_t send(uint32_t mux, const rapidjson::Value &obj);
+    void detach(uint32_t mux);
+    void open();
+    void tick(uint64_t now) override;
+
+protected:
+    void login() override;
+    void parseMessage(const rapidjson::Value &doc) override;
+
+    void onClose(IClient *client, int failures) override;
+    inline void onJobReceived(IClient *, const Job &, const rapidjson::Value &) override               {}
+    inline void onLogin(IClient *, rapidjson::Document &, rapidjson::Value &) override                 {}
+    inline void onLoginSuccess(IClient *) override                                                      {}
+    inline void onResultAccepted(IClient *, const SubmitResult &, const char *) override                {}
+    inline void onVerifyAlgorithm(const IClient *, const Algorithm &, bool *) override                  {}
+
+private:
+    std::vector<uint32_t> sessions() const;
+
+    bool m_ready        = false;
+    std::map<uint32_t, MuxClient *> m_sessions;
+    uint32_t m_nextMux  = 0;
+    uint64_t m_ticked   = 0;
+
+    static std::map<std::string, MuxConnection *> m_connections;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_MUXCONNECTION_H */
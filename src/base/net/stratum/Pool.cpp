@@ -30,6 +30,7 @@
 #include "base/io/log/Log.h"
 #include "base/kernel/Platform.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/stratum/MuxClient.h"
 
 #if defined XMRIG_ALGO_KAWPOW || defined XMRIG_ALGO_GHOSTRIDER
 #   include "base/net/stratum/AutoClient.h"
@@ -62,6 +63,7 @@ const String Pool::kDefaultUser           = "x";
 
 
 const char *Pool::kAlgo                   = "algo";
+const char *Pool::kCascade                = "cascade";
 const char *Pool::kCoin                   = "coin";
 const char *Pool::kDaemon                 = "daemon";
 const char *Pool::kDaemonPollInterval     = "daemon-poll-interval";
@@ -70,6 +72,7 @@ const char *Pool::kDaemonZMQPort          = "daemon-zmq-port";
 const char *Pool::kEnabled                = "enabled";
 const char *Pool::kFingerprint            = "tls-fingerprint";
 const char *Pool::kKeepalive              = "keepalive";
+const char *Pool::kMux                    = "mux";
 const char *Pool::kNicehash               = "nicehash";
 const char *Pool::kPass                   = "pass";
 const char *Pool::kRigId                  = "rig-id";
@@ -139,7 +142,9 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_flags.set(FLAG_NICEHASH, Json::getBool(object, kNicehash) || m_url.host().contains(kNicehashHost));
     m_flags.set(FLAG_TLS,      Json::getBool(object, kTls) || m_url.isTLS());
     m_flags.set(FLAG_SNI,      Json::getBool(object, kSni));
+    m_flags.set(FLAG_MUX,      Json::getBool(object, kMux));
 
+    setCascade(Json::getValue(object, kCascade));
     setKeepAlive(Json::getValue(object, kKeepalive));
 
     if (m_daemon.isValid()) {
@@ -204,6 +209,7 @@ bool xmrig::Pool::isEnabled() const
 bool xmrig::Pool::isEqual(const Pool &other) const
 {
     return (m_flags           == other.m_flags
+            && m_cascade      == other.m_cascade
             && m_keepAlive    == other.m_keepAlive
             && m_algorithm    == other.m_algorithm
             && m_coin         == other.m_coin
@@ -233,7 +239,10 @@ xmrig::IClient *xmrig::Pool::createClient(int id, IClientListener *listener) con
         }
         else
 #       endif
-        {
+        if (isMux()) {
+            client = new MuxClient(id, Platform::userAgent(), listener);
+        }
+        else {
             client = new Client(id, Platform::userAgent(), listener);
         }
     }
@@ -297,11 +306,21 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
         else {
             obj.AddMember(StringRef(kKeepalive), m_keepAlive, allocator);
         }
+
+#       ifdef XMRIG_PROXY_PROJECT
+        if (m_cascade == 0 || m_cascade == kCascadeSlots) {
+            obj.AddMember(StringRef(kCascade), m_cascade > 0, allocator);
+        }
+        else {
+            obj.AddMember(StringRef(kCascade), m_cascade, allocator);
+        }
+#       endif
     }
 
     obj.AddMember(StringRef(kEnabled),      m_flags.test(FLAG_ENABLED), allocator);
     obj.AddMember(StringRef(kTls),          isTLS(), allocator);
     obj.AddMember(StringRef(kSni),          isSNI(), allocator);
+    obj.AddMember(StringRef(kMux),          isMux(), allocator);
     obj.AddMember(StringRef(kFingerprint),  m_fingerprint.toJSON(), allocator);
     obj.AddMember(StringRef(kDaemon),       m_mode == MODE_DAEMON, allocator);
     obj.AddMember(StringRef(kSOCKS5),       m_proxy.toJSON(doc), allocator);
@@ -358,6 +377,17 @@ void xmrig::Pool::print() const
 #endif
 
 
+void xmrig::Pool::setCascade(const rapidjson::Value &value)
+{
+    if (value.IsInt()) {
+        setCascade(value.GetInt());
+    }
+    else if (value.IsBool()) {
+        setCascade(value.GetBool());
+    }
+}
+
+
 void xmrig::Pool::setKeepAlive(const rapidjson::Value &value)
 {
     if (value.IsInt()) {
@@ -21,6 +21,7 @@
 #define XMRIG_POOL_H
 
 
+#include <algorithm>
 #include <bitset>
 #include <vector>
 #include <memory>
@@ -56,6 +57,7 @@ public:
     static const String kDefaultUser;
 
     static const char *kAlgo;
+    static const char *kCascade;
     static const char *kCoin;
     static const char *kDaemon;
     static const char *kDaemonPollInterval;
@@ -63,6 +65,7 @@ public:
     static const char *kEnabled;
     static const char *kFingerprint;
     static const char *kKeepalive;
+    static const char *kMux;
     static const char *kNicehash;
     static const char *kPass;
     static const char *kRigId;
@@ -77,6 +80,7 @@ public:
     static const char *kDaemonZMQPort;
     static const char *kNicehashHost;
 
+    constexpr static int kCascadeSlots             = 256;
     constexpr static int kKeepAliveTimeout         = 60;
     constexpr static uint16_t kDefaultPort         = 3333;
     constexpr static uint64_t kDefaultPollInterval = 1000;
@@ -94,6 +98,7 @@ public:
     uint32_t benchSize() const;
 #   endif
 
+    inline bool isMux() const                           { return m_flags.test(FLAG_MUX); }
     inline bool isNicehash() const                      { return m_flags.test(FLAG_NICEHASH); }
     inline bool isTLS() const                           { return m_flags.test(FLAG_TLS) || m_url.isTLS(); }
     inline bool isSNI() const                           { return m_flags.test(FLAG_SNI); }
@@ -109,6 +114,7 @@ public:
     inline const String &user() const                   { return !m_user.isNull() ? m_user : kDefaultUser; }
     inline const String &spendSecretKey() const         { return m_spendSecretKey; }
     inline const Url &daemon() const                    { return m_daemon; }
+    inline int cascade() const                          { return m_cascade; }
     inline int keepAlive() const                        { return m_keepAlive; }
     inline Mode mode() const                            { return m_mode; }
     inline uint16_t port() const                        { return m_url.port(); }
@@ -141,17 +147,23 @@ private:
         FLAG_NICEHASH,
         FLAG_TLS,
         FLAG_SNI,
+        FLAG_MUX,
         FLAG_MAX
     };
 
     inline void setKeepAlive(bool enable)               { setKeepAlive(enable ? kKeepAliveTimeout : 0); }
     inline void setKeepAlive(int keepAlive)             { m_keepAlive = keepAlive >= 0 ? keepAlive : 0; }
 
+    inline void setCascade(bool enable)                 { setCascade(enable ? kCascadeSlots : 0); }
+    inline void setCascade(int slots)                   { m_cascade = std::min(std::max(slots, 0), static_cast<int>(kCascadeSlots)); }
+
+    void setCascade(const rapidjson::Value &value);
     void setKeepAlive(const rapidjson::Value &value);
 
     Algorithm m_algorithm;
     bool m_submitToOrigin           = false;
     Coin m_coin;
+    int m_cascade                   = 0;
     int m_keepAlive                 = 0;
     Mode m_mode                     = MODE_POOL;
     ProxyUrl m_proxy;
@@ -26,12 +26,18 @@
 #include "base/net/stratum/Pools.h"
 #include "3rdparty/rapidjson/document.h"
 #include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
+#include "base/net/stratum/strategies/LatencyStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
 #include "donate.h"
 
 
+#include <array>
+#include <cstring>
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "base/net/stratum/benchmark/BenchConfig.h"
 #endif
@@ -45,6 +51,10 @@ const char *Pools::kDonateOverProxy = "donate-over-proxy";
 const char *Pools::kPools           = "pools";
 const char *Pools::kRetries         = "retries";
 const char *Pools::kRetryPause      = "retry-pause";
+const char *Pools::kStrategy        = "pool-strategy";
+
+
+static const std::array<const char *, 2> strategyNames = { "failover", "latency" };
 
 
 } // namespace xmrig
@@ -62,7 +72,7 @@ xmrig::Pools::Pools() :
 
 bool xmrig::Pools::isEqual(const Pools &other) const
 {
-    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause) {
+    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause || m_strategy != other.m_strategy) {
         return false;
     }
 
@@ -90,6 +100,17 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
         }
     }
 
+    if (m_strategy == STRATEGY_LATENCY) {
+        auto strategy = new LatencyStrategy(retryPause(), retries(), listener);
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled()) {
+                strategy->add(pool);
+            }
+        }
+
+        return strategy;
+    }
+
     auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
     for (const Pool &pool : m_data) {
         if (pool.isEnabled()) {
@@ -101,6 +122,12 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
 }
 
 
+const char *xmrig::Pools::strategyName() const
+{
+    return strategyNames[m_strategy];
+}
+
+
 rapidjson::Value xmrig::Pools::toJSON(rapidjson::Document &doc) const
 {
     using namespace rapidjson;
@@ -162,6 +189,7 @@ void xmrig::Pools::load(const IJsonReader &reader)
     setProxyDonate(reader.getInt(kDonateOverProxy, PROXY_DONATE_AUTO));
     setRetries(reader.getInt(kRetries));
     setRetryPause(reader.getInt(kRetryPause));
+    setStrategy(reader.getString(kStrategy));
 }
 
 
@@ -212,6 +240,7 @@ void xmrig::Pools::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
     out.AddMember(StringRef(kPools),            toJSON(doc), allocator);
     doc.AddMember(StringRef(kRetries),          retries(), allocator);
     doc.AddMember(StringRef(kRetryPause),       retryPause(), allocator);
+    doc.AddMember(StringRef(kStrategy),         StringRef(strategyName()), allocator);
 }
 
 
@@ -251,3 +280,23 @@ void xmrig::Pools::setRetryPause(int retryPause)
         m_retryPause = retryPause;
     }
 }
+
+
+void xmrig::Pools::setStrategy(const char *strategy)
+{
+    if (strategy == nullptr) {
+        m_strategy = STRATEGY_FAILOVER;
+        return;
+    }
+
+    for (size_t i = 0; i < strategyNames.size(); i++) {
+        if (strcmp(strategy, strategyNames[i]) == 0) {
+            m_strategy = static_cast<Strategy>(i);
+            return;
+        }
+    }
+
+    m_strategy = STRATEGY_FAILOVER;
+
+    LOG_WARN("%s " YELLOW("unknown \"%s\" value \"%s\", \"%s\" is used"), Tags::config(), kStrategy, strategy, strategyNames[m_strategy]);
+}
@@ -48,6 +48,7 @@ public:
     static const char *kPools;
     static const char *kRetries;
     static const char *kRetryPause;
+    static const char *kStrategy;
 
     enum ProxyDonate {
         PROXY_DONATE_NONE,
@@ -55,6 +56,11 @@ public:
         PROXY_DONATE_ALWAYS
     };
 
+    enum Strategy {
+        STRATEGY_FAILOVER,
+        STRATEGY_LATENCY
+    };
+
     Pools();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -67,12 +73,14 @@ public:
     inline int retries() const                          { return m_retries; }
     inline int retryPause() const                       { return m_retryPause; }
     inline ProxyDonate proxyDonate() const              { return m_proxyDonate; }
+    inline Strategy strategy() const                    { return m_strategy; }
 
     inline bool operator!=(const Pools &other) const    { return !isEqual(other); }
     inline bool operator==(const Pools &other) const    { return isEqual(other); }
 
     bool isEqual(const Pools &other) const;
     int donateLevel() const;
+    const char *strategyName() const;
     IStrategy *createStrategy(IStrategyListener *listener) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t active() const;
@@ -86,11 +94,13 @@ private:
     void setProxyDonate(int value);
     void setRetries(int retries);
     void setRetryPause(int retryPause);
+    void setStrategy(const char *strategy);
 
     int m_donateLevel;
     int m_retries               = 5;
     int m_retryPause            = 5;
     ProxyDonate m_proxyDonate   = PROXY_DONATE_AUTO;
+    Strategy m_strategy         = STRATEGY_FAILOVER;
     std::vector<Pool> m_data;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
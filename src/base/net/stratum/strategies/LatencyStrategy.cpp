@@ -0,0 +1,365 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/strategies/LatencyStrategy.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+
+namespace xmrig {
+
+
+class PoolLatency
+{
+public:
+    constexpr static double kAlpha = 0.2;
+
+    inline bool isFailed(uint64_t now) const    { return m_failedAt && now - m_failedAt < LatencyStrategy::kFailurePenalty; }
+    inline bool isKnown() const                 { return m_share > 0.0 || m_connect > 0.0; }
+    inline double score() const                 { return m_share > 0.0 ? m_share : m_connect; }
+    inline void addConnect(uint64_t ms)         { update(m_connect, ms); m_failedAt = 0; }
+    inline void addShare(uint64_t ms)           { update(m_share, ms); }
+    inline void setFailed(uint64_t now)         { m_failedAt = now; }
+
+    bool isBetter(const PoolLatency &other) const
+    {
+        if (m_share > 0.0 && other.m_share > 0.0) {
+            return isBetter(m_share, other.m_share);
+        }
+
+        if (m_connect > 0.0 && other.m_connect > 0.0) {
+            return isBetter(m_connect, other.m_connect);
+        }
+
+        return false;
+    }
+
+private:
+    static inline bool isBetter(double value, double other)
+    {
+        return other > value * LatencyStrategy::kMigrateRatio && other - value >= LatencyStrategy::kMigrateMinDelta;
+    }
+
+    static inline void update(double &value, uint64_t ms)
+    {
+        value = value > 0.0 ? value + kAlpha * (static_cast<double>(ms) - value) : static_cast<double>(ms);
+    }
+
+    double m_connect    = 0.0;
+    double m_share      = 0.0;
+    uint64_t m_failedAt = 0;
+};
+
+
+static std::map<std::string, PoolLatency> latencies;
+static uint64_t lastMigration = 0;
+
+
+static inline PoolLatency &latency(const IClient *client) { return latencies[client->pool().url().data()]; }
+
+
+/**
+ * Samples are shared by all upstreams and survive a config reload, pools that are no longer configured are dropped.
+ */
+static void prune(const std::vector<IClient *> &pools)
+{
+    for (auto it = latencies.begin(); it != latencies.end();) {
+        const bool found = std::any_of(pools.begin(), pools.end(), [&it](const IClient *client) { return client->pool().url() == it->first.c_str(); });
+
+        it = found ? std::next(it) : latencies.erase(it);
+    }
+}
+
+
+} // namespace xmrig
+
+
+xmrig::LatencyStrategy::LatencyStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+    m_quiet(quiet),
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::LatencyStrategy::~LatencyStrategy()
+{
+    for (IClient *client : m_pools) {
+        client->deleteLater();
+    }
+}
+
+
+void xmrig::LatencyStrategy::add(const Pool &pool)
+{
+    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+
+    client->setRetries(m_retries);
+    client->setRetryPause(m_retryPause * 1000);
+    client->setQuiet(m_quiet);
+
+    m_pools.push_back(client);
+    m_connectTs.push_back(0);
+}
+
+
+int64_t xmrig::LatencyStrategy::submit(const JobResult &result)
+{
+    if (!isActive()) {
+        return -1;
+    }
+
+    return active()->submit(result);
+}
+
+
+void xmrig::LatencyStrategy::connect()
+{
+    prune(m_pools);
+
+    const int index = best(-1, Chrono::steadyMSecs());
+    if (index >= 0) {
+        connect(index);
+    }
+}
+
+
+void xmrig::LatencyStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(this, active(), active()->job(), rapidjson::Value(rapidjson::kNullType));
+}
+
+
+void xmrig::LatencyStrategy::setAlgo(const Algorithm &algo)
+{
+    for (IClient *client : m_pools) {
+        client->setAlgo(algo);
+    }
+}
+
+
+void xmrig::LatencyStrategy::setProxy(const ProxyUrl &proxy)
+{
+    for (IClient *client : m_pools) {
+        client->setProxy(proxy);
+    }
+}
+
+
+void xmrig::LatencyStrategy::stop()
+{
+    for (auto &pool : m_pools) {
+        pool->disconnect();
+    }
+
+    m_active  = -1;
+    m_pending = -1;
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::LatencyStrategy::tick(uint64_t now)
+{
+    for (IClient *client : m_pools) {
+        client->tick(now);
+    }
+
+    if (m_nextCheck == 0) {
+        m_nextCheck = now + kCheckInterval + static_cast<uint64_t>(rand()) % kCheckInterval; // NOLINT(concurrency-mt-unsafe, cert-msc30-c, cert-msc50-cpp)
+    }
+
+    if (!isActive() || m_pending >= 0 || now < m_nextCheck) {
+        return;
+    }
+
+    m_nextCheck = now + kCheckInterval;
+
+    const int index = best(m_active, now);
+    if (index < 0 || now - lastMigration < kMigrateSpacing) {
+        return;
+    }
+
+    const auto &candidate = latency(m_pools[index]);
+    if (candidate.isFailed(now)) {
+        return;
+    }
+
+    // Unknown pools are probed: the connection is kept only if login was fast enough, see onLoginSuccess().
+    if (!candidate.isKnown() || candidate.isBetter(latency(active()))) {
+        lastMigration = now;
+
+        connect(index);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onClose(IClient *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    const int id       = client->id();
+    const uint64_t now = Chrono::steadyMSecs();
+
+    if (m_active == id) {
+        m_active  = -1;
+        m_pending = id;
+        m_listener->onPause(this);
+    }
+
+    if (m_pending != id) {
+        return;
+    }
+
+    if (isActive()) {
+        latency(client).setFailed(now);
+        m_pending = -1;
+        client->disconnect();
+
+        return;
+    }
+
+    if (failures < m_retries) {
+        return;
+    }
+
+    latency(client).setFailed(now);
+
+    const int index = best(id, now);
+    if (index >= 0) {
+        client->disconnect();
+        connect(index);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::LatencyStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)
+{
+    if (m_active == client->id()) {
+        m_listener->onJob(this, client, job, params);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onLoginSuccess(IClient *client)
+{
+    const int id = client->id();
+    auto &ts     = m_connectTs[static_cast<size_t>(id)];
+
+    if (ts) {
+        latency(client).addConnect(Chrono::steadyMSecs() - ts);
+        ts = 0;
+    }
+
+    if (isActive()) {
+        if (id == m_pending && !latency(client).isBetter(latency(active()))) {
+            m_pending = -1;
+        }
+
+        if (id != m_pending) {
+            if (id != m_active) {
+                client->disconnect();
+            }
+
+            return;
+        }
+    }
+
+    m_active  = id;
+    m_pending = -1;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (static_cast<int>(i) != id) {
+            m_pools[i]->disconnect();
+        }
+    }
+
+    m_listener->onActive(this, client);
+}
+
+
+void xmrig::LatencyStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    latency(client).addShare(result.elapsed);
+
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::LatencyStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
+
+
+int xmrig::LatencyStrategy::best(int exclude, uint64_t now) const
+{
+    int index   = -1;
+    bool failed = true;
+    double score = 0.0;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (static_cast<int>(i) == exclude) {
+            continue;
+        }
+
+        const auto &value     = latency(m_pools[i]);
+        const bool isFailed   = value.isFailed(now);
+        const double current  = value.score();
+
+        if (index == -1 || (failed && !isFailed) || (failed == isFailed && current < score)) {
+            index  = static_cast<int>(i);
+            failed = isFailed;
+            score  = current;
+        }
+    }
+
+    return index;
+}
+
+
+void xmrig::LatencyStrategy::connect(int index)
+{
+    m_pending = index;
+    m_connectTs[static_cast<size_t>(index)] = Chrono::steadyMSecs();
+
+    m_pools[static_cast<size_t>(index)]->connect();
+}
@@ -0,0 +1,102 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_LATENCYSTRATEGY_H
+#define XMRIG_LATENCYSTRATEGY_H
+
+
+#include <vector>
+
+
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Pool.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class IStrategyListener;
+
+
+/**
+ * Routes each new upstream to the pool with the lowest measured latency.
+ *
+ * Connect (TCP + TLS + login) time and share response time are tracked per pool URL
+ * as exponentially weighted moving averages shared by all instances, so every new
+ * mapper benefits from measurements made by the others. An active upstream is moved
+ * to a faster pool only if the difference is significant, and no more than one
+ * upstream per kMigrateSpacing is moved process-wide.
+ */
+class LatencyStrategy : public IStrategy, public IClientListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(LatencyStrategy)
+
+    constexpr static uint64_t kCheckInterval    = 30 * 1000;
+    constexpr static uint64_t kFailurePenalty   = 120 * 1000;
+    constexpr static uint64_t kMigrateSpacing   = 1000;
+    constexpr static uint64_t kMigrateMinDelta  = 10;
+    constexpr static double kMigrateRatio       = 1.25;
+
+    LatencyStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet = false);
+    ~LatencyStrategy() override;
+
+    void add(const Pool &pool);
+
+protected:
+    inline bool isActive() const override           { return m_active >= 0; }
+    inline IClient *client() const override         { return isActive() ? active() : m_pools[m_pending >= 0 ? m_pending : 0]; }
+
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void resume() override;
+    void setAlgo(const Algorithm &algo) override;
+    void setProxy(const ProxyUrl &proxy) override;
+    void stop() override;
+    void tick(uint64_t now) override;
+
+    void onClose(IClient *client, int failures) override;
+    void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params) override;
+    void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *client) override;
+    void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
+    void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
+
+private:
+    inline IClient *active() const { return m_pools[static_cast<size_t>(m_active)]; }
+
+    int best(int exclude, uint64_t now) const;
+    void connect(int index);
+
+    const bool m_quiet;
+    const int m_retries;
+    const int m_retryPause;
+    int m_active            = -1;
+    int m_pending           = -1;
+    IStrategyListener *m_listener;
+    std::vector<IClient*> m_pools;
+    std::vector<uint64_t> m_connectTs;
+    uint64_t m_nextCheck    = 0;
+};
+
+
+} /* namespace xmrig */
+
+#endif /* XMRIG_LATENCYSTRATEGY_H */
@@ -16,16 +16,391 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-
 #include "base/net/tls/ServerTls.h"
+#include "base/net/tls/TlsContext.h"
 
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
 #include <cstring>
+#include <deque>
+#include <openssl/bio.h>
 #include <openssl/ssl.h>
 
 
+#if defined(__linux__) && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#   include <linux/tls.h>
+#   include <netinet/in.h>
+#   include <netinet/tcp.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#   define XMRIG_TLS_KTLS
+
+#   ifndef SOL_TLS
+#       define SOL_TLS 282
+#   endif
+
+#   ifndef TCP_ULP
+#       define TCP_ULP 31
+#   endif
+
+// OpenSSL internal BIO controls (include/internal/bio.h), used only when the BIO reports kTLS support.
+#   ifndef BIO_CTRL_SET_KTLS_SEND
+#       define BIO_CTRL_SET_KTLS_SEND           72
+#   endif
+
+#   ifndef BIO_CTRL_SET_KTLS_SEND_CTRL_MSG
+#       define BIO_CTRL_SET_KTLS_SEND_CTRL_MSG  74
+#   endif
+
+#   ifndef BIO_CTRL_CLEAR_KTLS_CTRL_MSG
+#       define BIO_CTRL_CLEAR_KTLS_CTRL_MSG     75
+#   endif
+#endif
+
+
+namespace xmrig {
+
+
+#ifdef XMRIG_TLS_KTLS
+static size_t ktlsInfoSize(const tls_crypto_info *info)
+{
+    switch (info->cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+        return sizeof(tls12_crypto_info_aes_gcm_128);
+
+#   ifdef TLS_CIPHER_AES_GCM_256
+    case TLS_CIPHER_AES_GCM_256:
+        return sizeof(tls12_crypto_info_aes_gcm_256);
+#   endif
+
+#   ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+        return sizeof(tls12_crypto_info_chacha20_poly1305);
+#   endif
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+/**
+ * State of the custom BIO, owned by the BIO itself because the SSL object can outlive ServerTls
+ * (handshake still running on the pool). The handshake thread only touches in/output, tls is set once
+ * the handshake is complete and all further output goes directly to ServerTls::write().
+ *
+ * With kTLS the BIO accepts the transmit key from OpenSSL and installs it on the socket (fd), after that
+ * OpenSSL writes plaintext and the kernel builds the records. Receive stays in userspace: bytes past the
+ * client Finished message may already be in our read buffer.
+ *
+ * Records with a control type (handshake, alert) can't go through the libuv write queue. They are written
+ * to the socket directly only while that queue is empty. Otherwise, and when the socket is full, they are
+ * held together with all following output. The held output is sent in order by drain() on the next read or
+ * send, after the queue empties.
+ */
+struct xmrig::ServerTls::Bio
+{
+    static BIO_METHOD *method();
+    static int onCreate(BIO *bio);
+    static int onDestroy(BIO *bio);
+    static int onRead(BIO *bio, char *data, int size);
+    static int onWrite(BIO *bio, const char *data, int size);
+    static long onCtrl(BIO *bio, int cmd, long num, void *ptr);
+
+    struct Record
+    {
+        int type;
+        std::string data;
+    };
+
+    constexpr static size_t kMaxHeld = 1024 * 1024;
+
+    bool drain();
+    bool flush();
+    int send(int type, const char *data, size_t size);
+    int write(const char *data, size_t size);
+    long setKtls(const void *info);
+
+    bool ktls           = false;
+    const char *in      = nullptr;
+    int fd              = -1;
+    int recordType      = 0;
+    ServerTls *tls      = nullptr;
+    size_t held         = 0;
+    size_t size         = 0;
+    std::deque<Record> records;
+    std::string output;
+    std::string pending;
+};
+
+
+/**
+ * Shared by the main loop and the HTTP thread, the method is created once by the thread-safe static initializer.
+ */
+BIO_METHOD *xmrig::ServerTls::Bio::method()
+{
+    static BIO_METHOD *method = [] {
+        BIO_METHOD *method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "xmrig");
+
+        BIO_meth_set_create(method, onCreate);
+        BIO_meth_set_destroy(method, onDestroy);
+        BIO_meth_set_read(method, onRead);
+        BIO_meth_set_write(method, onWrite);
+        BIO_meth_set_ctrl(method, onCtrl);
+
+        return method;
+    }();
+
+    return method;
+}
+
+
+int xmrig::ServerTls::Bio::onCreate(BIO *bio)
+{
+    BIO_set_data(bio, new Bio());
+    BIO_set_init(bio, 1);
+
+    return 1;
+}
+
+
+int xmrig::ServerTls::Bio::onDestroy(BIO *bio)
+{
+    auto state = static_cast<Bio *>(BIO_get_data(bio));
+
+#   ifdef XMRIG_TLS_KTLS
+    if (state->fd >= 0) {
+        close(state->fd);
+    }
+#   endif
+
+    delete state;
+    BIO_set_data(bio, nullptr);
+
+    return 1;
+}
+
+
+int xmrig::ServerTls::Bio::onRead(BIO *bio, char *data, int size)
+{
+    auto state = static_cast<Bio *>(BIO_get_data(bio));
+
+    BIO_clear_retry_flags(bio);
+
+    if (state->size == 0) {
+        BIO_set_retry_read(bio);
+
+        return -1;
+    }
+
+    const size_t bytes = std::min(state->size, static_cast<size_t>(size));
+    memcpy(data, state->in, bytes);
+
+    state->in   += bytes;
+    state->size -= bytes;
+
+    return static_cast<int>(bytes);
+}
+
+
+int xmrig::ServerTls::Bio::onWrite(BIO *bio, const char *data, int size)
+{
+    auto state = static_cast<Bio *>(BIO_get_data(bio));
+
+    BIO_clear_retry_flags(bio);
+
+    // Handshake and alert messages after the key was handed to the kernel, sent with their record type.
+    if (state->ktls && (state->recordType || !state->tls || !state->records.empty())) {
+        return state->write(data, static_cast<size_t>(size));
+    }
+
+    if (!state->tls) {
+        state->output.append(data, static_cast<size_t>(size));
+
+        return size;
+    }
+
+    return state->tls->write(data, static_cast<size_t>(size)) ? size : -1;
+}
+
+
+long xmrig::ServerTls::Bio::onCtrl(BIO *bio, int cmd, long num, void *ptr)
+{
+    auto state = static_cast<Bio *>(BIO_get_data(bio));
+
+    switch (cmd) {
+    case BIO_CTRL_FLUSH:
+        return state->flush() ? 1 : 0;
+
+#   ifdef XMRIG_TLS_KTLS
+    case BIO_CTRL_GET_KTLS_SEND:
+        return state->ktls ? 1 : 0;
+
+    case BIO_CTRL_SET_KTLS_SEND:
+        return num ? state->setKtls(ptr) : 0;
+
+    case BIO_CTRL_SET_KTLS_SEND_CTRL_MSG:
+        state->recordType = static_cast<int>(num);
+        return 1;
+
+    case BIO_CTRL_CLEAR_KTLS_CTRL_MSG:
+        state->recordType = 0;
+        return 1;
+#   endif
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+
+/**
+ * Only a kTLS capable connection writes to the socket from here, OpenSSL flushes the handshake messages
+ * encrypted in userspace before it installs the kernel key, an incomplete flush falls back to userspace TLS.
+ */
+bool xmrig::ServerTls::Bio::flush()
+{
+    if (fd < 0 || output.empty()) {
+        return true;
+    }
+
+    const int rc = send(0, output.data(), output.size());
+    if (rc > 0) {
+        output.erase(0, static_cast<size_t>(rc));
+    }
+
+    return output.empty();
+}
+
+
+/**
+ * Sends held output once the libuv write queue is empty, returns false on a socket error.
+ */
+bool xmrig::ServerTls::Bio::drain()
+{
+#   ifdef XMRIG_TLS_KTLS
+    if (records.empty() || (tls && tls->isWriteQueued())) {
+        return true;
+    }
+
+    while (!records.empty()) {
+        Record &record = records.front();
+        const int rc   = send(record.type, record.data.data(), record.data.size());
+
+        if (rc < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        held -= static_cast<size_t>(rc);
+
+        if (static_cast<size_t>(rc) < record.data.size()) {
+            record.data.erase(0, static_cast<size_t>(rc));
+
+            return true;
+        }
+
+        records.pop_front();
+    }
+#   endif
+
+    return true;
+}
+
+
+int xmrig::ServerTls::Bio::send(int type, const char *data, size_t size)
+{
+#   ifdef XMRIG_TLS_KTLS
+    iovec iov{ const_cast<char *>(data), size };
+
+    msghdr msg{};
+    msg.msg_iov    = &iov;
+    msg.msg_iovlen = 1;
+
+    char control[CMSG_SPACE(sizeof(uint8_t))]{};
+
+    if (type) {
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        cmsghdr *cmsg   = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_TLS;
+        cmsg->cmsg_type  = TLS_SET_RECORD_TYPE;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(uint8_t));
+        *CMSG_DATA(cmsg) = static_cast<uint8_t>(type);
+    }
+
+    return static_cast<int>(sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT));
+#   else
+    return -1;
+#   endif
+}
+
+
+int xmrig::ServerTls::Bio::write(const char *data, size_t size)
+{
+#   ifdef XMRIG_TLS_KTLS
+    const int type = recordType;
+    size_t offset  = 0;
+    recordType     = 0;
+
+    if (records.empty() && !(tls && tls->isWriteQueued())) {
+        const int rc = send(type, data, size);
+        if (rc < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        offset = rc > 0 ? static_cast<size_t>(rc) : 0;
+        if (offset == size) {
+            return static_cast<int>(size);
+        }
+    }
+
+    if (held + size - offset > kMaxHeld) {
+        return -1;
+    }
+
+    records.push_back({ type, std::string(data + offset, size - offset) });
+    held += size - offset;
+
+    return static_cast<int>(size);
+#   else
+    return -1;
+#   endif
+}
+
+
+long xmrig::ServerTls::Bio::setKtls(const void *info)
+{
+#   ifdef XMRIG_TLS_KTLS
+    const size_t infoSize = ktlsInfoSize(static_cast<const tls_crypto_info *>(info));
+    if (fd < 0 || infoSize == 0 || !output.empty()) {
+        return 0;
+    }
+
+    // Fails without the tls kernel module, OpenSSL keeps encrypting in userspace.
+    if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) < 0 || setsockopt(fd, SOL_TLS, TLS_TX, info, static_cast<socklen_t>(infoSize)) < 0) {
+        return 0;
+    }
+
+    ktls = true;
+
+    return 1;
+#   else
+    return 0;
+#   endif
+}
+
+
 xmrig::ServerTls::ServerTls(SSL_CTX *ctx) :
     m_ctx(ctx)
 {
@@ -34,7 +409,28 @@ xmrig::ServerTls::ServerTls(SSL_CTX *ctx) :
 
 xmrig::ServerTls::~ServerTls()
 {
+#   ifdef XMRIG_TLS_KTLS
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#   endif
+
+    // The handshake thread still uses the SSL object, the job frees it on completion.
+    if (m_job) {
+        m_job->owner = nullptr;
+
+        return;
+    }
+
     if (m_ssl) {
+        m_bio->tls = nullptr;
+
+        // Miners usually just drop the TCP connection, without this OpenSSL treats the session as bad and evicts it from the cache.
+        if (m_ready) {
+            SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+            TlsContext::onClose(m_ssl);
+        }
+
         SSL_free(m_ssl);
     }
 }
@@ -60,11 +456,62 @@ bool xmrig::ServerTls::isTLS(const char *data, size_t size)
 }
 
 
+void xmrig::ServerTls::onHandshake(TlsHandshakePool::Job *job)
+{
+    ServerTls *tls = job->owner;
+    if (!tls) {
+        return release(job);
+    }
+
+    tls->m_job     = nullptr;
+    const int rc    = job->rc;
+    const int error = job->error;
+
+    delete job;
+
+    tls->onHandshake(rc, error);
+}
+
+
+void xmrig::ServerTls::release(TlsHandshakePool::Job *job)
+{
+    if (job->owner) {
+        job->owner->m_job = nullptr;
+    }
+    else {
+        SSL_free(job->ssl);
+    }
+
+    delete job;
+}
+
+
+void xmrig::ServerTls::setSocket(int fd)
+{
+#   ifdef XMRIG_TLS_KTLS
+    // A private descriptor, the handshake thread may still use it after the connection is closed.
+    if (m_fd < 0 && (SSL_CTX_get_options(m_ctx) & SSL_OP_ENABLE_KTLS)) {
+        m_fd = dup(fd);
+    }
+#   else
+    (void) fd;
+#   endif
+}
+
+
 bool xmrig::ServerTls::send(const char *data, size_t size)
 {
-    SSL_write(m_ssl, data, size);
+    if (!m_ready) {
+        return false;
+    }
+
+    if (!m_bio->drain()) {
+        shutdown();
 
-    return write(m_write);
+        return false;
+    }
+
+    return SSL_write(m_ssl, data, static_cast<int>(size)) > 0;
 }
 
 
@@ -73,44 +520,124 @@ void xmrig::ServerTls::read(const char *data, size_t size)
     if (!m_ssl) {
         m_ssl = SSL_new(m_ctx);
 
-        m_write = BIO_new(BIO_s_mem());
-        m_read  = BIO_new(BIO_s_mem());
+        BIO *bio = BIO_new(Bio::method());
+        m_bio    = static_cast<Bio *>(BIO_get_data(bio));
+        m_bio->fd = m_fd;
+        m_fd      = -1;
 
         SSL_set_accept_state(m_ssl);
-        SSL_set_bio(m_ssl, m_read, m_write);
+        SSL_set_bio(m_ssl, bio, bio);
     }
 
+    if (m_job) {
+        m_input.append(data, size);
+
+        return;
+    }
 
-    BIO_write(m_read, data, size);
+    m_bio->in   = data;
+    m_bio->size = size;
 
     if (!SSL_is_init_finished(m_ssl)) {
+        return handshake();
+    }
+
+    if (!m_bio->drain()) {
+        return shutdown();
+    }
+
+    read();
+}
+
+
+void xmrig::ServerTls::flush()
+{
+    if (!m_bio->output.empty()) {
+        write(m_bio->output.data(), m_bio->output.size());
+        m_bio->output.clear();
+    }
+}
+
+
+void xmrig::ServerTls::handshake()
+{
+    TlsHandshakePool *pool = TlsContext::pool(m_ctx);
+    if (!pool) {
         const int rc = SSL_do_handshake(m_ssl);
 
-        if (rc < 0 && SSL_get_error(m_ssl, rc) == SSL_ERROR_WANT_READ) {
-            write(m_write);
-        } else if (rc == 1) {
-            write(m_write);
+        return onHandshake(rc, rc == 1 ? SSL_ERROR_NONE : SSL_get_error(m_ssl, rc));
+    }
 
-            m_ready = true;
-            read();
+    // The caller's buffer is gone by the time the job runs.
+    m_bio->pending.assign(m_bio->in, m_bio->size);
+    m_bio->in = m_bio->pending.data();
+
+    m_job        = new TlsHandshakePool::Job();
+    m_job->owner = this;
+    m_job->ssl   = m_ssl;
+
+    pool->submit(m_job);
+}
+
+
+void xmrig::ServerTls::onHandshake(int rc, int error)
+{
+    if (rc < 0 && error == SSL_ERROR_WANT_READ) {
+        flush();
+
+        // More of the client flight arrived while the handshake was running.
+        if (!m_input.empty()) {
+            std::string input;
+            input.swap(m_input);
+
+            m_bio->in   = input.data();
+            m_bio->size = input.size();
+
+            handshake();
         }
-        else {
-            shutdown();
+    } else if (rc == 1) {
+        TlsContext::onHandshake(m_ssl);
+        flush();
+
+        m_ready    = true;
+        m_bio->tls = this;
+
+        if (!m_bio->drain()) {
+            return shutdown();
         }
 
-      return;
-    }
+        // Application data sent together with the client Finished message.
+        read();
 
-    read();
+        if (!m_input.empty()) {
+            std::string input;
+            input.swap(m_input);
+
+            m_bio->in   = input.data();
+            m_bio->size = input.size();
+
+            read();
+        }
+
+        m_bio->pending.clear();
+        m_bio->pending.shrink_to_fit();
+    }
+    else {
+        shutdown();
+    }
 }
 
 
 void xmrig::ServerTls::read()
 {
-    static char buf[16384]{};
+    // Miners and the HTTPS API read on different threads.
+    static thread_local char buf[16384]{};
 
     int bytes_read = 0;
     while ((bytes_read = SSL_read(m_ssl, buf, sizeof(buf))) > 0) {
         parse(buf, bytes_read);
     }
+
+    m_bio->in   = nullptr;
+    m_bio->size = 0;
 }
@@ -21,18 +21,28 @@
 #define XMRIG_SERVERTLS_H
 
 
-using BIO       = struct bio_st;
 using SSL       = struct ssl_st;
 using SSL_CTX   = struct ssl_ctx_st;
 
 
 
+#include "base/net/tls/TlsHandshakePool.h"
 #include "base/tools/Object.h"
 
 
+#include <string>
+
+
 namespace xmrig {
 
 
+/**
+ * Server side of a TLS connection.
+ *
+ * The SSL object is connected to a custom BIO: ciphertext is read straight from the caller's buffer and
+ * written straight to write(), without intermediate memory BIOs. Only handshake steps that run on the
+ * handshake pool copy their input, it must outlive the caller's buffer.
+ */
 class ServerTls
 {
 public:
@@ -43,23 +53,35 @@ public:
 
     static bool isHTTP(const char *data, size_t size);
     static bool isTLS(const char *data, size_t size);
+    static void onHandshake(TlsHandshakePool::Job *job);
+    static void release(TlsHandshakePool::Job *job);
 
     bool send(const char *data, size_t size);
     void read(const char *data, size_t size);
+    void setSocket(int fd);
 
 protected:
-    virtual bool write(BIO *bio)                = 0;
-    virtual void parse(char *data, size_t size) = 0;
-    virtual void shutdown()                     = 0;
+    inline virtual bool isWriteQueued() const         { return false; }
+
+    virtual bool write(const char *data, size_t size) = 0;
+    virtual void parse(char *data, size_t size)       = 0;
+    virtual void shutdown()                           = 0;
 
 private:
+    struct Bio;
+
+    void flush();
+    void handshake();
+    void onHandshake(int rc, int error);
     void read();
 
-    BIO *m_read     = nullptr;
-    BIO *m_write    = nullptr;
+    Bio *m_bio      = nullptr;
     bool m_ready    = false;
+    int m_fd        = -1;
     SSL *m_ssl      = nullptr;
     SSL_CTX *m_ctx;
+    std::string m_input;
+    TlsHandshakePool::Job *m_job = nullptr;
 };
 
 
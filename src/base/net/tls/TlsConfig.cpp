@@ -34,7 +34,14 @@ const char *TlsConfig::kCiphers         = "ciphers";
 const char *TlsConfig::kCipherSuites    = "ciphersuites";
 const char *TlsConfig::kDhparam         = "dhparam";
 const char *TlsConfig::kGen             = "gen";
+const char *TlsConfig::kHandshakeThreads = "handshake_threads";
+const char *TlsConfig::kKtls            = "ktls";
 const char *TlsConfig::kProtocols       = "protocols";
+const char *TlsConfig::kSessionCache    = "session_cache";
+const char *TlsConfig::kSessionTimeout  = "session_timeout";
+const char *TlsConfig::kTicketKeyFile   = "ticket_key_file";
+const char *TlsConfig::kTicketKeyRotation = "ticket_key_rotation";
+const char *TlsConfig::kTickets         = "tickets";
 
 static const char *kTLSv1               = "TLSv1";
 static const char *kTLSv1_1             = "TLSv1.1";
@@ -51,6 +58,13 @@ static const char *kTLSv1_3             = "TLSv1.3";
  * "ciphers"      set list of available ciphers (TLSv1.2 and below).
  * "ciphersuites" set list of available TLSv1.3 ciphersuites.
  * "dhparam"      load DH parameters for DHE ciphers from file.
+ * "session_cache"       maximum number of sessions in the server side session cache, 0 disables the cache.
+ * "session_timeout"     session (and ticket) lifetime in seconds.
+ * "tickets"             enable stateless session tickets.
+ * "ticket_key_file"     load ticket keys from file (80 bytes per key, the first key encrypts), shared by several proxies.
+ * "ticket_key_rotation" generate a new ticket key, or reload "ticket_key_file", every N seconds.
+ * "handshake_threads"   number of threads for TLS handshakes, 0 means one per CPU, -1 runs handshakes on the main loop.
+ * "ktls"                offload record encryption of established miner connections to the Linux kernel (kTLS).
  */
 xmrig::TlsConfig::TlsConfig(const rapidjson::Value &value)
 {
@@ -64,6 +78,14 @@ xmrig::TlsConfig::TlsConfig(const rapidjson::Value &value)
         setCipherSuites(Json::getString(value, kCipherSuites));
         setDH(Json::getString(value, kDhparam));
 
+        m_sessionCache      = Json::getUint(value, kSessionCache, m_sessionCache);
+        m_sessionTimeout    = Json::getUint(value, kSessionTimeout, m_sessionTimeout);
+        m_tickets           = Json::getBool(value, kTickets, m_tickets);
+        m_ticketKeyFile     = Json::getString(value, kTicketKeyFile);
+        m_ticketKeyRotation = Json::getUint(value, kTicketKeyRotation, m_ticketKeyRotation);
+        m_handshakeThreads  = Json::getInt(value, kHandshakeThreads, m_handshakeThreads);
+        m_ktls              = Json::getBool(value, kKtls, m_ktls);
+
         if (m_key.isNull()) {
             setKey(Json::getString(value, "cert-key"));
         }
@@ -153,6 +175,13 @@ rapidjson::Value xmrig::TlsConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kCiphers),      m_ciphers.toJSON(), allocator);
     obj.AddMember(StringRef(kCipherSuites), m_cipherSuites.toJSON(), allocator);
     obj.AddMember(StringRef(kDhparam),      m_dhparam.toJSON(), allocator);
+    obj.AddMember(StringRef(kSessionCache), m_sessionCache, allocator);
+    obj.AddMember(StringRef(kSessionTimeout), m_sessionTimeout, allocator);
+    obj.AddMember(StringRef(kTickets),      m_tickets, allocator);
+    obj.AddMember(StringRef(kTicketKeyFile), m_ticketKeyFile.toJSON(), allocator);
+    obj.AddMember(StringRef(kTicketKeyRotation), m_ticketKeyRotation, allocator);
+    obj.AddMember(StringRef(kHandshakeThreads), m_handshakeThreads, allocator);
+    obj.AddMember(StringRef(kKtls),         m_ktls, allocator);
 
     return obj;
 }
@@ -38,7 +38,14 @@ public:
     static const char *kDhparam;
     static const char *kEnabled;
     static const char *kGen;
+    static const char *kHandshakeThreads;
+    static const char *kKtls;
     static const char *kProtocols;
+    static const char *kSessionCache;
+    static const char *kSessionTimeout;
+    static const char *kTicketKeyFile;
+    static const char *kTicketKeyRotation;
+    static const char *kTickets;
 
     enum Versions {
         TLSv1   = 1,
@@ -51,13 +58,20 @@ public:
     TlsConfig(const rapidjson::Value &value);
 
     inline bool isEnabled() const                    { return m_enabled && isValid(); }
+    inline bool isKtls() const                       { return m_ktls; }
+    inline bool isTickets() const                    { return m_tickets; }
     inline bool isValid() const                      { return !m_cert.isEmpty() && !m_key.isEmpty(); }
     inline const char *cert() const                  { return m_cert.data(); }
     inline const char *ciphers() const               { return m_ciphers.isEmpty() ? nullptr : m_ciphers.data(); }
     inline const char *cipherSuites() const          { return m_cipherSuites.isEmpty() ? nullptr : m_cipherSuites.data(); }
     inline const char *dhparam() const               { return m_dhparam.isEmpty() ? nullptr : m_dhparam.data(); }
     inline const char *key() const                   { return m_key.data(); }
+    inline const char *ticketKeyFile() const         { return m_ticketKeyFile.isEmpty() ? nullptr : m_ticketKeyFile.data(); }
+    inline int handshakeThreads() const              { return m_handshakeThreads; }
     inline uint32_t protocols() const                { return m_protocols; }
+    inline uint32_t sessionCache() const             { return m_sessionCache; }
+    inline uint32_t sessionTimeout() const           { return m_sessionTimeout; }
+    inline uint32_t ticketKeyRotation() const        { return m_ticketKeyRotation; }
     inline void setCert(const char *cert)            { m_cert = cert; }
     inline void setCiphers(const char *ciphers)      { m_ciphers = ciphers; }
     inline void setCipherSuites(const char *ciphers) { m_cipherSuites = ciphers; }
@@ -72,12 +86,19 @@ public:
 
 private:
     bool m_enabled       = true;
+    bool m_ktls          = false;
+    bool m_tickets       = true;
+    int m_handshakeThreads = 0;
     uint32_t m_protocols = 0;
+    uint32_t m_sessionCache      = 20480;
+    uint32_t m_sessionTimeout    = 7200;
+    uint32_t m_ticketKeyRotation = 3600;
     String m_cert;
     String m_ciphers;
     String m_cipherSuites;
     String m_dhparam;
     String m_key;
+    String m_ticketKeyFile;
 };
 
 
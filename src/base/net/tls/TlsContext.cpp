@@ -18,13 +18,34 @@
  */
 
 #include "base/net/tls/TlsContext.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/io/Env.h"
 #include "base/io/log/Log.h"
 #include "base/net/tls/TlsConfig.h"
+#include "base/net/tls/TlsHandshakePool.h"
+#include "base/tools/Chrono.h"
 
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+#   include <openssl/core_names.h>
+#   define XMRIG_TLS_TICKET_EVP
+#endif
+
+
+#if defined(__linux__) && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#   define XMRIG_TLS_KTLS
+#endif
 
 
 // https://wiki.openssl.org/index.php/OpenSSL_1.1.0_Changes#Compatibility_Layer
@@ -105,6 +126,13 @@ static DH *get_dh2048()
 
 xmrig::TlsContext::~TlsContext()
 {
+    delete m_pool;
+
+    // Connections may still hold a reference to the SSL_CTX, callbacks must not see a dangling pointer.
+    if (m_ctx) {
+        SSL_CTX_set_app_data(m_ctx, nullptr);
+    }
+
     SSL_CTX_free(m_ctx);
 }
 
@@ -158,7 +186,256 @@ bool xmrig::TlsContext::load(const TlsConfig &config)
 
     setProtocols(config.protocols());
 
-    return setCiphers(config.ciphers()) && setCipherSuites(config.cipherSuites()) && setDH(config.dhparam());
+    if (config.isKtls()) {
+#       ifdef XMRIG_TLS_KTLS
+        SSL_CTX_set_options(m_ctx, SSL_OP_ENABLE_KTLS);
+        m_ktls = true;
+#       else
+        LOG_WARN("kTLS is not supported by this build, option \"ktls\" ignored");
+#       endif
+    }
+
+    m_handshakeThreads = config.handshakeThreads();
+    if (m_handshakeThreads == 0) {
+        m_handshakeThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+    }
+
+    return setCiphers(config.ciphers()) && setCipherSuites(config.cipherSuites()) && setDH(config.dhparam()) && setSessions(config);
+}
+
+
+xmrig::TlsHandshakePool *xmrig::TlsContext::pool(SSL_CTX *ctx)
+{
+    auto tls = static_cast<TlsContext *>(SSL_CTX_get_app_data(ctx));
+    if (!tls || tls->m_handshakeThreads <= 0) {
+        return nullptr;
+    }
+
+    if (!tls->m_pool) {
+        tls->m_pool = new TlsHandshakePool(static_cast<uint32_t>(tls->m_handshakeThreads));
+    }
+
+    return tls->m_pool;
+}
+
+
+/**
+ * Called for connections that completed the handshake, keeps the number of open kTLS connections.
+ */
+void xmrig::TlsContext::onClose(SSL *ssl)
+{
+#   ifdef XMRIG_TLS_KTLS
+    auto tls = static_cast<TlsContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    if (tls && BIO_get_ktls_send(SSL_get_wbio(ssl))) {
+        --tls->m_ktlsConnections;
+    }
+#   else
+    (void) ssl;
+#   endif
+}
+
+
+void xmrig::TlsContext::onHandshake(SSL *ssl)
+{
+    auto tls = static_cast<TlsContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    if (!tls) {
+        return;
+    }
+
+    ++tls->m_handshakes;
+
+    if (SSL_session_reused(ssl)) {
+        ++tls->m_resumed;
+    }
+
+#   ifdef XMRIG_TLS_KTLS
+    if (BIO_get_ktls_send(SSL_get_wbio(ssl))) {
+        ++tls->m_ktlsConnections;
+    }
+#   endif
+}
+
+
+rapidjson::Value xmrig::TlsContext::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    auto &allocator         = doc.GetAllocator();
+    const uint64_t total    = m_handshakes;
+    const uint64_t resumed  = m_resumed;
+
+    Value obj(kObjectType);
+    obj.AddMember("handshakes",     total, allocator);
+    obj.AddMember("resumed",        resumed, allocator);
+    obj.AddMember("resumed_rate",   total ? static_cast<double>(resumed) / static_cast<double>(total) : 0.0, allocator);
+
+    Value cache(kObjectType);
+    cache.AddMember("size",         static_cast<uint64_t>(SSL_CTX_sess_number(m_ctx)), allocator);
+    cache.AddMember("limit",        m_sessionCache, allocator);
+    cache.AddMember("hits",         static_cast<uint64_t>(SSL_CTX_sess_hits(m_ctx)), allocator);
+    cache.AddMember("misses",       static_cast<uint64_t>(SSL_CTX_sess_misses(m_ctx)), allocator);
+    cache.AddMember("timeouts",     static_cast<uint64_t>(SSL_CTX_sess_timeouts(m_ctx)), allocator);
+    cache.AddMember("full",         static_cast<uint64_t>(SSL_CTX_sess_cache_full(m_ctx)), allocator);
+    obj.AddMember("session_cache",  cache, allocator);
+
+    Value tickets(kObjectType);
+    tickets.AddMember("enabled",    m_tickets, allocator);
+    tickets.AddMember("renewed",    m_ticketRenewed.load(), allocator);
+    tickets.AddMember("unknown_key", m_ticketUnknown.load(), allocator);
+    obj.AddMember("tickets",        tickets, allocator);
+
+    Value ktls(kObjectType);
+    ktls.AddMember("enabled",       m_ktls, allocator);
+    ktls.AddMember("connections",   m_ktlsConnections.load(), allocator);
+    obj.AddMember("ktls",           ktls, allocator);
+
+    return obj;
+}
+
+
+bool xmrig::TlsContext::findKey(const uint8_t *name, TicketKey &key, bool &current)
+{
+    std::lock_guard<std::mutex> lock(m_keysMutex);
+
+    for (size_t i = 0; i < m_keys.size(); ++i) {
+        if (memcmp(m_keys[i].name, name, sizeof(key.name)) == 0) {
+            key     = m_keys[i];
+            current = i == 0;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool xmrig::TlsContext::loadKeys()
+{
+    FILE *fp = fopen(Env::expand(m_keyFile.data()), "rb");
+    if (!fp) {
+        LOG_ERR("failed to open TLS ticket key file \"%s\".", m_keyFile.data());
+
+        return false;
+    }
+
+    std::vector<TicketKey> keys;
+    TicketKey key{};
+    size_t size = 0;
+
+    while ((size = fread(&key, 1, sizeof(key), fp)) == sizeof(key)) {
+        keys.emplace_back(key);
+    }
+
+    fclose(fp);
+
+    if (keys.empty() || size != 0) {
+        LOG_ERR("invalid TLS ticket key file \"%s\", expected a multiple of %zu bytes.", m_keyFile.data(), sizeof(TicketKey));
+
+        return false;
+    }
+
+    m_keys = std::move(keys);
+
+    return true;
+}
+
+
+bool xmrig::TlsContext::setSessions(const TlsConfig &config)
+{
+    static const unsigned char sid[] = "xmrig";
+
+    SSL_CTX_set_app_data(m_ctx, this);
+    SSL_CTX_set_session_id_context(m_ctx, sid, sizeof(sid) - 1);
+    SSL_CTX_set_timeout(m_ctx, config.sessionTimeout());
+
+    m_sessionCache = config.sessionCache();
+    if (m_sessionCache) {
+        SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(m_ctx, m_sessionCache);
+    }
+    else {
+        SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_OFF);
+    }
+
+#   if OPENSSL_VERSION_NUMBER >= 0x1010100fL && !defined(LIBRESSL_VERSION_NUMBER)
+    // Miners reconnect to the same proxy, one TLSv1.3 ticket is enough and saves an encryption per handshake.
+    SSL_CTX_set_num_tickets(m_ctx, 1);
+#   endif
+
+    if (!config.isTickets()) {
+        SSL_CTX_set_options(m_ctx, SSL_OP_NO_TICKET);
+
+        return true;
+    }
+
+    m_tickets  = true;
+    m_keyFile  = config.ticketKeyFile();
+    m_rotation = config.ticketKeyRotation() * 1000ULL;
+
+    {
+        std::lock_guard<std::mutex> lock(m_keysMutex);
+        rotateKeys();
+
+        if (m_keys.empty()) {
+            return false;
+        }
+    }
+
+#   ifdef XMRIG_TLS_TICKET_EVP
+    SSL_CTX_set_tlsext_ticket_key_evp_cb(m_ctx, [](SSL *ssl, unsigned char *name, unsigned char *iv, EVP_CIPHER_CTX *ctx, EVP_MAC_CTX *hctx, int enc) {
+        return onTicketKey(ssl, name, iv, ctx, hctx, enc);
+    });
+#   else
+    using Callback = int (*)(SSL *, unsigned char *, unsigned char *, EVP_CIPHER_CTX *, HMAC_CTX *, int);
+    Callback callback = [](SSL *ssl, unsigned char *name, unsigned char *iv, EVP_CIPHER_CTX *ctx, HMAC_CTX *hctx, int enc) {
+        return onTicketKey(ssl, name, iv, ctx, hctx, enc);
+    };
+
+    SSL_CTX_set_tlsext_ticket_key_cb(m_ctx, callback);
+#   endif
+
+    return true;
+}
+
+
+xmrig::TlsContext::TicketKey xmrig::TlsContext::currentKey()
+{
+    std::lock_guard<std::mutex> lock(m_keysMutex);
+
+    if (Chrono::steadyMSecs() >= m_rotateAt) {
+        rotateKeys();
+    }
+
+    return m_keys.front();
+}
+
+
+void xmrig::TlsContext::rotateKeys()
+{
+    m_rotateAt = m_rotation ? Chrono::steadyMSecs() + m_rotation : UINT64_MAX;
+
+    // A file shared by several proxies is the only source of keys, a failed reload keeps the previous keys.
+    if (!m_keyFile.isNull()) {
+        loadKeys();
+
+        return;
+    }
+
+    TicketKey key{};
+    if (RAND_bytes(reinterpret_cast<uint8_t *>(&key), sizeof(key)) != 1) {
+        return;
+    }
+
+    // Keep previous keys long enough to decrypt tickets issued up to one session lifetime ago.
+    const uint64_t timeout = static_cast<uint64_t>(SSL_CTX_get_timeout(m_ctx)) * 1000;
+    const size_t keep      = m_rotation ? static_cast<size_t>(1 + (timeout + m_rotation - 1) / m_rotation) : 1;
+
+    m_keys.insert(m_keys.begin(), key);
+
+    if (m_keys.size() > keep) {
+        m_keys.resize(keep);
+    }
 }
 
 
@@ -262,6 +539,64 @@ bool xmrig::TlsContext::setDH(const char *dhparam)
 }
 
 
+int xmrig::TlsContext::onTicketKey(SSL *ssl, uint8_t *name, uint8_t *iv, void *cipherCtx, void *hmacCtx, int enc)
+{
+    auto tls = static_cast<TlsContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    if (!tls) {
+        return 0;
+    }
+
+    TicketKey key{};
+    bool current = true;
+
+    if (enc == 1) {
+        key = tls->currentKey();
+
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1) {
+            return -1;
+        }
+
+        memcpy(name, key.name, sizeof(key.name));
+    }
+    else if (!tls->findKey(name, key, current)) {
+        ++tls->m_ticketUnknown;
+
+        return 0;
+    }
+
+    auto ctx     = static_cast<EVP_CIPHER_CTX *>(cipherCtx);
+    const int rc = enc == 1 ? EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key.aes, iv) : EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key.aes, iv);
+    if (rc != 1) {
+        return -1;
+    }
+
+#   ifdef XMRIG_TLS_TICKET_EVP
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac, sizeof(key.hmac)),
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char *>("sha256"), 0),
+        OSSL_PARAM_construct_end()
+    };
+
+    if (EVP_MAC_CTX_set_params(static_cast<EVP_MAC_CTX *>(hmacCtx), params) != 1) {
+        return -1;
+    }
+#   else
+    if (HMAC_Init_ex(static_cast<HMAC_CTX *>(hmacCtx), key.hmac, sizeof(key.hmac), EVP_sha256(), nullptr) != 1) {
+        return -1;
+    }
+#   endif
+
+    // Ticket encrypted with an older key is accepted, the client gets a fresh one.
+    if (!current) {
+        ++tls->m_ticketRenewed;
+
+        return 2;
+    }
+
+    return 1;
+}
+
+
 void xmrig::TlsContext::setProtocols(uint32_t protocols)
 {
     if (protocols == 0) {
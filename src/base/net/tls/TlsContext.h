@@ -21,9 +21,18 @@
 #define XMRIG_TLSCONTEXT_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
 #include "base/tools/Object.h"
+#include "base/tools/String.h"
 
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+using SSL     = struct ssl_st;
 using SSL_CTX = struct ssl_ctx_st;
 
 
@@ -31,6 +40,7 @@ namespace xmrig {
 
 
 class TlsConfig;
+class TlsHandshakePool;
 
 
 class TlsContext
@@ -41,19 +51,54 @@ public:
     ~TlsContext();
 
     static TlsContext *create(const TlsConfig &config);
+    static TlsHandshakePool *pool(SSL_CTX *ctx);
+    static void onClose(SSL *ssl);
+    static void onHandshake(SSL *ssl);
 
-    inline SSL_CTX *ctx() const { return m_ctx; }
+    inline SSL_CTX *ctx() const                         { return m_ctx; }
+    inline void setHandshakeThreads(int threads)        { m_handshakeThreads = threads; }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
 
 private:
+    struct TicketKey
+    {
+        uint8_t name[16];
+        uint8_t hmac[32];
+        uint8_t aes[32];
+    };
+
     TlsContext() = default;
 
+    bool findKey(const uint8_t *name, TicketKey &key, bool &current);
     bool load(const TlsConfig &config);
+    bool loadKeys();
     bool setCiphers(const char *ciphers);
     bool setCipherSuites(const char *ciphersuites);
     bool setDH(const char *dhparam);
+    bool setSessions(const TlsConfig &config);
+    TicketKey currentKey();
+    void rotateKeys();
     void setProtocols(uint32_t protocols);
 
-    SSL_CTX *m_ctx = nullptr;
+    static int onTicketKey(SSL *ssl, uint8_t *name, uint8_t *iv, void *cipherCtx, void *hmacCtx, int enc);
+
+    bool m_ktls             = false;
+    bool m_tickets          = false;
+    int m_handshakeThreads  = -1;
+    SSL_CTX *m_ctx          = nullptr;
+    TlsHandshakePool *m_pool = nullptr;
+    std::atomic<uint64_t> m_handshakes{0};
+    std::atomic<uint64_t> m_ktlsConnections{0};
+    std::atomic<uint64_t> m_resumed{0};
+    std::atomic<uint64_t> m_ticketRenewed{0};
+    std::atomic<uint64_t> m_ticketUnknown{0};
+    std::mutex m_keysMutex;
+    std::vector<TicketKey> m_keys;
+    String m_keyFile;
+    uint32_t m_sessionCache = 0;
+    uint64_t m_rotateAt     = 0;
+    uint64_t m_rotation     = 0;
 };
 
 
@@ -0,0 +1,144 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/tls/TlsHandshakePool.h"
+#include "base/net/tls/ServerTls.h"
+#include "base/tools/Handle.h"
+
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+static void fail(TlsHandshakePool::Job *job)
+{
+    job->rc    = -1;
+    job->error = SSL_ERROR_SSL;
+
+    ServerTls::onHandshake(job);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::TlsHandshakePool::TlsHandshakePool(uint32_t threads)
+{
+    m_async = new uv_async_t;
+    uv_async_init(uv_default_loop(), m_async, TlsHandshakePool::onDone);
+    m_async->data = this;
+
+    // The async handle alone should not keep the loop alive.
+    uv_unref(reinterpret_cast<uv_handle_t *>(m_async));
+
+    for (uint32_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&TlsHandshakePool::run, this);
+    }
+}
+
+
+xmrig::TlsHandshakePool::~TlsHandshakePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cv.notify_all();
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+
+    Handle::close(m_async);
+
+    // Handshakes that did not make it back to the event loop are failed, the owners close their connections right away.
+    for (Job *job : m_queue) {
+        fail(job);
+    }
+
+    for (Job *job : m_done) {
+        fail(job);
+    }
+}
+
+
+void xmrig::TlsHandshakePool::submit(Job *job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.emplace_back(job);
+    }
+
+    m_cv.notify_one();
+}
+
+
+void xmrig::TlsHandshakePool::onDone(uv_async_t *handle)
+{
+    static_cast<TlsHandshakePool *>(handle->data)->done();
+}
+
+
+void xmrig::TlsHandshakePool::done()
+{
+    std::vector<Job *> jobs;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        jobs.swap(m_done);
+    }
+
+    for (Job *job : jobs) {
+        ServerTls::onHandshake(job);
+    }
+}
+
+
+void xmrig::TlsHandshakePool::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+        if (m_stop) {
+            return;
+        }
+
+        Job *job = m_queue.front();
+        m_queue.pop_front();
+
+        lock.unlock();
+
+        job->rc     = SSL_do_handshake(job->ssl);
+        job->error  = job->rc == 1 ? SSL_ERROR_NONE : SSL_get_error(job->ssl, job->rc);
+
+        ERR_clear_error();
+
+        lock.lock();
+        m_done.emplace_back(job);
+
+        uv_async_send(m_async);
+    }
+}
@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_TLSHANDSHAKEPOOL_H
+#define XMRIG_TLSHANDSHAKEPOOL_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using SSL           = struct ssl_st;
+using uv_async_t    = struct uv_async_s;
+
+
+namespace xmrig {
+
+
+class ServerTls;
+
+
+/**
+ * Dedicated threads for server side TLS handshakes.
+ *
+ * A job is owned by the pool between submit() and completion, the owner must not touch the SSL object
+ * in the meantime. Completed jobs are handed back to ServerTls on the event loop thread.
+ */
+class TlsHandshakePool
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(TlsHandshakePool)
+
+    struct Job
+    {
+        int error           = 0;
+        int rc              = 0;
+        ServerTls *owner    = nullptr;
+        SSL *ssl            = nullptr;
+    };
+
+    TlsHandshakePool(uint32_t threads);
+    ~TlsHandshakePool();
+
+    void submit(Job *job);
+
+private:
+    static void onDone(uv_async_t *handle);
+
+    void done();
+    void run();
+
+    bool m_stop         = false;
+    std::condition_variable m_cv;
+    std::deque<Job *> m_queue;
+    std::mutex m_mutex;
+    std::vector<Job *> m_done;
+    std::vector<std::thread> m_threads;
+    uv_async_t *m_async = nullptr;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_TLSHANDSHAKEPOOL_H
@@ -42,7 +42,9 @@ public:
     LineReader(ILineListener *listener) : m_listener(listener) {}
     ~LineReader();
 
-    inline void setListener(ILineListener *listener) { m_listener = listener; }
+    inline const char *data() const                   { return m_buf; }
+    inline size_t size() const                        { return m_pos; }
+    inline void setListener(ILineListener *listener)  { m_listener = listener; }
 
     void parse(char *data, size_t size);
     void reset();
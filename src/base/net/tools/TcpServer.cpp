@@ -32,7 +32,7 @@
 static const xmrig::String kLocalHost("127.0.0.1");
 
 
-xmrig::TcpServer::TcpServer(const String &host, uint16_t port, ITcpServerListener *listener) :
+xmrig::TcpServer::TcpServer(const String &host, uint16_t port, ITcpServerListener *listener, uv_loop_t *loop) :
     m_host(host.isNull() ? kLocalHost : host),
     m_listener(listener),
     m_port(port)
@@ -40,7 +40,7 @@ xmrig::TcpServer::TcpServer(const String &host, uint16_t port, ITcpServerListene
     assert(m_listener != nullptr);
 
     m_tcp = new uv_tcp_t;
-    uv_tcp_init(uv_default_loop(), m_tcp);
+    uv_tcp_init(loop ? loop : uv_default_loop(), m_tcp);
     m_tcp->data = this;
 
     uv_tcp_nodelay(m_tcp, 1);
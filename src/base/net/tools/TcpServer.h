@@ -44,7 +44,7 @@ class TcpServer
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(TcpServer)
 
-    TcpServer(const String &host, uint16_t port, ITcpServerListener *listener);
+    TcpServer(const String &host, uint16_t port, ITcpServerListener *listener, uv_loop_t *loop = nullptr);
     ~TcpServer();
 
     int bind();
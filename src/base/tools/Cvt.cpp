@@ -19,6 +19,7 @@
 
 #include "base/tools/Cvt.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/tools/CvtKernels.h"
 
 
 #include <cassert>
@@ -30,6 +31,15 @@
 #endif
 
 
+#ifdef XMRIG_CVT_AVX2
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+
 namespace xmrig {
 
 
@@ -143,6 +153,85 @@ static int cvt_hex2bin(unsigned char *const bin, const size_t bin_maxlen, const
 #endif
 
 
+struct CvtKernel
+{
+    size_t (*fromHex)(uint8_t *bin, const char *hex, size_t size);
+    size_t (*toHex)(char *hex, const uint8_t *bin, size_t size);
+};
+
+
+static const CvtKernel kernels[cvt::ISA_MAX] = {
+    { nullptr, nullptr },
+#   ifdef XMRIG_CVT_SSE2
+    { cvt::fromHexSSE2, cvt::toHexSSE2 },
+#   else
+    { nullptr, nullptr },
+#   endif
+#   ifdef XMRIG_CVT_AVX2
+    { cvt::fromHexAVX2, cvt::toHexAVX2 },
+#   else
+    { nullptr, nullptr },
+#   endif
+#   ifdef XMRIG_CVT_NEON
+    { cvt::fromHexNEON, cvt::toHexNEON },
+#   else
+    { nullptr, nullptr },
+#   endif
+};
+
+
+#ifdef XMRIG_CVT_AVX2
+static bool hasAVX2()
+{
+    int info[4] = {};
+
+#   ifdef _MSC_VER
+    __cpuid(info, 1);
+#   else
+    __cpuid(1, info[0], info[1], info[2], info[3]);
+#   endif
+
+    // OSXSAVE and AVX, then the OS must save the YMM state.
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) {
+        return false;
+    }
+
+#   ifdef _MSC_VER
+    const uint64_t xcr0 = _xgetbv(0);
+#   else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+    const uint64_t xcr0 = (static_cast<uint64_t>(edx) << 32) | eax;
+#   endif
+
+    if ((xcr0 & 6) != 6) {
+        return false;
+    }
+
+#   ifdef _MSC_VER
+    __cpuidex(info, 7, 0);
+#   else
+    __cpuid_count(7, 0, info[0], info[1], info[2], info[3]);
+#   endif
+
+    return (info[1] & (1 << 5)) != 0;
+}
+#endif
+
+
+static cvt::Isa detect()
+{
+    for (int isa = cvt::ISA_MAX - 1; isa > cvt::SCALAR; --isa) {
+        if (cvt::isSupported(static_cast<cvt::Isa>(isa))) {
+            return static_cast<cvt::Isa>(isa);
+        }
+    }
+
+    return cvt::SCALAR;
+}
+
+
 template<typename T>
 inline bool fromHexImpl(T &buf, const char *in, size_t size)
 {
@@ -153,7 +242,7 @@ inline bool fromHexImpl(T &buf, const char *in, size_t size)
 
     buf.resize(size / 2);
 
-    return sodium_hex2bin(reinterpret_cast<uint8_t *>(&buf.front()), buf.size(), in, size, nullptr, nullptr, nullptr) == 0;
+    return cvt::fromHex(cvt::best(), reinterpret_cast<uint8_t *>(&buf.front()), buf.size(), in, size);
 }
 
 
@@ -189,7 +278,7 @@ bool xmrig::Cvt::fromHex(uint8_t *bin, size_t bin_maxlen, const char *hex, size_
         return false;
     }
 
-    return sodium_hex2bin(bin, bin_maxlen, hex, hex_len, nullptr, nullptr, nullptr) == 0;
+    return cvt::fromHex(cvt::best(), bin, bin_maxlen, hex, hex_len);
 }
 
 
@@ -216,7 +305,7 @@ xmrig::Buffer xmrig::Cvt::fromHex(const char *in, size_t size)
 
 bool xmrig::Cvt::toHex(char *hex, size_t hex_maxlen, const uint8_t *bin, size_t bin_len)
 {
-    return cvt_bin2hex(hex, hex_maxlen, bin, bin_len) != nullptr;
+    return cvt::toHex(cvt::best(), hex, hex_maxlen, bin, bin_len);
 }
 
 
@@ -294,3 +383,80 @@ void xmrig::Cvt::randomBytes(void *buf, size_t size)
     randombytes_buf(buf, size);
 #   endif
 }
+
+
+xmrig::cvt::Isa xmrig::cvt::best()
+{
+    static const Isa isa = detect();
+
+    return isa;
+}
+
+
+bool xmrig::cvt::fromHex(Isa isa, uint8_t *bin, size_t bin_maxlen, const char *hex, size_t hex_len)
+{
+    size_t done = 0;
+
+    // Odd and too long input always fails, the scalar code decides how exactly.
+    if (kernels[isa].fromHex && (hex_len & 1) == 0 && hex_len / 2 <= bin_maxlen) {
+        done = kernels[isa].fromHex(bin, hex, hex_len);
+
+        if (done == kInvalid) {
+            return false;
+        }
+    }
+
+    return sodium_hex2bin(bin + done / 2, bin_maxlen - done / 2, hex + done, hex_len - done, nullptr, nullptr, nullptr) == 0;
+}
+
+
+bool xmrig::cvt::isSupported(Isa isa)
+{
+    switch (isa) {
+    case SCALAR:
+        return true;
+
+#   ifdef XMRIG_CVT_SSE2
+    case SSE2:
+        return true;
+#   endif
+
+#   ifdef XMRIG_CVT_AVX2
+    case AVX2:
+        {
+            static const bool supported = hasAVX2();
+            return supported;
+        }
+#   endif
+
+#   ifdef XMRIG_CVT_NEON
+    case NEON:
+        return true;
+#   endif
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+
+bool xmrig::cvt::toHex(Isa isa, char *hex, size_t hex_maxlen, const uint8_t *bin, size_t bin_len)
+{
+    if (bin_len >= SIZE_MAX / 2 || hex_maxlen < bin_len * 2U) {
+        return false;
+    }
+
+    const size_t done = kernels[isa].toHex ? kernels[isa].toHex(hex, bin, bin_len) : 0;
+
+    return cvt_bin2hex(hex + done * 2, hex_maxlen - done * 2, bin + done, bin_len - done) != nullptr;
+}
+
+
+const char *xmrig::cvt::isaName(Isa isa)
+{
+    static const char *names[ISA_MAX] = { "scalar", "sse2", "avx2", "neon" };
+
+    return isa < ISA_MAX ? names[isa] : "unknown";
+}
@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CVTKERNELS_H
+#define XMRIG_CVTKERNELS_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * Hex codec kernels behind Cvt::toHex and Cvt::fromHex.
+ *
+ * SIMD kernels convert only whole blocks and leave the tail to the scalar code. A fromHex kernel returns the number of
+ * converted hex characters or kInvalid, the result of the whole conversion is always the same as of the scalar code.
+ */
+namespace cvt {
+
+
+enum Isa : int {
+    SCALAR,
+    SSE2,
+    AVX2,
+    NEON,
+    ISA_MAX
+};
+
+
+constexpr const size_t kInvalid = SIZE_MAX;
+
+
+Isa best();
+bool fromHex(Isa isa, uint8_t *bin, size_t bin_maxlen, const char *hex, size_t hex_len);
+bool isSupported(Isa isa);
+bool toHex(Isa isa, char *hex, size_t hex_maxlen, const uint8_t *bin, size_t bin_len);
+const char *isaName(Isa isa);
+
+size_t fromHexAVX2(uint8_t *bin, const char *hex, size_t size);
+size_t fromHexNEON(uint8_t *bin, const char *hex, size_t size);
+size_t fromHexSSE2(uint8_t *bin, const char *hex, size_t size);
+size_t toHexAVX2(char *hex, const uint8_t *bin, size_t size);
+size_t toHexNEON(char *hex, const uint8_t *bin, size_t size);
+size_t toHexSSE2(char *hex, const uint8_t *bin, size_t size);
+
+
+} // namespace cvt
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CVTKERNELS_H */
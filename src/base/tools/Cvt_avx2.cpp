@@ -0,0 +1,106 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "base/tools/CvtKernels.h"
+
+
+#include <immintrin.h>
+
+
+// This file is compiled with AVX2 enabled, it must not include headers with inline functions shared with other files.
+
+
+namespace xmrig {
+
+
+static inline __m256i nibbles(__m256i c, __m256i &valid)
+{
+    const __m256i digit   = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i alpha   = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    valid = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isAlpha));
+
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit), _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+
+static inline __m256i join(__m256i n)
+{
+    return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(n, _mm256_set1_epi16(0xFF)), 4), _mm256_srli_epi16(n, 8));
+}
+
+
+static inline __m256i ascii(__m256i n)
+{
+    const __m256i letter = _mm256_cmpgt_epi8(n, _mm256_set1_epi8(9));
+
+    return _mm256_add_epi8(n, _mm256_add_epi8(_mm256_set1_epi8('0'), _mm256_and_si256(letter, _mm256_set1_epi8('a' - '0' - 10))));
+}
+
+
+} // namespace xmrig
+
+
+size_t xmrig::cvt::fromHexAVX2(uint8_t *bin, const char *hex, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 64 <= size; i += 64) {
+        __m256i valid   = _mm256_set1_epi8(-1);
+        const __m256i a = nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hex + i)), valid);
+        const __m256i b = nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hex + i + 32)), valid);
+
+        if (_mm256_movemask_epi8(valid) != -1) {
+            _mm256_zeroupper();
+
+            return kInvalid;
+        }
+
+        // Packing works within 128 bit lanes, the permutation restores the order of the 64 bit quarters.
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(bin + i / 2), _mm256_permute4x64_epi64(_mm256_packus_epi16(join(a), join(b)), 0xD8));
+    }
+
+    _mm256_zeroupper();
+
+    return i;
+}
+
+
+size_t xmrig::cvt::toHexAVX2(char *hex, const uint8_t *bin, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bin + i));
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+        const __m256i lo = _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
+        const __m256i a  = ascii(_mm256_unpacklo_epi8(hi, lo));
+        const __m256i b  = ascii(_mm256_unpackhi_epi8(hi, lo));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(hex + i * 2),      _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(hex + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    _mm256_zeroupper();
+
+    return i;
+}
@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "base/tools/CvtKernels.h"
+
+
+#include <arm_neon.h>
+
+
+namespace xmrig {
+
+
+static inline uint8x16_t nibbles(uint8x16_t c, uint8x16_t &valid)
+{
+    const uint8x16_t digit   = vsubq_u8(c, vdupq_n_u8('0'));
+    const uint8x16_t alpha   = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t isAlpha = vcleq_u8(alpha, vdupq_n_u8(5));
+
+    valid = vandq_u8(valid, vorrq_u8(isDigit, isAlpha));
+
+    return vbslq_u8(isDigit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+}
+
+
+} // namespace xmrig
+
+
+size_t xmrig::cvt::fromHexNEON(uint8_t *bin, const char *hex, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 32 <= size; i += 32) {
+        // De-interleaving load: val[0] holds the high nibble characters, val[1] the low ones.
+        const uint8x16x2_t c = vld2q_u8(reinterpret_cast<const uint8_t *>(hex + i));
+        uint8x16_t valid     = vdupq_n_u8(0xFF);
+        const uint8x16_t hi  = nibbles(c.val[0], valid);
+        const uint8x16_t lo  = nibbles(c.val[1], valid);
+
+        if (vminvq_u8(valid) != 0xFF) {
+            return kInvalid;
+        }
+
+        vst1q_u8(bin + i / 2, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+
+    return i;
+}
+
+
+size_t xmrig::cvt::toHexNEON(char *hex, const uint8_t *bin, size_t size)
+{
+    static const uint8_t digits[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+    const uint8x16_t table          = vld1q_u8(digits);
+
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t v = vld1q_u8(bin + i);
+        uint8x16x2_t out;
+
+        out.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+        out.val[1] = vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0x0F)));
+
+        vst2q_u8(reinterpret_cast<uint8_t *>(hex + i * 2), out);
+    }
+
+    return i;
+}
@@ -0,0 +1,96 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "base/tools/CvtKernels.h"
+
+
+#include <emmintrin.h>
+
+
+namespace xmrig {
+
+
+// Converts 16 hex characters to nibble values, lanes with characters other than 0-9, a-f, A-F are cleared in valid.
+static inline __m128i nibbles(__m128i c, __m128i &valid)
+{
+    const __m128i digit   = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i alpha   = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isAlpha));
+
+    return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+
+// Joins pairs of nibbles, the first one is the high half: 16 nibbles in 8 lanes of 16 bits give 8 bytes in the low half of each lane.
+static inline __m128i join(__m128i n)
+{
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0xFF)), 4), _mm_srli_epi16(n, 8));
+}
+
+
+static inline __m128i ascii(__m128i n)
+{
+    const __m128i letter = _mm_cmpgt_epi8(n, _mm_set1_epi8(9));
+
+    return _mm_add_epi8(n, _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(letter, _mm_set1_epi8('a' - '0' - 10))));
+}
+
+
+} // namespace xmrig
+
+
+size_t xmrig::cvt::fromHexSSE2(uint8_t *bin, const char *hex, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 32 <= size; i += 32) {
+        __m128i valid   = _mm_set1_epi8(-1);
+        const __m128i a = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + i)), valid);
+        const __m128i b = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + i + 16)), valid);
+
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            return kInvalid;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bin + i / 2), _mm_packus_epi16(join(a), join(b)));
+    }
+
+    return i;
+}
+
+
+size_t xmrig::cvt::toHexSSE2(char *hex, const uint8_t *bin, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bin + i));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+        const __m128i lo = _mm_and_si128(v, _mm_set1_epi8(0x0F));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + i * 2),      ascii(_mm_unpacklo_epi8(hi, lo)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + i * 2 + 16), ascii(_mm_unpackhi_epi8(hi, lo)));
+    }
+
+    return i;
+}
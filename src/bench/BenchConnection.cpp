@@ -0,0 +1,164 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "bench/BenchConnection.h"
+#include "base/net/tools/NetBuffer.h"
+
+
+#include <string>
+
+
+xmrig::BenchConnection::BenchConnection() :
+    m_reader(this),
+    m_tcp(new uv_tcp_t)
+{
+    uv_tcp_init(uv_default_loop(), m_tcp);
+    uv_tcp_nodelay(m_tcp, 1);
+
+    m_tcp->data = this;
+}
+
+
+xmrig::BenchConnection::~BenchConnection()
+{
+    close();
+}
+
+
+bool xmrig::BenchConnection::accept(uv_stream_t *server)
+{
+    if (uv_accept(server, reinterpret_cast<uv_stream_t*>(m_tcp)) != 0) {
+        return false;
+    }
+
+    start();
+
+    return true;
+}
+
+
+bool xmrig::BenchConnection::connect(const sockaddr *addr)
+{
+    auto req  = new uv_connect_t;
+    req->data = this;
+
+    if (uv_tcp_connect(req, m_tcp, addr, onConnect) != 0) {
+        delete req;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+void xmrig::BenchConnection::close()
+{
+    if (!m_tcp) {
+        return;
+    }
+
+    m_open      = false;
+    m_tcp->data = nullptr;
+
+    uv_close(reinterpret_cast<uv_handle_t*>(m_tcp), [](uv_handle_t *handle) { delete reinterpret_cast<uv_tcp_t*>(handle); });
+    m_tcp = nullptr;
+}
+
+
+void xmrig::BenchConnection::send(const char *data, size_t size)
+{
+    if (!m_open) {
+        return;
+    }
+
+    auto stream  = reinterpret_cast<uv_stream_t*>(m_tcp);
+    uv_buf_t buf = uv_buf_init(const_cast<char *>(data), static_cast<unsigned int>(size));
+    int rc       = stream->write_queue_size == 0 ? uv_try_write(stream, &buf, 1) : UV_EAGAIN;
+
+    if (rc == UV_EAGAIN) {
+        rc = 0;
+    }
+
+    if (rc < 0 || static_cast<size_t>(rc) == size) {
+        return;
+    }
+
+    struct WriteReq
+    {
+        uv_write_t req;
+        std::string data;
+    };
+
+    auto req      = new WriteReq();
+    req->req.data = req;
+    req->data.assign(data + rc, size - rc);
+
+    buf = uv_buf_init(&req->data[0], static_cast<unsigned int>(req->data.size()));
+
+    if (uv_write(&req->req, stream, &buf, 1, [](uv_write_t *req, int) { delete static_cast<WriteReq *>(req->data); }) < 0) {
+        delete req;
+    }
+}
+
+
+void xmrig::BenchConnection::start()
+{
+    m_open = true;
+
+    uv_read_start(reinterpret_cast<uv_stream_t*>(m_tcp), NetBuffer::onAlloc, onRead);
+}
+
+
+void xmrig::BenchConnection::onConnect(uv_connect_t *req, int status)
+{
+    auto connection = static_cast<BenchConnection *>(req->data);
+    delete req;
+
+    if (!connection->m_tcp) {
+        return;
+    }
+
+    if (status < 0) {
+        connection->close();
+        connection->onDisconnected();
+
+        return;
+    }
+
+    connection->start();
+    connection->onConnected();
+}
+
+
+void xmrig::BenchConnection::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    auto connection = static_cast<BenchConnection *>(stream->data);
+
+    if (connection && nread > 0) {
+        connection->m_reader.parse(buf->base, static_cast<size_t>(nread));
+    }
+    else if (connection && nread < 0) {
+        connection->close();
+        connection->onDisconnected();
+    }
+
+    NetBuffer::release(buf);
+}
@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_BENCHCONNECTION_H
+#define XMRIG_BENCHCONNECTION_H
+
+
+#include "base/kernel/interfaces/ILineListener.h"
+#include "base/net/tools/LineReader.h"
+
+
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+/**
+ * Line based TCP connection used by both sides of the load generator, the fake pool sessions and the simulated miners.
+ */
+class BenchConnection : public ILineListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(BenchConnection)
+
+    BenchConnection();
+    ~BenchConnection() override;
+
+    inline bool isOpen() const      { return m_open; }
+    inline uv_tcp_t *handle() const { return m_tcp; }
+
+    bool accept(uv_stream_t *server);
+    bool connect(const sockaddr *addr);
+    void close();
+    void send(const char *data, size_t size);
+
+protected:
+    virtual void onConnected()      {}
+    virtual void onDisconnected()   {}
+
+private:
+    void start();
+
+    static void onConnect(uv_connect_t *req, int status);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    bool m_open = false;
+    LineReader m_reader;
+    uv_tcp_t *m_tcp;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BENCHCONNECTION_H */
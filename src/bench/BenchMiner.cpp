@@ -0,0 +1,248 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "bench/BenchMiner.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "base/tools/Cvt.h"
+#include "bench/BenchStats.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static const size_t kNonceOffset = 39;
+static const int64_t kLoginId    = 1;
+
+
+static void closeTimer(uv_timer_t *&timer)
+{
+    if (timer) {
+        uv_close(reinterpret_cast<uv_handle_t*>(timer), [](uv_handle_t *handle) { delete reinterpret_cast<uv_timer_t*>(handle); });
+        timer = nullptr;
+    }
+}
+
+
+static uv_timer_t *createTimer(void *data)
+{
+    auto timer = new uv_timer_t;
+    uv_timer_init(uv_default_loop(), timer);
+    timer->data = data;
+
+    return timer;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::BenchMiner::BenchMiner(size_t index, BenchStats &stats) :
+    m_stats(stats),
+    m_index(index)
+{
+}
+
+
+xmrig::BenchMiner::~BenchMiner()
+{
+    stop();
+}
+
+
+void xmrig::BenchMiner::start(const sockaddr *addr, uint64_t submitInterval, uint64_t submitOffset, uint64_t keepAliveInterval)
+{
+    m_submitInterval    = submitInterval;
+    m_submitOffset      = submitOffset;
+    m_keepAliveInterval = keepAliveInterval;
+
+    if (!connect(addr)) {
+        m_stats.closed++;
+    }
+}
+
+
+void xmrig::BenchMiner::stop()
+{
+    closeTimer(m_submit);
+    closeTimer(m_keepAlive);
+    close();
+}
+
+
+void xmrig::BenchMiner::onConnected()
+{
+    char buf[256];
+    const int size = snprintf(buf, sizeof(buf),
+                              "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"login\",\"params\":{\"login\":\"bench\",\"pass\":\"x\",\"rigid\":\"rig%zu\",\"agent\":\"xmrig-proxy-bench\",\"algo\":[\"rx/0\"]}}\n",
+                              kLoginId, m_index);
+
+    send(buf, static_cast<size_t>(size));
+}
+
+
+void xmrig::BenchMiner::onDisconnected()
+{
+    closeTimer(m_submit);
+    closeTimer(m_keepAlive);
+
+    m_stats.closed++;
+}
+
+
+void xmrig::BenchMiner::onLine(char *line, size_t)
+{
+    using namespace rapidjson;
+
+    Document doc;
+    if (doc.ParseInsitu(line).HasParseError() || !doc.IsObject()) {
+        return;
+    }
+
+    const char *method = Json::getString(doc, "method");
+    if (method) {
+        if (strcmp(method, "job") == 0) {
+            setJob(Json::getObject(doc, "params"));
+        }
+
+        return;
+    }
+
+    const int64_t id    = Json::getInt64(doc, "id");
+    const bool isError  = doc.HasMember("error") && !doc["error"].IsNull();
+
+    if (id == kLoginId && !isLoggedIn()) {
+        const Value &result = Json::getObject(doc, "result");
+        const char *rpcId   = Json::getString(result, "id");
+
+        if (isError || !rpcId) {
+            return stop();
+        }
+
+        m_rpcId = rpcId;
+        m_stats.loggedIn++;
+
+        setJob(Json::getObject(result, "job"));
+
+        if (m_submitInterval) {
+            m_submit = createTimer(this);
+            uv_timer_start(m_submit, onTimer, m_submitOffset, m_submitInterval);
+        }
+
+        if (m_keepAliveInterval) {
+            m_keepAlive = createTimer(this);
+            uv_timer_start(m_keepAlive, onTimer, m_keepAliveInterval, m_keepAliveInterval);
+        }
+
+        return;
+    }
+
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) {
+        if (!isError) {
+            m_stats.keepalived++;
+        }
+
+        return;
+    }
+
+    if (m_stats.measuring) {
+        if (isError) {
+            m_stats.rejected++;
+        }
+        else {
+            m_stats.accepted++;
+            m_stats.rtt.push_back(static_cast<uint32_t>(std::min<uint64_t>((uv_hrtime() - it->second) / 1000, UINT32_MAX)));
+        }
+    }
+
+    m_pending.erase(it);
+}
+
+
+void xmrig::BenchMiner::keepAlive()
+{
+    char buf[160];
+    const int size = snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"keepalived\",\"params\":{\"id\":\"%s\"}}\n", ++m_sequence, m_rpcId.c_str());
+
+    send(buf, static_cast<size_t>(size));
+}
+
+
+void xmrig::BenchMiner::setJob(const rapidjson::Value &params)
+{
+    const char *jobId = Json::getString(params, "job_id");
+    const char *blob  = Json::getString(params, "blob");
+
+    if (!jobId || !blob || strlen(blob) < (kNonceOffset + 4) * 2 || strlen(jobId) >= sizeof(m_jobId)) {
+        return;
+    }
+
+    strcpy(m_jobId, jobId);
+    Cvt::fromHex(&m_fixedByte, 1, blob + (kNonceOffset + 3) * 2, 2);
+
+    if (jobId[0] != 'b') {
+        return;
+    }
+
+    const size_t block = strtoul(jobId + 1, nullptr, 10);
+    if (block < m_stats.received.size()) {
+        m_stats.received[block]++;
+        m_stats.lastReceived[block] = std::max(m_stats.lastReceived[block], uv_hrtime());
+    }
+}
+
+
+void xmrig::BenchMiner::submit()
+{
+    if (!m_jobId[0]) {
+        return;
+    }
+
+    // The result is not a real hash, its last 8 bytes make the share difficulty high enough for any target.
+    const uint32_t nonce = m_nonce++ & 0xFFFFFF;
+    char buf[320];
+    const int size = snprintf(buf, sizeof(buf),
+                              "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"submit\",\"params\":{\"id\":\"%s\",\"job_id\":\"%s\",\"nonce\":\"%02x%02x%02x%02x\","
+                              "\"result\":\"0000000000000000000000000000000000000000000000000100000000000000\"}}\n",
+                              ++m_sequence, m_rpcId.c_str(), m_jobId, nonce & 0xFF, (nonce >> 8) & 0xFF, nonce >> 16, m_fixedByte);
+
+    m_pending.emplace(m_sequence, uv_hrtime());
+    send(buf, static_cast<size_t>(size));
+}
+
+
+void xmrig::BenchMiner::onTimer(uv_timer_t *handle)
+{
+    auto miner = static_cast<BenchMiner *>(handle->data);
+
+    if (handle == miner->m_submit) {
+        miner->submit();
+    }
+    else {
+        miner->keepAlive();
+    }
+}
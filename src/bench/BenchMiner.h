@@ -0,0 +1,85 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_BENCHMINER_H
+#define XMRIG_BENCHMINER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "bench/BenchConnection.h"
+
+
+#include <map>
+#include <string>
+
+
+namespace xmrig {
+
+
+struct BenchStats;
+
+
+/**
+ * Simulated miner: logs in, follows jobs and submits shares compatible with its nicehash fixed byte at a fixed rate.
+ */
+class BenchMiner : public BenchConnection
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(BenchMiner)
+
+    BenchMiner(size_t index, BenchStats &stats);
+    ~BenchMiner() override;
+
+    inline bool isLoggedIn() const { return !m_rpcId.empty(); }
+
+    void start(const sockaddr *addr, uint64_t submitInterval, uint64_t submitOffset, uint64_t keepAliveInterval);
+    void stop();
+
+protected:
+    void onConnected() override;
+    void onDisconnected() override;
+    void onLine(char *line, size_t size) override;
+
+private:
+    void keepAlive();
+    void setJob(const rapidjson::Value &params);
+    void submit();
+
+    static void onTimer(uv_timer_t *handle);
+
+    BenchStats &m_stats;
+    char m_jobId[32]{};
+    const size_t m_index;
+    int64_t m_sequence          = 1;
+    std::map<int64_t, uint64_t> m_pending;
+    std::string m_rpcId;
+    uint32_t m_nonce            = 0;
+    uint64_t m_keepAliveInterval = 0;
+    uint64_t m_submitInterval   = 0;
+    uint64_t m_submitOffset     = 0;
+    uint8_t m_fixedByte         = 0;
+    uv_timer_t *m_keepAlive     = nullptr;
+    uv_timer_t *m_submit        = nullptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BENCHMINER_H */
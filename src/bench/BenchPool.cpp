@@ -0,0 +1,188 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "bench/BenchPool.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "bench/BenchConnection.h"
+#include "bench/BenchStats.h"
+
+
+#include <cinttypes>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static const char *kSeedHash = "a52e6fcf8b8bef8bdf20fbdd6aaa9ef2e0ea8e2ef2f79f8bde1dea0b7b80e1ea";
+static const char *kTarget   = "b88d0600";
+
+
+class BenchPool::Session : public BenchConnection
+{
+public:
+    inline Session(BenchPool *pool) : m_pool(pool) {}
+
+protected:
+    void onLine(char *line, size_t) override
+    {
+        using namespace rapidjson;
+
+        Document doc;
+        if (doc.ParseInsitu(line).HasParseError() || !doc.IsObject()) {
+            return;
+        }
+
+        const int64_t id   = Json::getInt64(doc, "id");
+        const char *method = Json::getString(doc, "method", "");
+        char buf[160];
+
+        if (strcmp(method, "login") == 0) {
+            char rpcId[24];
+            snprintf(rpcId, sizeof(rpcId), "s%zu", m_pool->m_sessions.size());
+
+            const std::string reply = m_pool->job(false, id, rpcId);
+            send(reply.data(), reply.size());
+
+            return;
+        }
+
+        if (strcmp(method, "submit") == 0) {
+            m_pool->m_stats.poolShares++;
+
+            send(buf, static_cast<size_t>(snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"OK\"}}\n", id)));
+
+            return;
+        }
+
+        send(buf, static_cast<size_t>(snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"KEEPALIVED\"}}\n", id)));
+    }
+
+private:
+    BenchPool *m_pool;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::BenchPool::BenchPool(BenchStats &stats) :
+    m_stats(stats),
+    m_server(new uv_tcp_t)
+{
+    uv_tcp_init(uv_default_loop(), m_server);
+    m_server->data = this;
+
+    m_stats.blocks.push_back(uv_hrtime());
+    m_stats.lastReceived.push_back(0);
+    m_stats.received.push_back(0);
+}
+
+
+xmrig::BenchPool::~BenchPool()
+{
+    close();
+}
+
+
+bool xmrig::BenchPool::bind()
+{
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", 0, &addr);
+
+    if (uv_tcp_bind(m_server, reinterpret_cast<const sockaddr *>(&addr), 0) != 0 || uv_listen(reinterpret_cast<uv_stream_t*>(m_server), 511, onConnection) != 0) {
+        return false;
+    }
+
+    int size = sizeof(addr);
+    uv_tcp_getsockname(m_server, reinterpret_cast<sockaddr *>(&addr), &size);
+    m_port = ntohs(addr.sin_port);
+
+    return true;
+}
+
+
+void xmrig::BenchPool::close()
+{
+    for (auto &session : m_sessions) {
+        session->close();
+    }
+
+    if (m_server) {
+        uv_close(reinterpret_cast<uv_handle_t*>(m_server), [](uv_handle_t *handle) { delete reinterpret_cast<uv_tcp_t*>(handle); });
+        m_server = nullptr;
+    }
+}
+
+
+void xmrig::BenchPool::newBlock()
+{
+    ++m_block;
+
+    m_stats.blocks.push_back(uv_hrtime());
+    m_stats.lastReceived.push_back(0);
+    m_stats.received.push_back(0);
+
+    const std::string notification = job(true);
+
+    for (auto &session : m_sessions) {
+        session->send(notification.data(), notification.size());
+    }
+}
+
+
+std::string xmrig::BenchPool::job(bool notification, int64_t id, const char *rpcId) const
+{
+    // 76 bytes blob, the nonce is at offset 39 like in a Monero block hashing blob; bytes 2-9 make every block unique.
+    char blob[153];
+    snprintf(blob, sizeof(blob), "1010%016" PRIx64 "%s00000000%s", static_cast<uint64_t>(m_block),
+             "ababababababababababababababababababababababababababababab",
+             "cdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcdcd");
+
+    char params[512];
+    snprintf(params, sizeof(params), "{\"blob\":\"%s\",\"job_id\":\"b%u\",\"target\":\"%s\",\"algo\":\"rx/0\",\"height\":%u,\"seed_hash\":\"%s\"}",
+             blob, m_block, kTarget, m_block + 1, kSeedHash);
+
+    char buf[768];
+    if (notification) {
+        snprintf(buf, sizeof(buf), "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":%s}\n", params);
+    }
+    else {
+        snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"id\":\"%s\",\"job\":%s,\"extensions\":[\"algo\",\"nicehash\",\"keepalive\"],\"status\":\"OK\"}}\n",
+                 id, rpcId, params);
+    }
+
+    return buf;
+}
+
+
+void xmrig::BenchPool::onConnection(uv_stream_t *server, int status)
+{
+    auto pool = static_cast<BenchPool *>(server->data);
+    if (status < 0 || !pool) {
+        return;
+    }
+
+    std::unique_ptr<Session> session(new Session(pool));
+    if (session->accept(server)) {
+        pool->m_sessions.push_back(std::move(session));
+    }
+}
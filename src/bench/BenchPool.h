@@ -0,0 +1,77 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_BENCHPOOL_H
+#define XMRIG_BENCHPOOL_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <memory>
+#include <string>
+#include <uv.h>
+#include <vector>
+
+
+namespace xmrig {
+
+
+struct BenchStats;
+
+
+/**
+ * Minimal in-process stratum pool: accepts any login and share, and broadcasts a new job on every block.
+ *
+ * Job ids are "b<block index>", so the simulated miners can attribute received jobs to the block they belong to.
+ */
+class BenchPool
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(BenchPool)
+
+    BenchPool(BenchStats &stats);
+    ~BenchPool();
+
+    inline uint16_t port() const    { return m_port; }
+    inline size_t sessions() const  { return m_sessions.size(); }
+
+    bool bind();
+    void close();
+    void newBlock();
+
+private:
+    class Session;
+
+    std::string job(bool notification, int64_t id = 0, const char *rpcId = nullptr) const;
+
+    static void onConnection(uv_stream_t *server, int status);
+
+    BenchStats &m_stats;
+    std::vector<std::unique_ptr<Session>> m_sessions;
+    uint16_t m_port     = 0;
+    uint32_t m_block    = 0;
+    uv_tcp_t *m_server;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BENCHPOOL_H */
@@ -0,0 +1,62 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_BENCHSTATS_H
+#define XMRIG_BENCHSTATS_H
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Counters shared by the fake pool and the simulated miners, all timestamps are uv_hrtime() nanoseconds.
+ */
+struct BenchStats
+{
+    inline void reset()
+    {
+        accepted    = 0;
+        keepalived  = 0;
+        poolShares  = 0;
+        rejected    = 0;
+        rtt.clear();
+    }
+
+    bool measuring          = false;
+    std::vector<uint32_t> received;         // number of miners which got the job of each block
+    std::vector<uint32_t> rtt;              // submit round trips, microseconds
+    std::vector<uint64_t> blocks;           // time when each block was sent by the pool
+    std::vector<uint64_t> lastReceived;     // time when the last miner got the job of each block
+    uint64_t accepted       = 0;
+    uint64_t closed         = 0;
+    uint64_t keepalived     = 0;
+    uint64_t loggedIn       = 0;
+    uint64_t poolShares     = 0;
+    uint64_t rejected       = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BENCHSTATS_H */
@@ -0,0 +1,255 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "bench/Microbench.h"
+#include "base/tools/Chrono.h"
+#include "version.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+
+namespace xmrig {
+
+
+#ifdef _MSC_VER
+volatile char Microbench::m_sink = 0;
+#endif
+
+
+struct MicrobenchResult
+{
+    const char *name;
+    double bytesPerSecond;
+    double cpuTime;
+    double realTime;
+    uint64_t iterations;
+};
+
+
+static const char *value(const char *arg, const char *flag)
+{
+    const size_t size = strlen(flag);
+
+    return (strncmp(arg, flag, size) == 0 && arg[size] == '=') ? arg + size + 1 : nullptr;
+}
+
+
+static double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+
+    return values[values.size() / 2];
+}
+
+
+static void measure(Microbench::Function function, uint64_t iterations, double &real, double &cpu)
+{
+    const std::clock_t clock = std::clock();
+    const double start       = Chrono::highResolutionMSecs();
+
+    function(iterations);
+
+    real = (Chrono::highResolutionMSecs() - start) * 1e6;
+    cpu  = static_cast<double>(std::clock() - clock) * 1e9 / CLOCKS_PER_SEC;
+}
+
+
+static std::string toJSON(const char *executable, const std::vector<MicrobenchResult> &results, int repetitions)
+{
+    char date[32] = {};
+    const time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", gmtime(&now));
+
+#   ifdef NDEBUG
+    const char *buildType = "release";
+#   else
+    const char *buildType = "debug";
+#   endif
+
+    char buf[512];
+    snprintf(buf, sizeof(buf), "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": \"%s\",\n    \"num_cpus\": %u,\n    \"library_build_type\": \"%s\",\n    \"version\": \"%s\"\n  },\n  \"benchmarks\": [",
+             date, executable, std::thread::hardware_concurrency(), buildType, APP_VERSION);
+
+    std::string out = buf;
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MicrobenchResult &r = results[i];
+
+        snprintf(buf, sizeof(buf), "%s\n    {\n      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n      \"run_type\": \"aggregate\",\n      \"aggregate_name\": \"median\",\n"
+                 "      \"repetitions\": %d,\n      \"iterations\": %" PRIu64 ",\n      \"real_time\": %.4f,\n      \"cpu_time\": %.4f,\n      \"time_unit\": \"ns\"",
+                 i ? "," : "", r.name, r.name, repetitions, r.iterations, r.realTime, r.cpuTime);
+        out += buf;
+
+        if (r.bytesPerSecond > 0) {
+            snprintf(buf, sizeof(buf), ",\n      \"bytes_per_second\": %.1f", r.bytesPerSecond);
+            out += buf;
+        }
+
+        out += "\n    }";
+    }
+
+    out += "\n  ]\n}\n";
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+int xmrig::Microbench::run(int argc, char **argv)
+{
+    const char *filter  = nullptr;
+    const char *outFile = nullptr;
+    bool json           = false;
+    bool list           = false;
+    double minTime      = 0.5;
+    int repetitions     = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *v = nullptr;
+
+        if ((v = value(argv[i], "--benchmark_filter"))) {
+            filter = v;
+        }
+        else if ((v = value(argv[i], "--benchmark_min_time"))) {
+            minTime = std::max(strtod(v, nullptr), 0.001);
+        }
+        else if ((v = value(argv[i], "--benchmark_repetitions"))) {
+            repetitions = std::max(atoi(v), 1);
+        }
+        else if ((v = value(argv[i], "--benchmark_format"))) {
+            json = strcmp(v, "json") == 0;
+        }
+        else if ((v = value(argv[i], "--benchmark_out"))) {
+            outFile = v;
+        }
+        else if (strcmp(argv[i], "--benchmark_list_tests") == 0) {
+            list = true;
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>] [--benchmark_repetitions=<n>]\n"
+                            "       [--benchmark_format=console|json] [--benchmark_out=<file.json>] [--benchmark_list_tests]\n", argv[0]);
+
+            return 1;
+        }
+    }
+
+    std::vector<MicrobenchResult> results;
+
+    if (!json && !list) {
+        printf("%-32s %14s %14s %12s %14s\n", "Benchmark", "Time", "CPU", "Iterations", "Bytes/s");
+    }
+
+    for (const Case &c : cases()) {
+        if (filter && !strstr(c.name, filter)) {
+            continue;
+        }
+
+        if (list) {
+            printf("%s\n", c.name);
+            continue;
+        }
+
+        double real = 0.0;
+        double cpu  = 0.0;
+        uint64_t iterations = 1;
+
+        // Grow the iteration count until one run takes at least the minimum time.
+        for (;;) {
+            measure(c.function, iterations, real, cpu);
+
+            if (real >= minTime * 1e9 || iterations >= (1ULL << 40)) {
+                break;
+            }
+
+            const double scale = real > 0.0 ? minTime * 1e9 * 1.2 / real : 100.0;
+            iterations = std::max(iterations + 1, static_cast<uint64_t>(static_cast<double>(iterations) * std::min(scale, 100.0)));
+        }
+
+        std::vector<double> realTimes;
+        std::vector<double> cpuTimes;
+
+        for (int i = 0; i < repetitions; ++i) {
+            measure(c.function, iterations, real, cpu);
+
+            realTimes.push_back(real / static_cast<double>(iterations));
+            cpuTimes.push_back(cpu / static_cast<double>(iterations));
+        }
+
+        MicrobenchResult result{ c.name, 0.0, median(cpuTimes), median(realTimes), iterations };
+        if (c.bytes) {
+            result.bytesPerSecond = static_cast<double>(c.bytes) * 1e9 / result.realTime;
+        }
+
+        if (!json) {
+            printf("%-32s %11.1f ns %11.1f ns %12" PRIu64, c.name, result.realTime, result.cpuTime, iterations);
+            printf(result.bytesPerSecond > 0 ? " %12.1fM\n" : "\n", result.bytesPerSecond / 1e6);
+            fflush(stdout);
+        }
+
+        results.push_back(result);
+    }
+
+    if (list) {
+        return 0;
+    }
+
+    const std::string out = toJSON(argv[0], results, repetitions);
+
+    if (json) {
+        fputs(out.c_str(), stdout);
+    }
+
+    if (outFile) {
+        FILE *fp = fopen(outFile, "wb");
+        if (!fp || fwrite(out.data(), 1, out.size(), fp) != out.size()) {
+            fprintf(stderr, "%s: write failed\n", outFile);
+        }
+
+        if (fp) {
+            fclose(fp);
+        }
+    }
+
+    return 0;
+}
+
+
+void xmrig::Microbench::add(const char *name, Function function, size_t bytes)
+{
+    cases().push_back({ name, function, bytes });
+}
+
+
+std::vector<xmrig::Microbench::Case> &xmrig::Microbench::cases()
+{
+    static std::vector<Case> cases;
+
+    return cases;
+}
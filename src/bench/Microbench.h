@@ -0,0 +1,81 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_MICROBENCH_H
+#define XMRIG_MICROBENCH_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+
+namespace xmrig {
+
+
+/**
+ * Minimal Google Benchmark style runner: each case is called with an iteration count, the runner grows the count
+ * until one run lasts --benchmark_min_time and reports the median of --benchmark_repetitions runs.
+ *
+ * Command line flags and the JSON output use the Google Benchmark names, so its compare tools can read the results.
+ */
+class Microbench
+{
+public:
+    using Function = void (*)(uint64_t iterations);
+
+    static int run(int argc, char **argv);
+    static void add(const char *name, Function function, size_t bytes = 0);
+
+    template<typename T>
+    static inline void doNotOptimize(const T &value)
+    {
+#       ifdef _MSC_VER
+        m_sink = *reinterpret_cast<const volatile char *>(&value);
+        _ReadWriteBarrier();
+#       else
+        asm volatile("" : : "r,m"(value) : "memory");
+#       endif
+    }
+
+private:
+    struct Case
+    {
+        const char *name;
+        Function function;
+        size_t bytes;
+    };
+
+    static std::vector<Case> &cases();
+
+#   ifdef _MSC_VER
+    static volatile char m_sink;
+#   endif
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_MICROBENCH_H */
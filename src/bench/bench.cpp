@@ -0,0 +1,385 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * xmrig-proxy-bench: deterministic load generator for the stratum path, see doc/BENCHMARK.md.
+ *
+ * The fake pool, the simulated miners and the real proxy (Server, Miner, Events, splitters) share one event loop,
+ * so the numbers include the cost of the simulation itself and are meant for comparing builds on the same machine.
+ */
+
+
+#include "base/kernel/Process.h"
+#include "bench/BenchMiner.h"
+#include "bench/BenchPool.h"
+#include "bench/BenchStats.h"
+#include "core/Controller.h"
+#include "proxy/Metrics.h"
+#include "proxy/StatsData.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace xmrig;
+
+
+namespace {
+
+
+struct Options
+{
+    bool json                   = false;
+    const char *mode            = "nicehash";
+    uint64_t blockInterval      = 5000;
+    uint64_t duration           = 30;
+    uint64_t keepAliveInterval  = 0;
+    uint64_t loginTimeout       = 30;
+    uint64_t ramp               = 100;
+    uint64_t submitInterval     = 1000;
+    uint16_t port               = 0;
+    size_t miners               = 1000;
+};
+
+
+struct Bench
+{
+    BenchStats stats;
+    Controller *controller      = nullptr;
+    Options options;
+    size_t firstBlock           = 0;
+    sockaddr_in addr{};
+    std::unique_ptr<BenchPool> pool;
+    std::vector<std::unique_ptr<BenchMiner>> miners;
+    uint64_t proxyAccepted      = 0;
+    uint64_t started            = 0;
+    uint64_t startedAt          = 0;
+    uv_timer_t blockTimer{};
+    uv_timer_t controlTimer{};
+    uv_timer_t rampTimer{};
+};
+
+
+static Bench bench;
+
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --miners N              number of simulated miners (1000)\n"
+            "  --duration S            measurement time in seconds, after all miners logged in (30)\n"
+            "  --submit-interval MS    time between shares of one miner (1000)\n"
+            "  --keepalive-interval MS time between keepalived requests of one miner, 0 to disable (0)\n"
+            "  --block-interval MS     time between new jobs from the pool (5000)\n"
+            "  --ramp N                miners connected per 10 ms during startup (100)\n"
+            "  --mode MODE             proxy mode: nicehash or simple (nicehash)\n"
+            "  --port N                proxy bind port, 0 for any free port (0)\n"
+            "  --json                  print results as a single JSON object\n",
+            name);
+}
+
+
+static bool parse(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *arg   = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--json") == 0) {
+            options.json = true;
+            continue;
+        }
+
+        if (!value) {
+            return false;
+        }
+
+        ++i;
+
+        if (strcmp(arg, "--miners") == 0) {
+            options.miners = strtoul(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--duration") == 0) {
+            options.duration = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--submit-interval") == 0) {
+            options.submitInterval = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--keepalive-interval") == 0) {
+            options.keepAliveInterval = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--block-interval") == 0) {
+            options.blockInterval = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--ramp") == 0) {
+            options.ramp = std::max<uint64_t>(strtoull(value, nullptr, 10), 1);
+        }
+        else if (strcmp(arg, "--mode") == 0) {
+            options.mode = value;
+        }
+        else if (strcmp(arg, "--port") == 0) {
+            options.port = static_cast<uint16_t>(strtoul(value, nullptr, 10));
+        }
+        else {
+            return false;
+        }
+    }
+
+    return options.miners > 0 && options.duration > 0;
+}
+
+
+static uint16_t freePort()
+{
+    uv_tcp_t tcp;
+    uv_tcp_init(uv_default_loop(), &tcp);
+
+    sockaddr_in addr{};
+    uv_ip4_addr("127.0.0.1", 0, &addr);
+
+    int size = sizeof(addr);
+    if (uv_tcp_bind(&tcp, reinterpret_cast<const sockaddr *>(&addr), 0) != 0 || uv_tcp_getsockname(&tcp, reinterpret_cast<sockaddr *>(&addr), &size) != 0) {
+        addr.sin_port = 0;
+    }
+
+    uv_close(reinterpret_cast<uv_handle_t*>(&tcp), nullptr);
+    uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+
+    return ntohs(addr.sin_port);
+}
+
+
+static double percentile(std::vector<double> &values, double p)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(index), values.end());
+
+    return values[index];
+}
+
+
+static void report()
+{
+    const BenchStats &stats = bench.stats;
+    const double elapsed    = static_cast<double>(uv_hrtime() - bench.startedAt) / 1e9;
+
+    std::vector<double> rtt;
+    rtt.reserve(stats.rtt.size());
+
+    for (uint32_t value : stats.rtt) {
+        rtt.push_back(value / 1000.0);
+    }
+
+    // Fan-out of a block is the time from the pool sending the job until the last connected miner got it.
+    const size_t expected = static_cast<size_t>(stats.loggedIn > stats.closed ? stats.loggedIn - stats.closed : 0);
+    std::vector<double> fanout;
+    size_t incomplete = 0;
+
+    for (size_t i = bench.firstBlock; i < stats.blocks.size(); ++i) {
+        if (stats.received[i] >= expected && expected > 0) {
+            fanout.push_back(static_cast<double>(stats.lastReceived[i] - stats.blocks[i]) / 1e6);
+        }
+        else {
+            ++incomplete;
+        }
+    }
+
+    const double maxRtt    = rtt.empty() ? 0.0 : *std::max_element(rtt.begin(), rtt.end());
+    const double maxFanout = fanout.empty() ? 0.0 : *std::max_element(fanout.begin(), fanout.end());
+    const double p50Rtt    = percentile(rtt, 0.5);
+    const double p99Rtt    = percentile(rtt, 0.99);
+    const double p50Fanout = percentile(fanout, 0.5);
+    const double p99Fanout = percentile(fanout, 0.99);
+    const double setJob    = Metrics::fanout().count() ? Metrics::fanout().sum() * 1000.0 / static_cast<double>(Metrics::fanout().count()) : 0.0;
+    const uint64_t proxy   = bench.controller->statsData().accepted - bench.proxyAccepted;
+
+    double phases[Metrics::PhaseMax];
+    for (size_t i = 0; i < Metrics::PhaseMax; ++i) {
+        const Histogram &histogram = Metrics::phase(static_cast<Metrics::Phase>(i));
+        phases[i] = histogram.count() ? histogram.sum() * 1e6 / static_cast<double>(histogram.count()) : 0.0;
+    }
+
+    size_t rss = 0;
+    uv_resident_set_memory(&rss);
+
+    if (bench.options.json) {
+        printf("{\"mode\":\"%s\",\"miners\":%zu,\"logged_in\":%" PRIu64 ",\"closed\":%" PRIu64 ",\"upstreams\":%zu,\"duration\":%.3f,"
+               "\"accepted\":%" PRIu64 ",\"rejected\":%" PRIu64 ",\"accepts_per_sec\":%.2f,\"pool_shares\":%" PRIu64 ",\"proxy_accepted\":%" PRIu64 ",\"keepalived\":%" PRIu64 ","
+               "\"submit_rtt_ms\":{\"p50\":%.3f,\"p99\":%.3f,\"max\":%.3f},"
+               "\"fanout_ms\":{\"blocks\":%zu,\"incomplete\":%zu,\"p50\":%.3f,\"p99\":%.3f,\"max\":%.3f},"
+               "\"set_job_ms\":%.3f,\"phases_us\":{\"parse\":%.2f,\"dispatch\":%.2f,\"serialize\":%.3f,\"enqueue\":%.3f},\"rss\":%zu}\n",
+               bench.options.mode, bench.options.miners, stats.loggedIn, stats.closed, bench.pool->sessions(), elapsed,
+               stats.accepted, stats.rejected, stats.accepted / elapsed, stats.poolShares, proxy, stats.keepalived,
+               p50Rtt, p99Rtt, maxRtt,
+               fanout.size(), incomplete, p50Fanout, p99Fanout, maxFanout,
+               setJob, phases[Metrics::PhaseParse], phases[Metrics::PhaseDispatch], phases[Metrics::PhaseSerialize], phases[Metrics::PhaseEnqueue], rss);
+
+        return;
+    }
+
+    printf("mode          %s, %" PRIu64 "/%zu miners logged in, %" PRIu64 " closed, %zu upstreams\n", bench.options.mode, stats.loggedIn, bench.options.miners, stats.closed, bench.pool->sessions());
+    printf("duration      %.3f s\n", elapsed);
+    printf("accepted      %" PRIu64 " (%.2f/s), rejected %" PRIu64 ", pool shares %" PRIu64 ", proxy accepted %" PRIu64 "\n", stats.accepted, stats.accepted / elapsed, stats.rejected, stats.poolShares, proxy);
+    printf("submit rtt    p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", p50Rtt, p99Rtt, maxRtt);
+    printf("job fan-out   %zu blocks (%zu incomplete), p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", fanout.size(), incomplete, p50Fanout, p99Fanout, maxFanout);
+    printf("set job       %.3f ms avg per upstream job\n", setJob);
+    printf("job phases    parse %.2f us, dispatch %.2f us, serialize %.3f us and enqueue %.3f us per miner\n",
+           phases[Metrics::PhaseParse], phases[Metrics::PhaseDispatch], phases[Metrics::PhaseSerialize], phases[Metrics::PhaseEnqueue]);
+    printf("rss           %.1f MB\n", static_cast<double>(rss) / 1024.0 / 1024.0);
+}
+
+
+static void shutdown()
+{
+    uv_timer_stop(&bench.blockTimer);
+    uv_timer_stop(&bench.controlTimer);
+    uv_timer_stop(&bench.rampTimer);
+
+    for (auto &miner : bench.miners) {
+        miner->stop();
+    }
+
+    bench.pool->close();
+    bench.controller->stop();
+
+    uv_stop(uv_default_loop());
+}
+
+
+static void onBlockTimer(uv_timer_t *)
+{
+    bench.pool->newBlock();
+}
+
+
+static void onControlTimer(uv_timer_t *)
+{
+    const uint64_t now = uv_hrtime();
+
+    if (!bench.stats.measuring) {
+        const bool ready = bench.miners.size() == bench.options.miners && bench.stats.loggedIn + bench.stats.closed >= bench.options.miners;
+
+        if (!ready && now - bench.started < bench.options.loginTimeout * 1000000000ULL) {
+            return;
+        }
+
+        if (!ready) {
+            fprintf(stderr, "only %" PRIu64 " of %zu miners logged in, measuring anyway\n", bench.stats.loggedIn, bench.options.miners);
+        }
+
+        bench.stats.reset();
+        bench.stats.measuring = true;
+        bench.startedAt       = now;
+        bench.firstBlock      = bench.stats.blocks.size();
+        bench.proxyAccepted   = bench.controller->statsData().accepted;
+
+        uv_timer_start(&bench.blockTimer, onBlockTimer, 0, bench.options.blockInterval);
+
+        return;
+    }
+
+    if (now - bench.startedAt >= bench.options.duration * 1000000000ULL) {
+        report();
+        shutdown();
+    }
+}
+
+
+static void onRampTimer(uv_timer_t *)
+{
+    const Options &options = bench.options;
+
+    for (uint64_t i = 0; i < options.ramp && bench.miners.size() < options.miners; ++i) {
+        const size_t index = bench.miners.size();
+
+        // Shares are spread evenly over the submit interval, so the load does not come in bursts.
+        std::unique_ptr<BenchMiner> miner(new BenchMiner(index, bench.stats));
+        miner->start(reinterpret_cast<const sockaddr *>(&bench.addr), options.submitInterval, options.submitInterval * index / options.miners, options.keepAliveInterval);
+
+        bench.miners.push_back(std::move(miner));
+    }
+
+    if (bench.miners.size() == options.miners) {
+        uv_timer_stop(&bench.rampTimer);
+    }
+}
+
+
+} // namespace
+
+
+int main(int argc, char **argv)
+{
+    if (!parse(argc, argv, bench.options)) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    bench.pool.reset(new BenchPool(bench.stats));
+    if (!bench.pool->bind()) {
+        fprintf(stderr, "failed to bind fake pool\n");
+
+        return 1;
+    }
+
+    const uint16_t port = bench.options.port ? bench.options.port : freePort();
+    uv_ip4_addr("127.0.0.1", port, &bench.addr);
+
+    const std::string url  = "127.0.0.1:" + std::to_string(bench.pool->port());
+    const std::string bind = "127.0.0.1:" + std::to_string(port);
+
+    // The proxy is configured only from the command line, -B disables the console output.
+    std::vector<const char *> args = { argv[0], "-B", "--no-color", "--donate-level", "0", "-m", bench.options.mode, "-o", url.c_str(), "-b", bind.c_str() };
+    Process process(static_cast<int>(args.size()), const_cast<char **>(args.data()));
+
+    std::unique_ptr<Controller> controller(new Controller(&process));
+    if (!controller->isReady() || controller->init() != 0) {
+        fprintf(stderr, "invalid proxy configuration\n");
+
+        return 1;
+    }
+
+    bench.controller = controller.get();
+    bench.controller->start();
+    bench.started = uv_hrtime();
+
+    uv_timer_init(uv_default_loop(), &bench.blockTimer);
+    uv_timer_init(uv_default_loop(), &bench.controlTimer);
+    uv_timer_init(uv_default_loop(), &bench.rampTimer);
+
+    uv_timer_start(&bench.rampTimer, onRampTimer, 100, 10);
+    uv_timer_start(&bench.controlTimer, onControlTimer, 100, 100);
+
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+
+    return 0;
+}
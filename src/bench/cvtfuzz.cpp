@@ -0,0 +1,134 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * xmrig-proxy-cvt-fuzz: compares every SIMD hex kernel supported by this CPU with the scalar code on random input.
+ */
+
+
+#include "base/tools/CvtKernels.h"
+
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+using namespace xmrig;
+
+
+static const char kAlphabet[] = "0123456789abcdefABCDEF";
+
+
+static bool checkFromHex(cvt::Isa isa, std::mt19937_64 &rng)
+{
+    // Mostly valid hex with a chance of one bad character anywhere, lengths cover several SIMD blocks and the tails.
+    const size_t size = rng() % 600;
+    std::vector<char> hex(size + 1);
+
+    for (size_t i = 0; i < size; ++i) {
+        hex[i] = kAlphabet[rng() % (sizeof(kAlphabet) - 1)];
+    }
+
+    if (size && rng() % 4 == 0) {
+        hex[rng() % size] = static_cast<char>(rng() % 256);
+    }
+
+    size_t maxlen = size / 2;
+    if (rng() % 8 == 0) {
+        maxlen = rng() % (size / 2 + 2);
+    }
+
+    std::vector<uint8_t> expected(maxlen + 1, 0);
+    std::vector<uint8_t> actual(maxlen + 1, 0);
+
+    const bool a = cvt::fromHex(cvt::SCALAR, expected.data(), maxlen, hex.data(), size);
+    const bool b = cvt::fromHex(isa, actual.data(), maxlen, hex.data(), size);
+
+    if (a == b && (!a || memcmp(expected.data(), actual.data(), size / 2) == 0)) {
+        return true;
+    }
+
+    fprintf(stderr, "%s fromHex mismatch: size %zu, maxlen %zu, scalar %d, simd %d, input \"%.*s\"\n", cvt::isaName(isa), size, maxlen, a, b, static_cast<int>(size), hex.data());
+
+    return false;
+}
+
+
+static bool checkToHex(cvt::Isa isa, std::mt19937_64 &rng)
+{
+    const size_t size = rng() % 500;
+    std::vector<uint8_t> bin(size + 1);
+
+    for (size_t i = 0; i < size; ++i) {
+        bin[i] = static_cast<uint8_t>(rng());
+    }
+
+    size_t maxlen = size * 2 + 1;
+    if (rng() % 8 == 0) {
+        maxlen = rng() % (size * 2 + 2);
+    }
+
+    std::vector<char> expected(maxlen + 1, 'x');
+    std::vector<char> actual(maxlen + 1, 'x');
+
+    const bool a = cvt::toHex(cvt::SCALAR, expected.data(), maxlen, bin.data(), size);
+    const bool b = cvt::toHex(isa, actual.data(), maxlen, bin.data(), size);
+
+    if (a == b && expected == actual) {
+        return true;
+    }
+
+    fprintf(stderr, "%s toHex mismatch: size %zu, maxlen %zu, scalar %d, simd %d\n", cvt::isaName(isa), size, maxlen, a, b);
+
+    return false;
+}
+
+
+int main(int argc, char **argv)
+{
+    const uint64_t iterations = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    const uint64_t seed       = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1;
+    int rc                    = 0;
+
+    for (int i = cvt::SCALAR + 1; i < cvt::ISA_MAX; ++i) {
+        const auto isa = static_cast<cvt::Isa>(i);
+        if (!cvt::isSupported(isa)) {
+            continue;
+        }
+
+        std::mt19937_64 rng(seed);
+        uint64_t failed = 0;
+
+        for (uint64_t n = 0; n < iterations && failed < 10; ++n) {
+            failed += checkFromHex(isa, rng) ? 0 : 1;
+            failed += checkToHex(isa, rng) ? 0 : 1;
+        }
+
+        printf("%-8s %s\n", cvt::isaName(isa), failed ? "FAILED" : "OK");
+        rc |= failed ? 1 : 0;
+    }
+
+    printf("default  %s\n", cvt::isaName(cvt::best()));
+
+    return rc;
+}
@@ -0,0 +1,342 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * xmrig-proxy-microbench: microbenchmarks of the per share and per job primitives, see doc/BENCHMARK.md.
+ *
+ * All inputs are generated from fixed patterns, results do not depend on the network or on random numbers.
+ */
+
+
+#include "base/crypto/keccak.h"
+#include "base/kernel/interfaces/ILineListener.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/tools/LineReader.h"
+#include "base/tools/cryptonote/BlockTemplate.h"
+#include "base/tools/Cvt.h"
+#include "base/tools/CvtKernels.h"
+#include "bench/Microbench.h"
+#include "net/JobResult.h"
+
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+using namespace xmrig;
+
+
+namespace {
+
+
+static const char *kBlob   = "1010a0b7f5a106a52e6fcf8b8bef8bdf20fbdd6aaa9ef2e0ea8e2ef2f79f8bde1dea0b7b80e1ea00000000c64ee6a8e16cab1d83f0b36bcf3d2f2f5f9b0bae26c0ebc1d12bd8f5d2f9e3a401";
+static const char *kResult = "e5e2f8a8f83e3bf9de6ff5a7cbd14ae2bd1a1b6dd3c5f6e0ba4c3b6f7a5d0100";
+
+
+class LineCounter : public ILineListener
+{
+public:
+    inline void onLine(char *, size_t size) override { lines++; bytes += size; }
+
+    size_t bytes = 0;
+    size_t lines = 0;
+};
+
+
+static std::vector<uint8_t> pattern(size_t size)
+{
+    std::vector<uint8_t> out(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    return out;
+}
+
+
+static void varint(std::vector<uint8_t> &out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+
+// Monero v16 block template with a tagged key coinbase output and 16 other transactions.
+static std::string blockTemplate()
+{
+    const std::vector<uint8_t> hashes = pattern(32 * 17);
+    std::vector<uint8_t> b;
+
+    varint(b, 16);
+    varint(b, 16);
+    varint(b, 1700000000);
+    b.insert(b.end(), hashes.begin(), hashes.begin() + 32);
+    b.insert(b.end(), 4, 0);
+
+    varint(b, 2);
+    varint(b, 3000060);
+    varint(b, 1);
+    b.push_back(0xFF);
+    varint(b, 3000000);
+    varint(b, 1);
+    varint(b, 600000000000ULL);
+    b.push_back(3);
+    b.insert(b.end(), hashes.begin() + 1, hashes.begin() + 33);
+    b.push_back(0x5A);
+
+    varint(b, 1 + 32 + 2 + 8);
+    b.push_back(0x01);
+    b.insert(b.end(), hashes.begin() + 2, hashes.begin() + 34);
+    b.push_back(0x02);
+    b.push_back(8);
+    b.insert(b.end(), 8, 0);
+    b.push_back(0);
+
+    varint(b, 16);
+    b.insert(b.end(), hashes.begin() + 32, hashes.end());
+
+    return Cvt::toHex(b.data(), b.size()).data();
+}
+
+
+static std::string submits()
+{
+    std::string out;
+    char buf[256];
+
+    for (int i = 0; i < 64; ++i) {
+        snprintf(buf, sizeof(buf), "{\"id\":%d,\"jsonrpc\":\"2.0\",\"method\":\"submit\",\"params\":{\"id\":\"d2b5a8f1-4ac3\",\"job_id\":\"%d\",\"nonce\":\"%08x\",\"result\":\"%s\"}}\n",
+                 i + 2, 1000 + i, i * 2654435761U, kResult);
+        out += buf;
+    }
+
+    return out;
+}
+
+
+// Up to Job::kMaxBlobSize bytes, the largest blob the proxy converts.
+static const std::vector<uint8_t> &binary()
+{
+    static const std::vector<uint8_t> data = pattern(Job::kMaxBlobSize);
+    return data;
+}
+
+
+static const std::string &hexString()
+{
+    static const std::string data = Cvt::toHex(binary().data(), binary().size()).data();
+    return data;
+}
+
+
+template<size_t N>
+static void toHex(uint64_t iterations)
+{
+    char hex[N * 2 + 1];
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Cvt::toHex(hex, sizeof(hex), binary().data(), N);
+        Microbench::doNotOptimize(hex);
+    }
+}
+
+
+template<size_t N>
+static void fromHex(uint64_t iterations)
+{
+    uint8_t bin[N];
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Microbench::doNotOptimize(Cvt::fromHex(bin, sizeof(bin), hexString().data(), N * 2));
+        Microbench::doNotOptimize(bin);
+    }
+}
+
+
+// Scalar baseline of the SIMD codec used by Cvt.
+template<size_t N>
+static void toHexScalar(uint64_t iterations)
+{
+    char hex[N * 2 + 1];
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        cvt::toHex(cvt::SCALAR, hex, sizeof(hex), binary().data(), N);
+        Microbench::doNotOptimize(hex);
+    }
+}
+
+
+template<size_t N>
+static void fromHexScalar(uint64_t iterations)
+{
+    uint8_t bin[N];
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Microbench::doNotOptimize(cvt::fromHex(cvt::SCALAR, bin, sizeof(bin), hexString().data(), N * 2));
+        Microbench::doNotOptimize(bin);
+    }
+}
+
+
+template<size_t N>
+static void keccak(uint64_t iterations)
+{
+    const std::vector<uint8_t> in = pattern(N);
+    uint8_t state[200];
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        xmrig::keccak(in.data(), in.size(), state);
+        Microbench::doNotOptimize(state);
+    }
+}
+
+
+// 64 submit requests delivered in 1460 bytes chunks, like TCP segments; the copy is needed because parsing is in place.
+static void lineReader(uint64_t iterations)
+{
+    static const std::string input = submits();
+    std::string buf(input.size(), '\0');
+    LineCounter counter;
+    LineReader reader(&counter);
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        memcpy(&buf[0], input.data(), input.size());
+
+        for (size_t offset = 0; offset < buf.size(); offset += 1460) {
+            reader.parse(&buf[offset], std::min<size_t>(1460, buf.size() - offset));
+        }
+    }
+
+    Microbench::doNotOptimize(counter.lines);
+}
+
+
+static void jobSetBlob(uint64_t iterations)
+{
+    Job job(true, Algorithm::RX_0, "bench");
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Microbench::doNotOptimize(job.setBlob(kBlob));
+    }
+}
+
+
+static Job makeJob()
+{
+    Job job(true, Algorithm::RX_0, "bench");
+    job.setBlob(kBlob);
+    job.setTarget("b88d0600");
+    job.setId("1234567890");
+    job.setSeedHash("a52e6fcf8b8bef8bdf20fbdd6aaa9ef2e0ea8e2ef2f79f8bde1dea0b7b80e1ea");
+    job.setHeight(3000000);
+
+    return job;
+}
+
+
+static void jobCopy(uint64_t iterations)
+{
+    const Job job = makeJob();
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Job copy(job);
+        Microbench::doNotOptimize(copy);
+    }
+}
+
+
+static void jobMove(uint64_t iterations)
+{
+    Job a = makeJob();
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Job b(std::move(a));
+        a = std::move(b);
+        Microbench::doNotOptimize(a);
+    }
+}
+
+
+static void blockTemplateParse(uint64_t iterations)
+{
+    static const std::string hex = blockTemplate();
+    BlockTemplate bt;
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Microbench::doNotOptimize(bt.parse(hex.data(), hex.size(), Coin::MONERO, true));
+    }
+}
+
+
+static void jobResultDiff(uint64_t iterations)
+{
+    const Algorithm algorithm(Algorithm::RX_0);
+
+    for (uint64_t i = 0; i < iterations; ++i) {
+        JobResult result(static_cast<int64_t>(i), "1234567890", "0a1b2c3d", kResult, algorithm, nullptr, nullptr, nullptr, 0, -1);
+        Microbench::doNotOptimize(result.actualDiff());
+    }
+}
+
+
+} // namespace
+
+
+int main(int argc, char **argv)
+{
+    {
+        const std::string hex = blockTemplate();
+        BlockTemplate bt;
+        Job job = makeJob();
+
+        if (!bt.parse(hex.data(), hex.size(), Coin::MONERO, true) || !job.isValid() || JobResult(1, "1", "0a1b2c3d", kResult, Algorithm::RX_0, nullptr, nullptr, nullptr, 0, -1).actualDiff() == 0) {
+            fprintf(stderr, "invalid benchmark fixtures\n");
+
+            return 1;
+        }
+    }
+
+    Microbench::add("Cvt/toHex/4",             toHex<4>,            4);
+    Microbench::add("Cvt/toHex/32",            toHex<32>,           32);
+    Microbench::add("Cvt/toHex/76",            toHex<76>,           76);
+    Microbench::add("Cvt/toHex/408",           toHex<408>,          408);
+    Microbench::add("Cvt/toHex/408/scalar",    toHexScalar<408>,    408);
+    Microbench::add("Cvt/fromHex/4",           fromHex<4>,          4);
+    Microbench::add("Cvt/fromHex/32",          fromHex<32>,         32);
+    Microbench::add("Cvt/fromHex/76",          fromHex<76>,         76);
+    Microbench::add("Cvt/fromHex/408",         fromHex<408>,        408);
+    Microbench::add("Cvt/fromHex/408/scalar",  fromHexScalar<408>,  408);
+    Microbench::add("keccak/76",               keccak<76>,          76);
+    Microbench::add("keccak/1024",             keccak<1024>,        1024);
+    Microbench::add("LineReader/parse",        lineReader,          submits().size());
+    Microbench::add("Job/setBlob",             jobSetBlob,          strlen(kBlob));
+    Microbench::add("Job/copy",                jobCopy);
+    Microbench::add("Job/move",                jobMove);
+    Microbench::add("BlockTemplate/parse",     blockTemplateParse,  blockTemplate().size());
+    Microbench::add("JobResult/diff",          jobResultDiff);
+
+    return Microbench::run(argc, argv);
+}
@@ -69,6 +69,14 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     m_reuseTimeout = reader.getInt("reuse-timeout", m_reuseTimeout);
     m_accessLog    = reader.getString("access-log-file");
     m_password     = reader.getString("access-password");
+    m_shareJournal = reader.getString("share-journal");
+    m_shareJournalSegment = reader.getUint("share-journal-segment", m_shareJournalSegment);
+    m_stateFile           = reader.getString("state-file");
+    m_stateInterval       = reader.getUint("state-interval", m_stateInterval);
+    m_metricsWorkers      = reader.getUint("metrics-workers", m_metricsWorkers);
+    m_slowJobThreshold    = reader.getUint("slow-job-threshold", m_slowJobThreshold);
+    m_reloadBatch         = reader.getUint("reload-batch", m_reloadBatch);
+    m_reloadDelay         = reader.getUint("reload-delay", m_reloadDelay);
 
     setCustomDiff(reader.getUint64("custom-diff", m_diff));
     setMode(reader.getString("mode"));
@@ -132,11 +140,24 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember("custom-diff-stats",              m_customDiffStats, allocator);
     doc.AddMember(StringRef(Pools::kDonateLevel),   m_pools.donateLevel(), allocator);
     doc.AddMember(StringRef(kLogFile),              m_logFile.toJSON(), allocator);
+    doc.AddMember(StringRef(kLogFsync),             m_logFsync, allocator);
+    doc.AddMember(StringRef(kLogRotateCompress),    m_logRotateCompress, allocator);
+    doc.AddMember(StringRef(kLogRotateInterval),    m_logRotateInterval, allocator);
+    doc.AddMember(StringRef(kLogRotateSize),        m_logRotateSize, allocator);
     doc.AddMember("mode",                           StringRef(modeName()), allocator);
     doc.AddMember(StringRef(Pools::kPools),         m_pools.toJSON(doc), allocator);
+    doc.AddMember(StringRef(Pools::kStrategy),      StringRef(m_pools.strategyName()), allocator);
     doc.AddMember(StringRef(Pools::kRetries),       m_pools.retries(), allocator);
     doc.AddMember(StringRef(Pools::kRetryPause),    m_pools.retryPause(), allocator);
+    doc.AddMember("reload-batch",                   m_reloadBatch, allocator);
+    doc.AddMember("reload-delay",                   m_reloadDelay, allocator);
     doc.AddMember("reuse-timeout",                  reuseTimeout(), allocator);
+    doc.AddMember("share-journal",                  m_shareJournal.toJSON(), allocator);
+    doc.AddMember("share-journal-segment",          m_shareJournalSegment, allocator);
+    doc.AddMember("state-file",                     m_stateFile.toJSON(), allocator);
+    doc.AddMember("state-interval",                 m_stateInterval, allocator);
+    doc.AddMember("metrics-workers",                m_metricsWorkers, allocator);
+    doc.AddMember("slow-job-threshold",             m_slowJobThreshold, allocator);
 
 #   ifdef XMRIG_FEATURE_TLS
     doc.AddMember(StringRef(kTls),                  m_tls.toJSON(doc), allocator);
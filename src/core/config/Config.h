@@ -65,9 +65,17 @@ public:
     inline const BindHosts &bind() const           { return m_bind; }
     inline const String &accessLog() const         { return m_accessLog; }
     inline const String &password() const          { return m_password; }
+    inline const String &shareJournal() const      { return m_shareJournal; }
+    inline const String &stateFile() const         { return m_stateFile; }
     inline int mode() const                        { return m_mode; }
     inline int reuseTimeout() const                { return m_reuseTimeout; }
     inline static IConfig *create()                { return new Config(); }
+    inline uint32_t metricsWorkers() const         { return m_metricsWorkers; }
+    inline uint32_t reloadBatch() const            { return m_reloadBatch; }
+    inline uint32_t reloadDelay() const            { return m_reloadDelay; }
+    inline uint32_t shareJournalSegment() const    { return m_shareJournalSegment; }
+    inline uint32_t slowJobThreshold() const       { return m_slowJobThreshold; }
+    inline uint32_t stateInterval() const          { return m_stateInterval; }
     inline uint64_t diff() const                   { return m_diff; }
     inline Workers::Mode workersMode() const       { return m_workersMode; }
 
@@ -84,6 +92,14 @@ private:
     int m_reuseTimeout          = 0;
     String m_accessLog;
     String m_password;
+    String m_shareJournal;
+    String m_stateFile;
+    uint32_t m_metricsWorkers   = 100;
+    uint32_t m_reloadBatch      = 16;
+    uint32_t m_reloadDelay      = 2;
+    uint32_t m_shareJournalSegment = 64;
+    uint32_t m_slowJobThreshold = 0;
+    uint32_t m_stateInterval    = 60;
     uint64_t m_diff             = 0;
     Workers::Mode m_workersMode = Workers::RigID;
 };
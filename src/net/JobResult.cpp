@@ -48,14 +48,15 @@ xmrig::JobResult::JobResult(int64_t id, const char *jobId, const char *nonce, co
 }
 
 
-bool xmrig::JobResult::isCompatible(uint8_t fixedByte) const
+bool xmrig::JobResult::isCompatible(uint8_t fixedByte, uint32_t slots) const
 {
     uint8_t n[4];
     if (!Cvt::fromHex(n, sizeof(n), nonce, 8)) {
         return false;
     }
 
-    return n[3] == fixedByte;
+    // Cascaded proxy owns a block of consecutive fixed byte values starting at fixedByte.
+    return static_cast<uint8_t>(n[3] - fixedByte) < slots;
 }
 
 
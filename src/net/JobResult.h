@@ -39,7 +39,7 @@ public:
     JobResult() = default;
     JobResult(int64_t id, const char *jobId, const char *nonce, const char *result, const xmrig::Algorithm &algorithm, const char* sig, const char* sig_data, const char* commitment, uint8_t view_tag, int64_t extra_nonce);
 
-    bool isCompatible(uint8_t fixedByte) const;
+    bool isCompatible(uint8_t fixedByte, uint32_t slots = 1) const;
     bool isValid() const;
 
     inline uint64_t actualDiff() const { return m_actualDiff; }
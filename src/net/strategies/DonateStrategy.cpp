@@ -92,6 +92,9 @@ void xmrig::DonateStrategy::save(const IClient *client, const Job &job)
     m_pending.job  = job;
     m_pending.host = client->pool().host();
     m_pending.port = client->pool().port();
+
+    // The job is sent to miners only after the donation round, its receive time is meaningless for propagation metrics.
+    m_pending.job.setTimestamps(0.0, 0.0);
 }
 
 
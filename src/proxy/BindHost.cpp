@@ -30,9 +30,12 @@
 
 #include "proxy/BindHost.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
 
 
 xmrig::BindHost::BindHost(const char *addr) :
+    m_cascade(false),
+    m_mux(false),
     m_tls(false),
     m_version(0),
     m_port(0)
@@ -51,6 +54,8 @@ xmrig::BindHost::BindHost(const char *addr) :
 
 
 xmrig::BindHost::BindHost(const char *host, uint16_t port, int version) :
+    m_cascade(false),
+    m_mux(false),
     m_tls(false),
     m_version(version),
     m_port(port),
@@ -60,6 +65,8 @@ xmrig::BindHost::BindHost(const char *host, uint16_t port, int version) :
 
 
 xmrig::BindHost::BindHost(const rapidjson::Value &object) :
+    m_cascade(false),
+    m_mux(false),
     m_tls(false),
     m_version(0),
     m_port(0)
@@ -68,8 +75,10 @@ xmrig::BindHost::BindHost(const rapidjson::Value &object) :
         return;
     }
 
-    m_port = object["port"].GetUint();
-    m_tls  = object["tls"].GetBool();
+    m_port    = object["port"].GetUint();
+    m_tls     = object["tls"].GetBool();
+    m_cascade = Json::getBool(object, "cascade");
+    m_mux     = Json::getBool(object, "mux");
 }
 
 
@@ -81,9 +90,11 @@ rapidjson::Value xmrig::BindHost::toJSON(rapidjson::Document &doc) const
 
     Value obj(kObjectType);
 
-    obj.AddMember("host", StringRef(host()), allocator);
-    obj.AddMember("port", port(), allocator);
-    obj.AddMember("tls",  isTLS(), allocator);
+    obj.AddMember("host",    StringRef(host()), allocator);
+    obj.AddMember("port",    port(), allocator);
+    obj.AddMember("tls",     isTLS(), allocator);
+    obj.AddMember("cascade", isCascade(), allocator);
+    obj.AddMember("mux",     isMux(), allocator);
 
     return obj;
 }
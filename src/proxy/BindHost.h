@@ -44,6 +44,8 @@ public:
 
 
     inline BindHost() :
+        m_cascade(false),
+        m_mux(false),
         m_tls(false),
         m_version(0),
         m_port(0)
@@ -56,7 +58,9 @@ public:
 
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
 
+    inline bool isCascade() const   { return m_cascade; }
     inline bool isIPv6() const      { return m_version == 6; }
+    inline bool isMux() const       { return m_mux; }
     inline bool isTLS() const       { return m_tls; }
     inline bool isValid() const     { return m_version && !m_host.isNull() && m_port > 0; }
     inline const char *host() const { return m_host.data(); }
@@ -68,6 +72,8 @@ private:
     void parseIPv4(const char *addr);
     void parseIPv6(const char *addr);
 
+    bool m_cascade;
+    bool m_mux;
     bool m_tls;
     int m_version;
     uint16_t m_port;
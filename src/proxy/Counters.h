@@ -57,6 +57,13 @@ public:
     }
 
 
+    static inline void restore(uint64_t maxMiners, uint64_t expired)
+    {
+        m_maxMiners      = maxMiners > m_maxMiners ? maxMiners : m_maxMiners;
+        Counters::expired = expired;
+    }
+
+
     static inline uint32_t added()     { return m_added; }
     static inline uint32_t removed()   { return m_removed; }
     static inline uint64_t maxMiners() { return m_maxMiners; }
@@ -39,6 +39,7 @@ static const char *kIncompatibleAlgorithm = "No compatible algorithm found, chan
 static const char *kIncorrectAlgorithm    = "Incorrect algorithm";
 static const char *kForbidden             = "Permission denied";
 static const char *kRouteNotFound         = "Algorithm negotiation failed";
+static const char *kTooManySessions       = "Too many sessions";
 
 } /* namespace xmrig */
 
@@ -77,6 +78,9 @@ const char *xmrig::Error::toString(int code)
     case RouteNotFound:
         return kRouteNotFound;
 
+    case TooManySessions:
+        return kTooManySessions;
+
     default:
         break;
     }
@@ -43,7 +43,8 @@ public:
         IncompatibleAlgorithm,
         IncorrectAlgorithm,
         Forbidden,
-        RouteNotFound
+        RouteNotFound,
+        TooManySessions
     };
 
     static const char *toString(int code);
@@ -0,0 +1,92 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_HISTOGRAM_H
+#define XMRIG_HISTOGRAM_H
+
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Cumulative histogram with fixed upper bounds, in the Prometheus/OpenMetrics sense.
+ */
+class Histogram
+{
+public:
+    inline Histogram(std::initializer_list<double> bounds) : m_bounds(bounds), m_counts(bounds.size(), 0) {}
+
+    inline const std::vector<double> &bounds() const    { return m_bounds; }
+    inline const std::vector<uint64_t> &counts() const  { return m_counts; }
+    inline double sum() const                           { return m_sum; }
+    inline uint64_t count() const                       { return m_count; }
+
+    inline void observe(double value)
+    {
+        const size_t index = static_cast<size_t>(std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin());
+        if (index < m_counts.size()) {
+            m_counts[index]++;
+        }
+
+        m_sum += value;
+        m_count++;
+    }
+
+    // Estimated quantile, linear interpolation inside the bucket like PromQL histogram_quantile().
+    inline double quantile(double q) const
+    {
+        if (m_count == 0 || m_bounds.empty()) {
+            return 0.0;
+        }
+
+        const double rank = q * static_cast<double>(m_count);
+        uint64_t total    = 0;
+
+        for (size_t i = 0; i < m_counts.size(); ++i) {
+            if (m_counts[i] == 0 || static_cast<double>(total + m_counts[i]) < rank) {
+                total += m_counts[i];
+                continue;
+            }
+
+            const double lower = i > 0 ? m_bounds[i - 1] : 0.0;
+
+            return lower + (m_bounds[i] - lower) * (rank - static_cast<double>(total)) / static_cast<double>(m_counts[i]);
+        }
+
+        return m_bounds.back();
+    }
+
+private:
+    double m_sum        = 0.0;
+    std::vector<double> m_bounds;
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count    = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_HISTOGRAM_H */
@@ -0,0 +1,105 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "proxy/JobTemplate.h"
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "base/net/stratum/Job.h"
+
+
+#include <cstdio>
+#include <cstring>
+
+
+xmrig::JobTemplate::JobTemplate(const Job &job)
+{
+    using namespace rapidjson;
+
+    if (!job.isValid() || job.hasMinerSignature() || job.hasViewTag()) {
+        return;
+    }
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    // Same layout as Miner::serializeJob() for a "job" notification.
+    Value params(kObjectType);
+    params.AddMember("blob",   StringRef(job.rawBlob()), allocator);
+    params.AddMember("job_id", StringRef(job.id().data()), allocator);
+    params.AddMember("target", StringRef(job.rawTarget()), allocator);
+    params.AddMember("algo",   StringRef(job.algorithm().name()), allocator);
+
+    if (job.height()) {
+        params.AddMember("height", job.height(), allocator);
+    }
+
+    if (!job.rawSeedHash().isNull()) {
+        params.AddMember("seed_hash", job.rawSeedHash().toJSON(), allocator);
+    }
+
+    const String &signatureKey = job.rawSigKey();
+    if (!signatureKey.isNull()) {
+        const char *key = signatureKey.size() == 192 ? (signatureKey.data() + 64) : signatureKey.data();
+        params.AddMember("sig_key", Value(key, allocator), allocator);
+    }
+
+    doc.AddMember("jsonrpc", "2.0", allocator);
+    doc.AddMember("method", "job", allocator);
+    doc.AddMember("params", params, allocator);
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    m_data.assign(buffer.GetString(), buffer.GetSize());
+    m_data.push_back('\n');
+
+    const size_t blob = m_data.find("\"blob\":\"");
+    if (blob == std::string::npos) {
+        m_data.clear();
+
+        return;
+    }
+
+    m_fixedByte = blob + 8 + (job.nonceOffset() + 3) * 2;
+}
+
+
+/**
+ * Copies the notification to the output buffer, with the nicehash fixed byte set if it is not negative.
+ * Returns the number of bytes written or -1 if the buffer is too small.
+ */
+int xmrig::JobTemplate::write(char *out, size_t size, int fixedByte) const
+{
+    if (!isValid() || m_data.size() >= size) {
+        return -1;
+    }
+
+    memcpy(out, m_data.data(), m_data.size());
+    out[m_data.size()] = '\0';
+
+    if (fixedByte >= 0) {
+        char hex[4];
+        snprintf(hex, sizeof(hex), "%02hhx", static_cast<uint8_t>(fixedByte));
+        memcpy(out + m_fixedByte, hex, 2);
+    }
+
+    return static_cast<int>(m_data.size());
+}
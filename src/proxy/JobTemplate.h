@@ -0,0 +1,59 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_JOBTEMPLATE_H
+#define XMRIG_JOBTEMPLATE_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace xmrig {
+
+
+class Job;
+
+
+/**
+ * Job notification pre-rendered once per upstream job and copied to every miner, only the nicehash fixed byte
+ * is patched per miner. Jobs with miner signatures or per miner data are not rendered, see isValid().
+ */
+class JobTemplate
+{
+public:
+    JobTemplate() = default;
+    JobTemplate(const Job &job);
+
+    inline bool isValid() const             { return !m_data.empty(); }
+    inline const std::string &data() const  { return m_data; }
+
+    int write(char *out, size_t size, int fixedByte = -1) const;
+
+private:
+    size_t m_fixedByte = 0;
+    std::string m_data;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_JOBTEMPLATE_H */
@@ -66,6 +66,10 @@ void xmrig::Login::login(LoginEvent *event)
     if (!password.isNull() && event->miner()->password() != password) {
         return reject(event, Error::toString(Error::Forbidden));
     }
+
+    if (event->miner()->requestedSlots() > 0 && !event->miner()->isCascadeAllowed()) {
+        return reject(event, Error::toString(Error::Forbidden));
+    }
 }
 
 
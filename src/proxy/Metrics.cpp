@@ -0,0 +1,417 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "proxy/Metrics.h"
+#include "api/v1/ApiSnapshot.h"
+#include "base/crypto/keccak.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/stratum/Pool.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/tools/Cvt.h"
+#include "proxy/events/AcceptEvent.h"
+#include "version.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace xmrig {
+
+
+const char *Metrics::kContentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+Histogram Metrics::m_fanout{ 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25 };
+Histogram Metrics::m_propagation{ 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1 };
+String Metrics::m_slowJobId;
+uint32_t Metrics::m_slowJob         = 0;
+uint64_t Metrics::m_slowJobHeight   = 0;
+uint64_t Metrics::m_slowJobs        = 0;
+
+Histogram Metrics::m_phases[Metrics::PhaseMax] = {
+    { 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1 },
+    { 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1 },
+    { 0.000001, 0.0000025, 0.000005, 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001 },
+    { 0.000001, 0.0000025, 0.000005, 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001 }
+};
+
+
+static const char *kPhaseNames[Metrics::PhaseMax] = { "parse", "dispatch", "serialize", "enqueue" };
+
+
+static const int kHashrateWindows[] = { 60, 600, 3600, 3600 * 12, 3600 * 24 };
+static constexpr size_t kMaxLabelSize = 128;
+
+
+// Formats straight into the output, a line longer than the first guess is formatted again with the exact size.
+static void append(std::string &out, const char *fmt, ...)
+{
+    constexpr size_t kReserve = 256;
+    const size_t offset       = out.size();
+
+    va_list args;
+    va_list copy;
+    va_start(args, fmt);
+    va_copy(copy, args);
+
+    out.resize(offset + kReserve);
+    int size = vsnprintf(&out[offset], kReserve, fmt, args);
+
+    if (size >= static_cast<int>(kReserve)) {
+        out.resize(offset + static_cast<size_t>(size) + 1);
+        size = vsnprintf(&out[offset], static_cast<size_t>(size) + 1, fmt, copy);
+    }
+
+    va_end(copy);
+    va_end(args);
+
+    out.resize(offset + static_cast<size_t>(std::max(size, 0)));
+}
+
+
+static void family(std::string &out, const char *name, const char *type, const char *help)
+{
+    append(out, "# TYPE %s %s\n# HELP %s %s\n", name, type, name, help);
+}
+
+
+// Values come from miners (worker names), long ones are cut at a UTF-8 character boundary and get a short hash
+// of the full value, so names with a common prefix still produce different series.
+static std::string label(const char *name, const char *value)
+{
+    std::string out(name);
+    out += "=\"";
+
+    for (const char *c = value; *c; ++c) {
+        if (static_cast<size_t>(c - value) >= kMaxLabelSize && (static_cast<uint8_t>(*c) & 0xC0) != 0x80) {
+            uint8_t hash[200];
+            char hex[9];
+
+            keccak(value, strlen(value), hash);
+            Cvt::toHex(hex, sizeof(hex), hash, 4);
+
+            out += '~';
+            out.append(hex, 8);
+            break;
+        }
+
+        switch (*c) {
+        case '\\':
+            out += "\\\\";
+            break;
+
+        case '"':
+            out += "\\\"";
+            break;
+
+        case '\n':
+            out += "\\n";
+            break;
+
+        default:
+            out += *c;
+            break;
+        }
+    }
+
+    out += '"';
+
+    return out;
+}
+
+
+static void histogram(std::string &out, const char *name, const Histogram &histogram, const std::string &labels)
+{
+    const char *sep = labels.empty() ? "" : ",";
+    uint64_t total  = 0;
+
+    for (size_t i = 0; i < histogram.bounds().size(); ++i) {
+        total += histogram.counts()[i];
+        append(out, "%s_bucket{%s%sle=\"%g\"} %" PRIu64 "\n", name, labels.c_str(), sep, histogram.bounds()[i], total);
+    }
+
+    append(out, "%s_bucket{%s%sle=\"+Inf\"} %" PRIu64 "\n", name, labels.c_str(), sep, histogram.count());
+    const std::string suffix = labels.empty() ? std::string() : "{" + labels + "}";
+
+    append(out, "%s_sum%s %.6f\n", name, suffix.c_str(), histogram.sum());
+    append(out, "%s_count%s %" PRIu64 "\n", name, suffix.c_str(), histogram.count());
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Metrics::Pool::Pool() :
+    latency{ 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10 }
+{
+}
+
+
+const char *xmrig::Metrics::phaseName(Phase phase)
+{
+    return kPhaseNames[phase];
+}
+
+
+/**
+ * Called by a mapper after a new job was sent to all its miners, start and end are Chrono::highResolutionMSecs()
+ * timestamps. Jobs without receive timestamps (replayed donation jobs) only count towards the fan-out.
+ *
+ * The same upstream job is reported by every mapper, a slow job is counted and logged once.
+ */
+void xmrig::Metrics::addJob(const Job &job, double start, double end, size_t miners)
+{
+    m_fanout.observe((end - start) / 1000.0);
+
+    if (job.receivedAt() <= 0.0) {
+        return;
+    }
+
+    const double parse    = job.parsedAt() - job.receivedAt();
+    const double dispatch = start - job.parsedAt();
+    const double total    = end - job.receivedAt();
+
+    m_phases[PhaseParse].observe(parse / 1000.0);
+    m_phases[PhaseDispatch].observe(dispatch / 1000.0);
+    m_propagation.observe(total / 1000.0);
+
+    if (m_slowJob == 0 || total < m_slowJob) {
+        return;
+    }
+
+    if (m_slowJobHeight == job.height() && m_slowJobId == job.id()) {
+        return;
+    }
+
+    m_slowJobId     = job.id();
+    m_slowJobHeight = job.height();
+    m_slowJobs++;
+
+    LOG_WARN("%s " YELLOW_BOLD("slow job ") WHITE_BOLD("%s") " height " WHITE_BOLD("%" PRIu64) " took " YELLOW_BOLD("%.3f ms")
+             " (parse %.3f, dispatch %.3f, fan-out %.3f ms to %zu miners)",
+             Tags::proxy(), job.id().data(), job.height(), total, parse, dispatch, end - start, miners);
+}
+
+
+/**
+ * Per miner part of the job fan-out, durations are in milliseconds.
+ */
+void xmrig::Metrics::addMinerJob(double serialize, double enqueue)
+{
+    m_phases[PhaseSerialize].observe(serialize / 1000.0);
+    m_phases[PhaseEnqueue].observe(enqueue / 1000.0);
+}
+
+
+std::string xmrig::Metrics::toText(const ApiSnapshot &snapshot)
+{
+    const auto &stats = snapshot.stats;
+
+    std::string out;
+    out.reserve(16384);
+
+    family(out, "xmrig_proxy_build", "info", "Proxy version and mode.");
+    append(out, "xmrig_proxy_build_info{version=\"%s\",kind=\"%s\",mode=\"%s\"} 1\n", APP_VERSION, APP_KIND, snapshot.mode);
+
+    family(out, "xmrig_proxy_uptime_seconds", "gauge", "Time since the proxy started.");
+    append(out, "xmrig_proxy_uptime_seconds %" PRIu64 "\n", stats.uptime());
+
+    family(out, "xmrig_proxy_miners", "gauge", "Logged in miners.");
+    append(out, "xmrig_proxy_miners %" PRIu64 "\n", snapshot.miners);
+
+    family(out, "xmrig_proxy_miners_max", "gauge", "Maximum number of logged in miners since start.");
+    append(out, "xmrig_proxy_miners_max %" PRIu64 "\n", stats.maxMiners);
+
+    family(out, "xmrig_proxy_connections", "gauge", "Open miner connections.");
+    append(out, "xmrig_proxy_connections %" PRIu64 "\n", stats.connections);
+
+    family(out, "xmrig_proxy_upstreams", "gauge", "Pool connections by state.");
+    append(out, "xmrig_proxy_upstreams{state=\"active\"} %" PRIu64 "\n", stats.upstreams.active);
+    append(out, "xmrig_proxy_upstreams{state=\"sleep\"} %" PRIu64 "\n", stats.upstreams.sleep);
+    append(out, "xmrig_proxy_upstreams{state=\"error\"} %" PRIu64 "\n", stats.upstreams.error);
+
+    family(out, "xmrig_proxy_shares", "counter", "Shares by result.");
+    append(out, "xmrig_proxy_shares_total{result=\"accepted\"} %" PRIu64 "\n", stats.accepted);
+    append(out, "xmrig_proxy_shares_total{result=\"rejected\"} %" PRIu64 "\n", stats.rejected);
+    append(out, "xmrig_proxy_shares_total{result=\"invalid\"} %" PRIu64 "\n", stats.invalid);
+    append(out, "xmrig_proxy_shares_total{result=\"expired\"} %" PRIu64 "\n", stats.expired);
+
+    family(out, "xmrig_proxy_hashes", "counter", "Accepted hashes (sum of share difficulty).");
+    append(out, "xmrig_proxy_hashes_total %" PRIu64 "\n", stats.hashes);
+
+    family(out, "xmrig_proxy_donate_hashes", "counter", "Accepted donation hashes.");
+    append(out, "xmrig_proxy_donate_hashes_total %" PRIu64 "\n", stats.donateHashes);
+
+    family(out, "xmrig_proxy_hashrate", "gauge", "Average hashrate in H/s over the window in seconds.");
+    for (size_t i = 0; i < sizeof(kHashrateWindows) / sizeof(kHashrateWindows[0]); ++i) {
+        append(out, "xmrig_proxy_hashrate{window=\"%d\"} %.2f\n", kHashrateWindows[i], stats.hashrate[i] * 1000.0);
+    }
+
+    family(out, "xmrig_proxy_job_fanout_seconds", "histogram", "Time to send a new job to all miners of one upstream.");
+    histogram(out, "xmrig_proxy_job_fanout_seconds", snapshot.fanout, {});
+
+    family(out, "xmrig_proxy_job_propagation_seconds", "histogram", "Time from receiving a job from the pool until it is queued for the last miner.");
+    histogram(out, "xmrig_proxy_job_propagation_seconds", snapshot.propagation, {});
+
+    family(out, "xmrig_proxy_job_phase_seconds", "histogram", "Time spent in each phase of new job propagation, serialize and enqueue are per miner.");
+    for (size_t i = 0; i < snapshot.phases.size(); ++i) {
+        histogram(out, "xmrig_proxy_job_phase_seconds", snapshot.phases[i], label("phase", phaseName(static_cast<Phase>(i))));
+    }
+
+    family(out, "xmrig_proxy_slow_jobs", "counter", "Jobs with propagation time above the slow-job threshold.");
+    append(out, "xmrig_proxy_slow_jobs_total %" PRIu64 "\n", snapshot.slowJobs);
+
+    writePools(out, snapshot);
+    writeWorkers(out, snapshot);
+
+    out += "# EOF\n";
+
+    return out;
+}
+
+
+void xmrig::Metrics::onEvent(IEvent *event)
+{
+    if (event->type() == IEvent::AcceptType) {
+        accept(static_cast<AcceptEvent *>(event), false);
+    }
+}
+
+
+void xmrig::Metrics::onRejectedEvent(IEvent *event)
+{
+    if (event->type() == IEvent::AcceptType) {
+        accept(static_cast<AcceptEvent *>(event), true);
+    }
+}
+
+
+void xmrig::Metrics::accept(const AcceptEvent *event, bool rejected)
+{
+    if (!event->pool() || event->isDonate() || event->isCustomDiff()) {
+        return;
+    }
+
+    auto &pool = m_pools[event->pool()->url().data()];
+
+    if (rejected) {
+        pool.rejected++;
+        return;
+    }
+
+    pool.accepted++;
+    pool.hashes += event->result.diff;
+    pool.latency.observe(event->result.elapsed / 1000.0);
+}
+
+
+void xmrig::Metrics::writePools(std::string &out, const ApiSnapshot &snapshot)
+{
+    const auto &pools = snapshot.pools;
+    if (pools.empty()) {
+        return;
+    }
+
+    family(out, "xmrig_proxy_pool_shares", "counter", "Shares submitted to the pool by result.");
+    for (const auto &kv : pools) {
+        const std::string pool = label("pool", kv.first.c_str());
+
+        append(out, "xmrig_proxy_pool_shares_total{%s,result=\"accepted\"} %" PRIu64 "\n", pool.c_str(), kv.second.accepted);
+        append(out, "xmrig_proxy_pool_shares_total{%s,result=\"rejected\"} %" PRIu64 "\n", pool.c_str(), kv.second.rejected);
+    }
+
+    family(out, "xmrig_proxy_pool_hashes", "counter", "Hashes accepted by the pool.");
+    for (const auto &kv : pools) {
+        append(out, "xmrig_proxy_pool_hashes_total{%s} %" PRIu64 "\n", label("pool", kv.first.c_str()).c_str(), kv.second.hashes);
+    }
+
+    family(out, "xmrig_proxy_share_latency_seconds", "histogram", "Time between share submit and pool response.");
+    for (const auto &kv : pools) {
+        histogram(out, "xmrig_proxy_share_latency_seconds", kv.second.latency, label("pool", kv.first.c_str()));
+    }
+}
+
+
+/**
+ * Per-worker series are limited to the "metrics-workers" most productive workers (10 minutes hashrate),
+ * to keep the number of series bounded on proxies with many workers.
+ */
+void xmrig::Metrics::writeWorkers(std::string &out, const ApiSnapshot &snapshot)
+{
+    using Worker = ApiSnapshot::Worker;
+
+    const size_t count = snapshot.workersCount;
+    const size_t limit = snapshot.workersTable ? std::min<size_t>(snapshot.metricsWorkers, snapshot.workersTable->size()) : 0;
+
+    family(out, "xmrig_proxy_workers", "gauge", "Known workers.");
+    append(out, "xmrig_proxy_workers %zu\n", count);
+
+    family(out, "xmrig_proxy_workers_omitted", "gauge", "Workers without per-worker series because of the limit.");
+    append(out, "xmrig_proxy_workers_omitted %zu\n", count - limit);
+
+    if (limit == 0) {
+        return;
+    }
+
+    std::vector<const Worker *> workers;
+    workers.reserve(snapshot.workersTable->size());
+
+    for (const Worker &worker : *snapshot.workersTable) {
+        workers.push_back(&worker);
+    }
+
+    std::partial_sort(workers.begin(), workers.begin() + static_cast<ptrdiff_t>(limit), workers.end(), [](const Worker *a, const Worker *b) { return a->hashrate[1] > b->hashrate[1]; });
+    workers.resize(limit);
+
+    std::vector<std::string> labels;
+    labels.reserve(limit);
+
+    for (const Worker *worker : workers) {
+        labels.emplace_back(label("worker", worker->name.c_str()));
+    }
+
+    family(out, "xmrig_proxy_worker_connections", "gauge", "Open connections of the worker.");
+    for (size_t i = 0; i < limit; ++i) {
+        append(out, "xmrig_proxy_worker_connections{%s} %" PRIu64 "\n", labels[i].c_str(), workers[i]->connections);
+    }
+
+    family(out, "xmrig_proxy_worker_shares", "counter", "Shares of the worker by result.");
+    for (size_t i = 0; i < limit; ++i) {
+        append(out, "xmrig_proxy_worker_shares_total{%s,result=\"accepted\"} %" PRIu64 "\n", labels[i].c_str(), workers[i]->accepted);
+        append(out, "xmrig_proxy_worker_shares_total{%s,result=\"rejected\"} %" PRIu64 "\n", labels[i].c_str(), workers[i]->rejected);
+        append(out, "xmrig_proxy_worker_shares_total{%s,result=\"invalid\"} %" PRIu64 "\n", labels[i].c_str(), workers[i]->invalid);
+    }
+
+    family(out, "xmrig_proxy_worker_hashes", "counter", "Accepted hashes of the worker.");
+    for (size_t i = 0; i < limit; ++i) {
+        append(out, "xmrig_proxy_worker_hashes_total{%s} %" PRIu64 "\n", labels[i].c_str(), workers[i]->hashes);
+    }
+
+    family(out, "xmrig_proxy_worker_hashrate", "gauge", "Average hashrate of the worker in H/s over the window in seconds.");
+    for (size_t i = 0; i < limit; ++i) {
+        append(out, "xmrig_proxy_worker_hashrate{%s,window=\"60\"} %.2f\n", labels[i].c_str(), workers[i]->hashrate[0] * 1000.0);
+        append(out, "xmrig_proxy_worker_hashrate{%s,window=\"600\"} %.2f\n", labels[i].c_str(), workers[i]->hashrate[1] * 1000.0);
+    }
+}
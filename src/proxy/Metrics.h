@@ -0,0 +1,114 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_METRICS_H
+#define XMRIG_METRICS_H
+
+
+#include <map>
+#include <string>
+
+
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "proxy/Histogram.h"
+#include "proxy/interfaces/IEventListener.h"
+
+
+namespace xmrig {
+
+
+class AcceptEvent;
+class ApiSnapshot;
+class Job;
+
+
+/**
+ * OpenMetrics exposition of the proxy counters, rendered as plain text without building a JSON document.
+ *
+ * Besides the global stats it keeps per-pool share counters and latency histograms, and histograms of
+ * new job propagation: the time needed to send a new job to all miners of a mapper and the time spent in each
+ * phase between the pool notification and the last miner write being queued. Text is rendered from an API snapshot.
+ */
+class Metrics : public IEventListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(Metrics)
+
+    enum Phase {
+        PhaseParse,         // pool message received, job parsed
+        PhaseDispatch,      // job parsed, mapper starts sending it to miners
+        PhaseSerialize,     // job rendered for one miner
+        PhaseEnqueue,       // job handed to one miner socket (written or queued in libuv)
+        PhaseMax
+    };
+
+    struct Pool
+    {
+        Pool();
+
+        Histogram latency;
+        uint64_t accepted   = 0;
+        uint64_t hashes     = 0;
+        uint64_t rejected   = 0;
+    };
+
+    static const char *kContentType;
+
+    Metrics()           = default;
+    ~Metrics() override = default;
+
+    static inline const Histogram &fanout()                 { return m_fanout; }
+    static inline const Histogram &phase(Phase phase)       { return m_phases[phase]; }
+    static inline const Histogram &propagation()            { return m_propagation; }
+    static inline uint64_t slowJobs()                       { return m_slowJobs; }
+    static inline void setSlowJob(uint32_t ms)              { m_slowJob = ms; }
+    inline const std::map<std::string, Pool> &pools() const { return m_pools; }
+
+    static const char *phaseName(Phase phase);
+    static std::string toText(const ApiSnapshot &snapshot);
+    static void addJob(const Job &job, double start, double end, size_t miners);
+    static void addMinerJob(double serialize, double enqueue);
+
+protected:
+    void onEvent(IEvent *event) override;
+    void onRejectedEvent(IEvent *event) override;
+
+private:
+    static void writePools(std::string &out, const ApiSnapshot &snapshot);
+    static void writeWorkers(std::string &out, const ApiSnapshot &snapshot);
+
+    void accept(const AcceptEvent *event, bool rejected);
+
+    std::map<std::string, Pool> m_pools;
+
+    static Histogram m_fanout;
+    static Histogram m_phases[PhaseMax];
+    static Histogram m_propagation;
+    static String m_slowJobId;
+    static uint32_t m_slowJob;
+    static uint64_t m_slowJobHeight;
+    static uint64_t m_slowJobs;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_METRICS_H */
@@ -30,6 +30,7 @@
 #include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Job.h"
+#include "base/net/stratum/Pool.h"
 #include "base/net/tools/NetBuffer.h"
 #include "base/tools/Cvt.h"
 #include "base/tools/Chrono.h"
@@ -38,8 +39,16 @@
 #include "proxy/Error.h"
 #include "proxy/events/AcceptEvent.h"
 #include "proxy/events/CloseEvent.h"
+#include "proxy/events/ConnectionEvent.h"
 #include "proxy/events/LoginEvent.h"
 #include "proxy/events/SubmitEvent.h"
+#include "proxy/JobTemplate.h"
+#include "proxy/Metrics.h"
+
+
+#ifdef XMRIG_OS_UNIX
+#   include "proxy/Upgrade.h"
+#endif
 
 
 #ifdef XMRIG_FEATURE_TLS
@@ -49,23 +58,26 @@
 #endif
 
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <cstring>
+#include <string>
 
 
 namespace xmrig {
     static int64_t nextId = 0;
     char Miner::m_sendBuf[16384] = { 0 };
     Storage<Miner> Miner::m_storage;
+    std::vector<uintptr_t> Miner::m_closed;
 } // namespace xmrig
 
 
 xmrig::Miner::Miner(const TlsContext *ctx, uint16_t port, bool strictTls) :
     m_strictTls(strictTls),
-    m_rpcId(Cvt::toHex(Cvt::randomBytes(8))),
     m_tlsCtx(ctx),
     m_id(++nextId),
+    m_rpcId(Cvt::toHex(Cvt::randomBytes(8))),
     m_localPort(port),
     m_expire(Chrono::steadyMSecs() + kLoginTimeout),
     m_timestamp(Chrono::currentMSecsSinceEpoch())
@@ -81,8 +93,32 @@ xmrig::Miner::Miner(const TlsContext *ctx, uint16_t port, bool strictTls) :
 }
 
 
+xmrig::Miner::Miner(Miner *parent, uint32_t mux) :
+    m_cascadeAllowed(parent->m_cascadeAllowed),
+    m_muxAllowed(parent->m_muxAllowed),
+    m_strictTls(parent->m_strictTls),
+    m_tlsCtx(nullptr),
+    m_id(++nextId),
+    m_rpcId(Cvt::toHex(Cvt::randomBytes(8))),
+    m_localPort(parent->m_localPort),
+    m_expire(Chrono::steadyMSecs() + kLoginTimeout),
+    m_timestamp(Chrono::currentMSecsSinceEpoch()),
+    m_socket(nullptr)
+{
+    m_parent = parent;
+    m_mux    = mux;
+    m_key    = m_storage.add(this);
+
+    memcpy(m_ip, parent->m_ip, sizeof(m_ip));
+}
+
+
 xmrig::Miner::~Miner()
 {
+    if (m_parent) {
+        return;
+    }
+
     if (uv_is_closing(reinterpret_cast<uv_handle_t *>(m_socket))) {
         delete m_socket;
     }
@@ -106,16 +142,7 @@ bool xmrig::Miner::accept(uv_stream_t *server)
         return false;
     }
 
-    sockaddr_storage addr = {};
-    int size = sizeof(addr);
-
-    uv_tcp_getpeername(m_socket, reinterpret_cast<sockaddr*>(&addr), &size);
-
-    if (reinterpret_cast<sockaddr_in *>(&addr)->sin_family == AF_INET6) {
-        uv_ip6_name(reinterpret_cast<sockaddr_in6*>(&addr), m_ip, 45);
-    } else {
-        uv_ip4_name(reinterpret_cast<sockaddr_in*>(&addr), m_ip, 16);
-    }
+    peerName();
 
     uv_read_start(reinterpret_cast<uv_stream_t*>(m_socket), NetBuffer::onAlloc, Miner::onRead);
 
@@ -128,7 +155,7 @@ void xmrig::Miner::forwardJob(const Job &job, const char *algo)
     m_diff = job.diff();
     setFixedByte(job.fixedByte());
 
-    sendJob(job.rawBlob(), job.id().data(), job.rawTarget(), algo ? algo : job.algorithm().name(), job.height(), job.rawSeedHash(), job.rawSigKey());
+    send(serializeJob(job.rawBlob(), job.id().data(), job.rawTarget(), algo ? algo : job.algorithm().name(), job.height(), job.rawSeedHash(), job.rawSigKey()));
 }
 
 
@@ -138,15 +165,41 @@ void xmrig::Miner::replyWithError(int64_t id, const char *message)
 }
 
 
+/**
+ * Sends a pre-rendered job notification, miners that need a login reply, cascade slots or a custom target
+ * get an individually rendered job instead.
+ */
+void xmrig::Miner::setJob(Job &job, const JobTemplate *tpl)
+{
+    if (!tpl || !tpl->isValid() || m_state != ReadyState || hasExtension(EXT_CASCADE) || (m_customDiff && m_customDiff < job.diff())) {
+        return setJob(job);
+    }
+
+    const double start = Chrono::highResolutionMSecs();
+
+    rotateRange();
+    m_diff = job.diff();
+
+    if (!job.rawSigKey().isNull()) {
+        m_signatureData = job.rawSigKey();
+    }
+
+    const int size          = tpl->write(m_sendBuf, sizeof(m_sendBuf), hasExtension(EXT_NICEHASH) ? m_fixedByte : -1);
+    const double serialized = Chrono::highResolutionMSecs();
+
+    send(size);
+
+    Metrics::addMinerJob(serialized - start, Chrono::highResolutionMSecs() - serialized);
+}
+
+
 void xmrig::Miner::setJob(Job &job, int64_t extra_nonce)
 {
     using namespace rapidjson;
 
-    if (hasExtension(EXT_NICEHASH)) {
-        snprintf(m_sendBuf, 4, "%02hhx", m_fixedByte);
-        memcpy(job.rawBlob() + (job.nonceOffset() + 3) * 2, m_sendBuf, 2);
-    }
+    const double start = Chrono::highResolutionMSecs();
 
+    rotateRange();
     m_diff = job.diff();
     bool customDiff = false;
 
@@ -180,7 +233,50 @@ void xmrig::Miner::setJob(Job &job, int64_t extra_nonce)
         blob = tmp_blob;
     }
 
-    sendJob(blob, job.id().data(), customDiff ? m_sendBuf : job.rawTarget(), job.algorithm().name(), job.height(), job.rawSeedHash(), m_signatureData);
+    // The fixed byte goes to a copy of the blob, the job payload is shared with other miners.
+    char nicehashBlob[Job::kMaxBlobSize * 2 + 8];
+
+    if (hasExtension(EXT_NICEHASH)) {
+        char *out = tmp_blob.data();
+
+        if (blob != tmp_blob.data()) {
+            const size_t size = job.size() * 2;
+
+            memcpy(nicehashBlob, blob, size);
+            nicehashBlob[size] = '\0';
+            out = nicehashBlob;
+        }
+
+        char fixedByte[4];
+        snprintf(fixedByte, sizeof(fixedByte), "%02hhx", m_fixedByte);
+        memcpy(out + (job.nonceOffset() + 3) * 2, fixedByte, 2);
+
+        blob = out;
+    }
+
+    const int size          = serializeJob(blob, job.id().data(), customDiff ? m_sendBuf : job.rawTarget(), job.algorithm().name(), job.height(), job.rawSeedHash(), m_signatureData);
+    const double serialized = Chrono::highResolutionMSecs();
+
+    send(size);
+
+    Metrics::addMinerJob(serialized - start, Chrono::highResolutionMSecs() - serialized);
+}
+
+
+/**
+ * Assigns a new block of nonce slots, shares of the job the miner is working on still use the old block
+ * and it is accepted until the next job.
+ */
+void xmrig::Miner::setRange(uint8_t fixedByte, uint16_t slots)
+{
+    if (m_state == ReadyState && (fixedByte != m_fixedByte || slots != m_slots)) {
+        m_prevFixedByte = m_fixedByte;
+        m_prevSlots     = hasExtension(EXT_CASCADE) ? m_slots : 1;
+        m_rangeChanged  = true;
+    }
+
+    m_fixedByte = fixedByte;
+    m_slots     = slots;
 }
 
 
@@ -190,12 +286,191 @@ void xmrig::Miner::success(int64_t id, const char *status)
 }
 
 
+#ifdef XMRIG_OS_UNIX
+bool xmrig::Miner::handoff(MinerHandoff &state)
+{
+    auto stream = reinterpret_cast<uv_stream_t*>(m_socket);
+
+    // TLS sessions, multiplexed and donate routed connections can't be continued by another process, such miners reconnect.
+    if (m_parent || m_multiplexed || isTLS() || m_state != ReadyState || m_routeId != -1 || stream->write_queue_size > 0) {
+        return false;
+    }
+
+    uv_os_fd_t fd = -1;
+    if (uv_fileno(reinterpret_cast<uv_handle_t*>(m_socket), &fd) != 0) {
+        return false;
+    }
+
+    uv_read_stop(stream);
+
+    state.fd         = fd;
+    state.loginId    = m_loginId;
+    state.localPort  = m_localPort;
+    state.slots      = m_requested;
+    state.customDiff = m_customDiff;
+    state.rx         = m_rx;
+    state.timestamp  = m_timestamp;
+    state.tx         = m_tx;
+    state.rpcId      = m_rpcId;
+    state.user       = m_user;
+    state.password   = m_password;
+    state.agent      = m_agent;
+    state.rigId      = m_rigId;
+    state.algorithms = m_algorithms;
+    state.cascade    = m_cascadeAllowed;
+    state.mux        = m_muxAllowed;
+
+    if (m_reader.size()) {
+        state.buffered.assign(m_reader.data(), m_reader.size());
+    }
+
+    return true;
+}
+
+
+bool xmrig::Miner::restore(const MinerHandoff &state)
+{
+    const int rc = uv_tcp_open(m_socket, state.fd);
+    if (rc < 0) {
+        LOG_ERR("[miner] restore error: \"%s\"", uv_strerror(rc));
+        return false;
+    }
+
+    peerName();
+
+    m_loginId    = state.loginId;
+    m_requested  = state.slots;
+    m_slots      = state.slots;
+    m_customDiff = state.customDiff;
+    m_rx         = state.rx;
+    m_timestamp  = state.timestamp;
+    m_tx         = state.tx;
+    m_rpcId      = state.rpcId;
+    m_user       = state.user;
+    m_password   = state.password;
+    m_agent      = state.agent;
+    m_rigId      = state.rigId;
+    m_algorithms = state.algorithms;
+    m_restored   = true;
+
+    // Permissions of the bind the miner was accepted on, the replayed login is checked against them.
+    setCascadeAllowed(state.cascade);
+    setMuxAllowed(state.mux);
+
+    setState(WaitReadyState);
+    heartbeat();
+
+    uv_read_start(reinterpret_cast<uv_stream_t*>(m_socket), NetBuffer::onAlloc, Miner::onRead);
+
+    if (!state.buffered.empty()) {
+        std::string buffered = state.buffered;
+        m_reader.parse(&buffered[0], buffered.size());
+    }
+
+    ConnectionEvent::start(this, m_localPort);
+
+    using namespace rapidjson;
+
+    Document params(kObjectType);
+    auto &allocator = params.GetAllocator();
+
+    params.AddMember("login",   m_user.toJSON(), allocator);
+    params.AddMember("pass",    m_password.toJSON(), allocator);
+    params.AddMember("agent",   m_agent.toJSON(), allocator);
+    params.AddMember("rigid",   m_rigId.toJSON(), allocator);
+    params.AddMember("cascade", m_slots, allocator);
+
+    LoginEvent::create(this, m_loginId, m_algorithms, params)->start();
+
+    return true;
+}
+
+
+void xmrig::Miner::release()
+{
+    // The connection belongs to the new process now, the socket is closed on destruction without shutdown.
+    setState(ClosingState);
+}
+
+
+void xmrig::Miner::resume()
+{
+    setState(ReadyState);
+    uv_read_start(reinterpret_cast<uv_stream_t*>(m_socket), NetBuffer::onAlloc, Miner::onRead);
+}
+#endif
+
+
+bool xmrig::Miner::isInRange(const JobResult &result) const
+{
+    if (result.isCompatible(m_fixedByte, hasExtension(EXT_CASCADE) ? m_slots : 1)) {
+        return true;
+    }
+
+    return m_prevSlots > 0 && result.isCompatible(m_prevFixedByte, m_prevSlots);
+}
+
+
 bool xmrig::Miner::isWritable() const
 {
+    if (m_parent) {
+        return m_state != ClosingState && m_parent->isWritable();
+    }
+
     return m_state != ClosingState && uv_is_writable(reinterpret_cast<const uv_stream_t*>(m_socket)) == 1;
 }
 
 
+bool xmrig::Miner::parseMux(uint32_t mux, int64_t id, const char *method, const rapidjson::Value &params)
+{
+    if (!method || m_parent || m_state != WaitLoginState) {
+        return false;
+    }
+
+    if (!m_muxAllowed) {
+        replyWithError(id, Error::toString(Error::Forbidden));
+
+        return false;
+    }
+
+    m_multiplexed = true;
+    heartbeat();
+
+    auto it = m_children.find(mux);
+    if (it == m_children.end()) {
+        // Late messages of an already closed logical miner are silently dropped.
+        if (strcmp(method, "login") != 0) {
+            return true;
+        }
+
+        if (m_children.size() >= kMaxChildren) {
+            send(snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"mux\":%u,\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"%s\"}}\n", mux, id, Error::toString(Error::TooManySessions)));
+
+            return true;
+        }
+
+        auto miner = new Miner(this, mux);
+        it = m_children.emplace(mux, miner).first;
+
+        ConnectionEvent::start(miner, m_localPort);
+    }
+
+    Miner *miner = it->second;
+
+    if (strcmp(method, "logout") == 0) {
+        miner->shutdown(false);
+
+        return true;
+    }
+
+    if (!miner->parseRequest(id, method, params)) {
+        miner->shutdown(true);
+    }
+
+    return true;
+}
+
+
 bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson::Value &params)
 {
     if (!method || !params.IsObject()) {
@@ -207,12 +482,13 @@ bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson:
             setState(WaitReadyState);
             m_loginId = id;
 
-            Algorithms algorithms;
+            // Kept for the lifetime of the miner, a hot upgrade replays the login with the same list.
+            m_algorithms.clear();
             if (params.HasMember("algo")) {
                 const rapidjson::Value &value = params["algo"];
 
                 if (value.IsArray()) {
-                    algorithms.reserve(value.Size());
+                    m_algorithms.reserve(value.Size());
 
                     for (const auto &i : value.GetArray()) {
                         const Algorithm algo(i.GetString());
@@ -220,7 +496,7 @@ bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson:
                             continue;
                         }
 
-                        algorithms.emplace_back(algo);
+                        m_algorithms.emplace_back(algo);
                     }
                 }
             }
@@ -229,8 +505,20 @@ bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson:
             m_password = Json::getString(params, "pass");
             m_agent    = Json::getString(params, "agent");
             m_rigId    = Json::getString(params, "rigid");
+            m_slots    = static_cast<uint16_t>(std::min<uint32_t>(Json::getUint(params, "cascade"), Pool::kCascadeSlots));
+
+            // The mapper may grant a smaller block than requested, the request is kept for the next allocation.
+            m_requested = m_slots;
+
+            LoginEvent::create(this, id, m_algorithms, params)->start();
+            return true;
+        }
+
+        // Multiplexed connection itself never logs in, it only needs to be kept alive.
+        if (m_multiplexed && strcmp(method, "keepalived") == 0) {
+            heartbeat();
+            success(id, "KEEPALIVED");
 
-            LoginEvent::create(this, id, algorithms, params)->start();
             return true;
         }
 
@@ -238,7 +526,20 @@ bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson:
     }
 
     if (m_state == WaitReadyState) {
-        return false;
+        if (!m_restored) {
+            return false;
+        }
+
+        // Connection handed over by the previous process is still waiting for the first job.
+        if (strcmp(method, "keepalived") == 0) {
+            heartbeat();
+            success(id, "KEEPALIVED");
+        }
+        else {
+            replyWithError(id, Error::toString(Error::InvalidJobId));
+        }
+
+        return true;
     }
 
     if (strcmp(method, "submit") == 0) {
@@ -257,7 +558,7 @@ bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson:
         if (!event->request.isValid() || event->request.actualDiff() < diff()) {
             event->setError(Error::LowDifficulty);
         }
-        else if (hasExtension(EXT_NICEHASH) && !event->request.isCompatible(m_fixedByte)) {
+        else if (hasExtension(EXT_NICEHASH) && !isInRange(event->request)) {
             event->setError(Error::InvalidNonce);
         }
 
@@ -288,24 +589,31 @@ bool xmrig::Miner::parseRequest(int64_t id, const char *method, const rapidjson:
 }
 
 
-bool xmrig::Miner::send(BIO *bio)
+bool xmrig::Miner::transmit(int size)
 {
 #   ifdef XMRIG_FEATURE_TLS
-    uv_buf_t buf;
-    buf.len = BIO_get_mem_data(bio, &buf.base);
-
-    if (buf.len == 0) {
-        return true;
+    if (isTLS()) {
+        return m_tls->send(m_sendBuf, size);
     }
+#   endif
+
+    return write(m_sendBuf, static_cast<size_t>(size));
+}
 
-    LOG_DEBUG("[%s] TLS send     (%d bytes)", m_ip, static_cast<int>(buf.len));
 
+bool xmrig::Miner::write(const char *data, size_t size)
+{
     if (!isWritable()) {
         return false;
     }
 
-    const int rc = uv_try_write(reinterpret_cast<uv_stream_t*>(m_socket), &buf, 1);
-    (void) BIO_reset(bio);
+    auto stream  = reinterpret_cast<uv_stream_t*>(m_socket);
+    uv_buf_t buf = uv_buf_init(const_cast<char *>(data), static_cast<unsigned int>(size));
+    int rc       = stream->write_queue_size == 0 ? uv_try_write(stream, &buf, 1) : UV_EAGAIN;
+
+    if (rc == UV_EAGAIN) {
+        rc = 0;
+    }
 
     if (rc < 0) {
         shutdown(true);
@@ -313,12 +621,38 @@ bool xmrig::Miner::send(BIO *bio)
         return false;
     }
 
-    m_tx += buf.len;
+    if (static_cast<size_t>(rc) == size) {
+        return true;
+    }
+
+    // Socket buffer is full, only the remainder is copied and queued.
+    if (stream->write_queue_size + size - rc > kMaxWriteQueue) {
+        shutdown(true);
+
+        return false;
+    }
+
+    struct WriteReq
+    {
+        uv_write_t req;
+        std::string data;
+    };
+
+    auto req      = new WriteReq();
+    req->req.data = req;
+    req->data.assign(data + rc, size - rc);
+
+    buf = uv_buf_init(&req->data[0], static_cast<unsigned int>(req->data.size()));
+
+    rc = uv_write(&req->req, stream, &buf, 1, [](uv_write_t *req, int) { delete static_cast<WriteReq *>(req->data); });
+    if (rc < 0) {
+        delete req;
+        shutdown(true);
+
+        return false;
+    }
 
     return true;
-#   else
-    return false;
-#   endif
 }
 
 
@@ -351,7 +685,17 @@ void xmrig::Miner::parse(char *line, size_t len)
         return shutdown(true);
     }
 
-    const rapidjson::Value &id = doc["id"];
+    const rapidjson::Value &id  = doc["id"];
+    const rapidjson::Value &mux = Json::getValue(doc, "mux");
+
+    if (mux.IsUint()) {
+        if (id.IsInt64() && parseMux(mux.GetUint(), id.GetInt64(), Json::getString(doc, "method"), Json::getValue(doc, "params"))) {
+            return;
+        }
+
+        return shutdown(true);
+    }
+
     if (id.IsInt64() && parseRequest(id.GetInt64(), doc["method"].GetString(), doc["params"])) {
         return;
     }
@@ -360,6 +704,21 @@ void xmrig::Miner::parse(char *line, size_t len)
 }
 
 
+void xmrig::Miner::peerName()
+{
+    sockaddr_storage addr = {};
+    int size = sizeof(addr);
+
+    uv_tcp_getpeername(m_socket, reinterpret_cast<sockaddr*>(&addr), &size);
+
+    if (reinterpret_cast<sockaddr_in *>(&addr)->sin_family == AF_INET6) {
+        uv_ip6_name(reinterpret_cast<sockaddr_in6*>(&addr), m_ip, 45);
+    } else {
+        uv_ip4_name(reinterpret_cast<sockaddr_in*>(&addr), m_ip, 16);
+    }
+}
+
+
 void xmrig::Miner::read(ssize_t nread, const uv_buf_t *buf)
 {
     const auto size = static_cast<size_t>(nread);
@@ -391,6 +750,12 @@ void xmrig::Miner::read(ssize_t nread, const uv_buf_t *buf)
 
 
 void xmrig::Miner::send(const rapidjson::Document &doc)
+{
+    send(serialize(doc));
+}
+
+
+int xmrig::Miner::serialize(const rapidjson::Document &doc)
 {
     using namespace rapidjson;
 
@@ -403,14 +768,14 @@ void xmrig::Miner::send(const rapidjson::Document &doc)
         LOG_ERR("[%s] send failed: \"send buffer overflow: %zu > %zu\"", m_ip, size, (sizeof(m_sendBuf) - 2));
         shutdown(true);
 
-        return;
+        return -1;
     }
 
     memcpy(m_sendBuf, buffer.GetString(), size);
     m_sendBuf[size]     = '\n';
     m_sendBuf[size + 1] = '\0';
 
-    return send(size + 1);
+    return static_cast<int>(size + 1);
 }
 
 
@@ -422,27 +787,33 @@ void xmrig::Miner::send(int size)
         return;
     }
 
-    int rc = -1;
-#   ifdef XMRIG_FEATURE_TLS
-    if (isTLS()) {
-        rc = m_tls->send(m_sendBuf, size) ? 0 : -1;
-    }
-    else
-#   endif
-    {
-        uv_buf_t buf = uv_buf_init(m_sendBuf, (unsigned int) size);
-        rc = uv_try_write(reinterpret_cast<uv_stream_t*>(m_socket), &buf, 1);
-    }
+    if (m_parent) {
+        // Tag the message with the logical miner id: {"mux":N,...}
+        char prefix[24];
+        const int offset = snprintf(prefix, sizeof(prefix), "{\"mux\":%u,", m_mux);
 
-    if (rc < 0) {
-        return shutdown(true);
+        if (static_cast<size_t>(size + offset) >= sizeof(m_sendBuf)) {
+            return shutdown(true);
+        }
+
+        memmove(m_sendBuf + offset, m_sendBuf + 1, static_cast<size_t>(size));
+        memcpy(m_sendBuf, prefix, static_cast<size_t>(offset));
+
+        // Bytes are accounted to the logical miner only, the connection itself does not count them again.
+        if (m_parent->transmit(size + offset - 1)) {
+            m_tx += size;
+        }
+
+        return;
     }
 
-    m_tx += size;
+    if (transmit(size)) {
+        m_tx += size;
+    }
 }
 
 
-void xmrig::Miner::sendJob(const char *blob, const char *jobId, const char *target, const char *algo, uint64_t height, const String &seedHash, const String &signatureKey)
+int xmrig::Miner::serializeJob(const char *blob, const char *jobId, const char *target, const char *algo, uint64_t height, const String &seedHash, const String &signatureKey)
 {
     using namespace rapidjson;
 
@@ -459,6 +830,10 @@ void xmrig::Miner::sendJob(const char *blob, const char *jobId, const char *targ
         params.AddMember("height", height, allocator);
     }
 
+    if (hasExtension(EXT_CASCADE)) {
+        params.AddMember("slots", m_slots, allocator);
+    }
+
     if (!seedHash.isNull()) {
         params.AddMember("seed_hash", seedHash.toJSON(), allocator);
     }
@@ -471,6 +846,12 @@ void xmrig::Miner::sendJob(const char *blob, const char *jobId, const char *targ
 
     doc.AddMember("jsonrpc", "2.0", allocator);
 
+    // Restored miner already has the login reply, it just gets a job from the new upstream.
+    if (m_state == WaitReadyState && m_restored) {
+        setState(ReadyState);
+        m_restored = false;
+    }
+
     if (m_state == WaitReadyState) {
         setState(ReadyState);
 
@@ -491,6 +872,10 @@ void xmrig::Miner::sendJob(const char *blob, const char *jobId, const char *targ
             extensions.PushBack("nicehash", allocator);
         }
 
+        if (hasExtension(EXT_CASCADE)) {
+            extensions.PushBack("cascade", allocator);
+        }
+
         if (hasExtension(EXT_CONNECT)) {
             extensions.PushBack("connect", allocator);
 
@@ -511,7 +896,17 @@ void xmrig::Miner::sendJob(const char *blob, const char *jobId, const char *targ
         doc.AddMember("params", params, allocator);
     }
 
-    send(doc);
+    return serialize(doc);
+}
+
+
+void xmrig::Miner::rotateRange()
+{
+    if (!m_rangeChanged) {
+        m_prevSlots = 0;
+    }
+
+    m_rangeChanged = false;
 }
 
 
@@ -540,7 +935,32 @@ void xmrig::Miner::shutdown(bool had_error)
         return;
     }
 
+    if (m_parent) {
+        // Let the other side know the logical miner is gone, unless it asked for that itself.
+        if (had_error) {
+            send(snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"jsonrpc\":\"2.0\",\"method\":\"logout\",\"params\":{}}\n"));
+        }
+
+        setState(ClosingState);
+        m_parent->m_children.erase(m_mux);
+
+        // Logical miner has no socket, close event and delete are deferred until the caller is done with it, see collect().
+        m_closed.push_back(m_key);
+
+        return;
+    }
+
     setState(ClosingState);
+
+    if (!m_children.empty()) {
+        const auto children = std::move(m_children);
+        m_children.clear();
+
+        for (const auto &kv : children) {
+            kv.second->shutdown(true);
+        }
+    }
+
     uv_read_stop(reinterpret_cast<uv_stream_t*>(m_socket));
 
     // uv_shutdown gets stuck when the connection was not terminated gracefully
@@ -552,6 +972,8 @@ void xmrig::Miner::shutdown(bool had_error)
                     return;
                 }
 
+                collect();
+
                 CloseEvent::start(miner);
                 m_storage.remove(handle->data);
             });
@@ -568,6 +990,8 @@ void xmrig::Miner::shutdown(bool had_error)
                     return;
                 }
 
+                collect();
+
                 CloseEvent::start(miner);
                 m_storage.remove(handle->data);
             });
@@ -588,6 +1012,27 @@ void xmrig::Miner::startTLS(const char *data)
 }
 
 
+void xmrig::Miner::collect()
+{
+    if (m_closed.empty()) {
+        return;
+    }
+
+    const auto closed = std::move(m_closed);
+    m_closed.clear();
+
+    for (uintptr_t key : closed) {
+        Miner *miner = m_storage.get(key);
+        if (!miner) {
+            continue;
+        }
+
+        CloseEvent::start(miner);
+        m_storage.remove(key);
+    }
+}
+
+
 void xmrig::Miner::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
 {
     auto miner = getMiner(stream->data);
@@ -596,6 +1041,8 @@ void xmrig::Miner::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *bu
     }
 
     NetBuffer::release(buf);
+
+    collect();
 }
 
 
@@ -27,9 +27,12 @@
 
 #include <algorithm>
 #include <bitset>
+#include <map>
+#include <vector>
 #include <uv.h>
 
 #include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
 #include "base/kernel/interfaces/ILineListener.h"
 #include "base/net/tools/LineReader.h"
 #include "base/net/tools/Storage.h"
@@ -37,14 +40,14 @@
 #include "base/tools/String.h"
 
 
-using BIO = struct bio_st;
-
-
 namespace xmrig {
 
 
 class Job;
+class JobResult;
+class JobTemplate;
 class TlsContext;
+struct MinerHandoff;
 
 
 class Miner : public ILineListener
@@ -63,6 +66,7 @@ public:
         EXT_ALGO,
         EXT_NICEHASH,
         EXT_CONNECT,
+        EXT_CASCADE,
         EXT_MAX
     };
 
@@ -72,10 +76,24 @@ public:
     bool accept(uv_stream_t *server);
     void forwardJob(const Job &job, const char *algo);
     void replyWithError(int64_t id, const char *message);
+    void setJob(Job &job, const JobTemplate *tpl);
     void setJob(Job &job, int64_t extra_nonce = -1);
+    void setRange(uint8_t fixedByte, uint16_t slots);
     void success(int64_t id, const char *status);
 
+    static void collect();
+
+#   ifdef XMRIG_OS_UNIX
+    bool handoff(MinerHandoff &state);
+    bool restore(const MinerHandoff &state);
+    void release();
+    void resume();
+#   endif
+
     inline bool hasExtension(Extension ext) const noexcept        { return m_extensions.test(ext); }
+    inline const Algorithms &algorithms() const                   { return m_algorithms; }
+    inline bool isCascadeAllowed() const                          { return m_cascadeAllowed; }
+    inline bool isMuxAllowed() const                              { return m_muxAllowed; }
     inline const char *ip() const                                 { return m_ip; }
     inline const String &agent() const                            { return m_agent; }
     inline const String &password() const                         { return m_password; }
@@ -92,11 +110,15 @@ public:
     inline uint64_t rx() const                                    { return m_rx; }
     inline uint64_t timestamp() const                             { return m_timestamp; }
     inline uint64_t tx() const                                    { return m_tx; }
+    inline uint16_t requestedSlots() const                        { return m_requested; }
+    inline uint16_t slots() const                                 { return m_slots; }
     inline uint8_t fixedByte() const                              { return m_fixedByte; }
     inline void close()                                           { shutdown(true); }
+    inline void setCascadeAllowed(bool allowed)                   { m_cascadeAllowed = allowed; }
     inline void setCustomDiff(uint64_t diff)                      { m_customDiff = diff; }
     inline void setExtension(Extension ext, bool enable) noexcept { m_extensions.set(ext, enable); }
     inline void setFixedByte(uint8_t fixedByte)                   { m_fixedByte = fixedByte; }
+    inline void setMuxAllowed(bool allowed)                       { m_muxAllowed = allowed; }
     inline void setMapperId(ssize_t mapperId)                     { m_mapperId = mapperId; }
     inline void setRouteId(int32_t id)                            { m_routeId = id; }
 
@@ -108,16 +130,26 @@ private:
 
     constexpr static size_t kLoginTimeout  = 10 * 1000;
     constexpr static size_t kSocketTimeout = 60 * 10 * 1000;
+    constexpr static size_t kMaxChildren   = 256;
+    constexpr static size_t kMaxWriteQueue = 1024 * 1024;
+
+    Miner(Miner *parent, uint32_t mux);
 
+    bool isInRange(const JobResult &result) const;
     bool isWritable() const;
+    bool parseMux(uint32_t mux, int64_t id, const char *method, const rapidjson::Value &params);
     bool parseRequest(int64_t id, const char *method, const rapidjson::Value &params);
-    bool send(BIO *bio);
+    bool transmit(int size);
+    bool write(const char *data, size_t size);
     void heartbeat();
     void parse(char *line, size_t len);
+    void peerName();
     void read(ssize_t nread, const uv_buf_t *buf);
     void send(const rapidjson::Document &doc);
     void send(int size);
-    void sendJob(const char *blob, const char *jobId, const char *target, const char *algo, uint64_t height, const String &seedHash, const String &signatureKey);
+    int serialize(const rapidjson::Document &doc);
+    int serializeJob(const char *blob, const char *jobId, const char *target, const char *algo, uint64_t height, const String &seedHash, const String &signatureKey);
+    void rotateRange();
     void setState(State state);
     void shutdown(bool had_error);
     void startTLS(const char *data);
@@ -129,20 +161,28 @@ private:
 
     static inline Miner *getMiner(void *data) { return m_storage.get(data); }
 
+    bool m_cascadeAllowed   = false;
+    bool m_multiplexed      = false;
+    bool m_muxAllowed       = false;
+    bool m_rangeChanged     = false;
+    bool m_restored         = false;
+    Algorithms m_algorithms;
     char m_ip[46]{};
     const bool m_strictTls;
-    const String m_rpcId;
     const TlsContext *m_tlsCtx;
     int32_t m_routeId       = -1;
     int64_t m_id;
     int64_t m_loginId       = 0;
     LineReader m_reader;
+    Miner *m_parent         = nullptr;
     ssize_t m_mapperId      = -1;
+    std::map<uint32_t, Miner *> m_children;
     State m_state           = WaitLoginState;
     std::bitset<EXT_MAX> m_extensions;
     String m_agent;
     String m_password;
     String m_rigId;
+    String m_rpcId;
     String m_user;
     String m_signatureData;
     uint8_t m_viewTag       = 0;
@@ -154,13 +194,19 @@ private:
     uint64_t m_rx           = 0;
     uint64_t m_timestamp;
     uint64_t m_tx           = 0;
+    uint32_t m_mux          = 0;
+    uint16_t m_slots        = 0;
+    uint16_t m_prevSlots    = 0;
+    uint16_t m_requested    = 0;
     uint8_t m_fixedByte     = 0;
+    uint8_t m_prevFixedByte = 0;
     int64_t m_extraNonce    = -1;
     uintptr_t m_key;
     uv_tcp_t *m_socket;
 
     static char m_sendBuf[16384];
     static Storage<Miner> m_storage;
+    static std::vector<uintptr_t> m_closed;
 };
 
 
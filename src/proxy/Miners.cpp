@@ -100,6 +100,8 @@ void xmrig::Miners::remove(Miner *miner)
 
 void xmrig::Miners::tick()
 {
+    Miner::collect();
+
     const uint64_t now = Chrono::steadyMSecs();
     std::vector<Miner*> expired;
 
@@ -40,10 +40,12 @@
 #include "core/Controller.h"
 #include "Counters.h"
 #include "log/AccessLog.h"
+#include "log/ShareJournal.h"
 #include "log/ShareLog.h"
 #include "proxy/Events.h"
 #include "proxy/events/ConnectionEvent.h"
 #include "proxy/Login.h"
+#include "proxy/Metrics.h"
 #include "proxy/Miner.h"
 #include "proxy/Miners.h"
 #include "proxy/ProxyDebug.h"
@@ -52,10 +54,17 @@
 #include "proxy/splitters/extra_nonce/ExtraNonceSplitter.h"
 #include "proxy/splitters/nicehash/NonceSplitter.h"
 #include "proxy/splitters/simple/SimpleSplitter.h"
+#include "proxy/state/StateSnapshot.h"
 #include "proxy/Stats.h"
 #include "proxy/workers/Workers.h"
 
 
+#ifdef XMRIG_OS_UNIX
+#   include "base/kernel/Process.h"
+#   include "proxy/Upgrade.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_TLS
 #   include "base/net/tls/TlsContext.h"
 #endif
@@ -92,15 +101,20 @@ xmrig::Proxy::Proxy(Controller *controller) :
     m_splitter  = splitter;
     m_donate    = new DonateSplitter(controller);
     m_stats     = new Stats(controller);
+    m_metrics   = new Metrics();
     m_shareLog  = new ShareLog(controller, m_stats);
+    m_journal   = new ShareJournal(controller);
     m_accessLog = new AccessLog(controller);
     m_workers   = new Workers(controller);
+    m_state     = new StateSnapshot(controller);
+
+    m_state->load(m_stats, m_workers);
 
     m_timer = new Timer(this);
 
 #   ifdef XMRIG_FEATURE_API
     m_api = new ApiRouter(controller);
-    controller->api()->addListener(m_api);
+    controller->api()->addSnapshotListener(m_api);
 #   endif
 
     Events::subscribe(IEvent::ConnectionType, m_miners);
@@ -127,11 +141,15 @@ xmrig::Proxy::Proxy(Controller *controller) :
     Events::subscribe(IEvent::SubmitType, m_workers);
 
     Events::subscribe(IEvent::AcceptType, m_stats);
+    Events::subscribe(IEvent::AcceptType, m_metrics);
     Events::subscribe(IEvent::AcceptType, m_shareLog);
+    Events::subscribe(IEvent::AcceptType, m_journal);
     Events::subscribe(IEvent::AcceptType, m_workers);
 
     m_debug = new ProxyDebug(controller->config()->isDebug());
 
+    Metrics::setSlowJob(controller->config()->slowJobThreshold());
+
     controller->addListener(this);
 }
 
@@ -142,6 +160,13 @@ xmrig::Proxy::~Proxy()
 
     delete m_timer;
 
+#   ifdef XMRIG_OS_UNIX
+    delete m_upgrade;
+#   endif
+
+    m_state->save(*m_stats, *m_workers, true);
+    delete m_state;
+
     for (Server *server : m_servers) {
         delete server;
     }
@@ -155,7 +180,9 @@ xmrig::Proxy::~Proxy()
     delete m_miners;
     delete m_splitter;
     delete m_stats;
+    delete m_metrics;
     delete m_shareLog;
+    delete m_journal;
     delete m_accessLog;
     delete m_debug;
     delete m_workers;
@@ -174,11 +201,33 @@ void xmrig::Proxy::connect()
 
     m_splitter->connect();
 
+#   ifdef XMRIG_FEATURE_API
+    m_api->tick();
+#   endif
+
+#   ifdef XMRIG_OS_UNIX
+    Upgrade upgrade;
+    if (Upgrade::isChild() && !upgrade.receive()) {
+        LOG_ERR("%s " RED("upgrade failed: no state received from the previous process, exiting"), Tags::proxy());
+        uv_kill(Process::pid(), SIGTERM);
+
+        return;
+    }
+#   endif
+
     const BindHosts &bind = m_controller->config()->bind();
     for (const BindHost &host : bind) {
+#       ifdef XMRIG_OS_UNIX
+        this->bind(host, upgrade.takeListener(host.host(), host.port()));
+#       else
         this->bind(host);
+#       endif
     }
 
+#   ifdef XMRIG_OS_UNIX
+    upgrade.restore();
+#   endif
+
     m_timer->start(1000, 1000);
 }
 
@@ -241,10 +290,56 @@ void xmrig::Proxy::printState()
 void xmrig::Proxy::onConfigChanged(xmrig::Config *config, xmrig::Config *)
 {
     m_debug->setEnabled(config->isDebug());
+
+    Metrics::setSlowJob(config->slowJobThreshold());
 }
 
 
-void xmrig::Proxy::bind(const xmrig::BindHost &host)
+#ifdef XMRIG_OS_UNIX
+void xmrig::Proxy::upgrade(const Arguments &arguments)
+{
+    if (m_upgrade && m_upgrade->isActive()) {
+        LOG_WARN("%s " YELLOW("upgrade is already in progress"), Tags::proxy());
+
+        return;
+    }
+
+    delete m_upgrade;
+    m_upgrade = new Upgrade();
+
+    // The new process binds the HTTP API port itself.
+#   ifdef XMRIG_FEATURE_API
+    m_controller->api()->suspend();
+#   endif
+
+    // The new process loads the snapshot at startup, before the handoff.
+    m_state->save(*m_stats, *m_workers, true);
+
+    if (!m_upgrade->send(arguments, m_servers, m_miners, this)) {
+        onUpgrade(false);
+    }
+}
+#endif
+
+
+void xmrig::Proxy::onUpgrade(bool success)
+{
+    // The new process took over, this one exits the same way as on SIGTERM.
+    if (success) {
+#       ifdef XMRIG_OS_UNIX
+        uv_kill(Process::pid(), SIGTERM);
+#       endif
+
+        return;
+    }
+
+#   ifdef XMRIG_FEATURE_API
+    m_controller->api()->resume();
+#   endif
+}
+
+
+void xmrig::Proxy::bind(const xmrig::BindHost &host, int fd)
 {
 #   ifdef XMRIG_FEATURE_TLS
     if (host.isTLS() && !m_tls) {
@@ -256,7 +351,13 @@ void xmrig::Proxy::bind(const xmrig::BindHost &host)
 
     auto server = new Server(host, m_tls);
 
-    if (server->bind()) {
+#   ifdef XMRIG_OS_UNIX
+    const bool ok = fd >= 0 ? server->open(fd) : server->bind();
+#   else
+    const bool ok = server->bind();
+#   endif
+
+    if (ok) {
         m_servers.push_back(server);
     }
     else {
@@ -298,4 +399,14 @@ void xmrig::Proxy::tick()
 
     m_splitter->tick(m_ticks);
     m_workers->tick(m_ticks);
+
+    const uint32_t interval = m_controller->config()->stateInterval();
+    if (interval && (m_ticks % interval) == 0) {
+        m_state->save(*m_stats, *m_workers);
+    }
+
+#   ifdef XMRIG_FEATURE_API
+    m_api->tick();
+    m_controller->api()->tick();
+#   endif
 }
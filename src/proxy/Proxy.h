@@ -33,6 +33,7 @@
 #include "base/kernel/interfaces/ITimerListener.h"
 #include "base/tools/Object.h"
 #include "proxy/CustomDiff.h"
+#include "proxy/interfaces/IUpgradeListener.h"
 #include "proxy/Stats.h"
 #include "proxy/workers/Worker.h"
 
@@ -42,21 +43,26 @@ namespace xmrig {
 
 class AccessLog;
 class ApiRouter;
+class Arguments;
 class BindHost;
 class Controller;
 class DonateSplitter;
 class ISplitter;
 class Login;
+class Metrics;
 class Miner;
 class Miners;
 class ProxyDebug;
 class Server;
+class ShareJournal;
 class ShareLog;
+class StateSnapshot;
 class TlsContext;
+class Upgrade;
 class Workers;
 
 
-class Proxy : public IBaseListener, public ITimerListener
+class Proxy : public IBaseListener, public ITimerListener, public IUpgradeListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Proxy)
@@ -70,6 +76,13 @@ public:
     void printWorkers();
     void toggleDebug();
 
+#   ifdef XMRIG_OS_UNIX
+    void upgrade(const Arguments &arguments);
+#   endif
+
+    inline const Metrics *metrics() const   { return m_metrics; }
+    inline const TlsContext *tls() const    { return m_tls; }
+
     const StatsData &statsData() const;
     const std::vector<Worker> &workers() const;
     std::vector<Miner*> miners() const;
@@ -82,11 +95,12 @@ protected:
     inline void onTimer(const Timer *) override { tick(); }
 
     void onConfigChanged(Config *config, Config *previousConfig) override;
+    void onUpgrade(bool success) override;
 
 private:
     constexpr static int kGCInterval    = 60;
 
-    void bind(const BindHost &host);
+    void bind(const BindHost &host, int fd = -1);
     void gc();
     void print();
     void tick();
@@ -98,14 +112,18 @@ private:
     DonateSplitter *m_donate;
     ISplitter *m_splitter;
     Login *m_login;
+    Metrics *m_metrics;
     Miners *m_miners;
     ProxyDebug *m_debug;
+    ShareJournal *m_journal;
     ShareLog *m_shareLog;
+    StateSnapshot *m_state;
     Stats *m_stats;
     std::vector<Server*> m_servers;
     Timer *m_timer      = nullptr;
     TlsContext *m_tls   = nullptr;
     uint64_t m_ticks    = 0;
+    Upgrade *m_upgrade  = nullptr;
     Workers *m_workers;
 };
 
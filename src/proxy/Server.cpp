@@ -31,18 +31,21 @@
 #include "proxy/Miner.h"
 
 
+#ifdef XMRIG_OS_UNIX
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+
 xmrig::Server::Server(const BindHost &host, const TlsContext *ctx) :
+    m_cascade(host.isCascade()),
+    m_mux(host.isMux()),
     m_strictTls(host.isTLS()),
     m_host(host.host()),
     m_ctx(ctx),
     m_port(host.port())
 {
-    m_server = new uv_tcp_t;
-
-    uv_tcp_init(uv_default_loop(), m_server);
-    m_server->data = this;
-
-    uv_tcp_nodelay(m_server, 1);
+    init();
 
     if (host.isIPv6() && uv_ip6_addr(m_host.data(), m_port, reinterpret_cast<sockaddr_in6 *>(&m_addr)) == 0) {
         m_version = 6;
@@ -58,6 +61,12 @@ xmrig::Server::Server(const BindHost &host, const TlsContext *ctx) :
 xmrig::Server::~Server()
 {
     Handle::close(m_server);
+
+#   ifdef XMRIG_OS_UNIX
+    if (m_paused >= 0) {
+        ::close(m_paused);
+    }
+#   endif
 }
 
 
@@ -79,6 +88,75 @@ bool xmrig::Server::bind()
 }
 
 
+#ifdef XMRIG_OS_UNIX
+bool xmrig::Server::open(int fd)
+{
+    int r = uv_tcp_open(m_server, fd);
+    if (r == 0) {
+        r = uv_listen(reinterpret_cast<uv_stream_t*>(m_server), 511, Server::onConnection);
+    }
+    else {
+        ::close(fd);
+    }
+
+    if (r) {
+        LOG_ERR("[%s:%u] listen error: \"%s\"", m_host.data(), m_port, uv_strerror(r));
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Stops accepting connections, the listening socket is kept open so new connections wait in the backlog
+ * until resume() or until the process the socket was handed to accepts them.
+ */
+bool xmrig::Server::pause()
+{
+    if (m_paused >= 0) {
+        return true;
+    }
+
+    const int fd = this->fd();
+    if (fd < 0 || (m_paused = fcntl(fd, F_DUPFD_CLOEXEC, 0)) < 0) {
+        return false;
+    }
+
+    Handle::close(m_server);
+    init();
+
+    return true;
+}
+
+
+int xmrig::Server::fd() const
+{
+    if (m_paused >= 0) {
+        return m_paused;
+    }
+
+    uv_os_fd_t fd = -1;
+    uv_fileno(reinterpret_cast<const uv_handle_t*>(m_server), &fd);
+
+    return fd;
+}
+
+
+void xmrig::Server::resume()
+{
+    if (m_paused < 0) {
+        return;
+    }
+
+    const int fd = m_paused;
+    m_paused     = -1;
+
+    open(fd);
+}
+#endif
+
+
 void xmrig::Server::create(uv_stream_t *server, int status)
 {
     if (status < 0) {
@@ -91,6 +169,9 @@ void xmrig::Server::create(uv_stream_t *server, int status)
         return;
     }
 
+    miner->setCascadeAllowed(m_cascade);
+    miner->setMuxAllowed(m_mux);
+
     if (!miner->accept(server)) {
         delete miner;
         return;
@@ -100,6 +181,17 @@ void xmrig::Server::create(uv_stream_t *server, int status)
 }
 
 
+void xmrig::Server::init()
+{
+    m_server = new uv_tcp_t;
+
+    uv_tcp_init(uv_default_loop(), m_server);
+    m_server->data = this;
+
+    uv_tcp_nodelay(m_server, 1);
+}
+
+
 void xmrig::Server::onConnection(uv_stream_t *server, int status)
 {
     static_cast<Server*>(server->data)->create(server, status);
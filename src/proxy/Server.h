@@ -48,17 +48,31 @@ public:
     Server(const BindHost &host, const TlsContext *ctx);
     ~Server();
 
+    inline const String &host() const { return m_host; }
+    inline uint16_t port() const      { return m_port; }
+
     bool bind();
 
+#   ifdef XMRIG_OS_UNIX
+    bool open(int fd);
+    bool pause();
+    int fd() const;
+    void resume();
+#   endif
+
 private:
     void create(uv_stream_t *server, int status);
+    void init();
 
     static void onConnection(uv_stream_t *server, int status);
 
+    const bool m_cascade;
+    const bool m_mux;
     const bool m_strictTls;
     const String m_host;
     const TlsContext *m_ctx;
     const uint16_t m_port;
+    int m_paused            = -1;
     int m_version           = 0;
     sockaddr_storage m_addr{};
     uv_tcp_t *m_server;
@@ -29,6 +29,7 @@
 #include "Counters.h"
 #include "interfaces/ISplitter.h"
 #include "proxy/events/AcceptEvent.h"
+#include "proxy/state/StateRecord.h"
 #include "proxy/Stats.h"
 
 
@@ -44,6 +45,27 @@ xmrig::Stats::~Stats()
 }
 
 
+void xmrig::Stats::restore(const StateHeader &header, const uint32_t *history, size_t gap)
+{
+    m_data.accepted     = header.accepted;
+    m_data.donateHashes = header.donateHashes;
+    m_data.hashes       = header.hashes;
+    m_data.invalid      = header.invalid;
+    m_data.rejected     = header.rejected;
+
+    std::copy(std::begin(header.topDiff), std::end(header.topDiff), m_data.topDiff.begin());
+
+    if (history) {
+        m_hashrate.restore(history, header.statsHistory, gap);
+    }
+
+    Counters::restore(header.maxMiners, header.expired);
+
+    m_data.maxMiners = Counters::maxMiners();
+    m_data.expired   = Counters::expired;
+}
+
+
 void xmrig::Stats::tick(uint64_t ticks, const ISplitter *splitter)
 {
     ticks++;
@@ -60,6 +82,7 @@ void xmrig::Stats::tick(uint64_t ticks, const ISplitter *splitter)
         m_data.hashrate[5] = hashrate(static_cast<int>(m_data.uptime()));
 
         m_data.upstreams = splitter->upstreams();
+        m_data.reload    = splitter->reloadStatus();
         m_data.miners    = Counters::miners();
         m_data.maxMiners = Counters::maxMiners();
         m_data.expired   = Counters::expired;
@@ -40,6 +40,7 @@ namespace xmrig {
 class AcceptEvent;
 class Controller;
 class ISplitter;
+struct StateHeader;
 
 
 class Stats : public IEventListener
@@ -48,10 +49,13 @@ public:
     Stats(Controller *controller);
     ~Stats() override;
 
+    void restore(const StateHeader &header, const uint32_t *history, size_t gap);
     void tick(uint64_t ticks, const ISplitter *splitter);
 
-    inline const StatsData &data() const      { return m_data; }
-    inline double hashrate(int seconds) const { return m_hashrate.calc(seconds); }
+    inline const StatsData &data() const                  { return m_data; }
+    inline const std::vector<uint32_t> &history() const   { return m_hashrate.data(); }
+    inline double hashrate(int seconds) const             { return m_hashrate.calc(seconds); }
+    inline size_t tickTime() const                        { return m_hashrate.tickTime(); }
 
 protected:
     void onEvent(IEvent *event) override;
@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
 #include <vector>
 
 
@@ -72,6 +73,30 @@ public:
     inline uint64_t uptime() const { return (Chrono::currentMSecsSinceEpoch() - startTime) / 1000; }
 
 
+    // Copy of everything except the per-share latency samples, which grow with the number of shares.
+    inline StatsData counters() const
+    {
+        StatsData out;
+        out.topDiff      = topDiff;
+        out.accepted     = accepted;
+        out.connections  = connections;
+        out.donateHashes = donateHashes;
+        out.expired      = expired;
+        out.hashes       = hashes;
+        out.invalid      = invalid;
+        out.maxMiners    = maxMiners;
+        out.miners       = miners;
+        out.rejected     = rejected;
+        out.startTime    = startTime;
+        out.reload       = reload;
+        out.upstreams    = upstreams;
+
+        std::copy(std::begin(hashrate), std::end(hashrate), std::begin(out.hashrate));
+
+        return out;
+    }
+
+
     inline StatsData &operator+=(const StatsData &other)
     {
         upstreams    += other.upstreams;
@@ -104,6 +129,7 @@ public:
     uint64_t miners         = 0;
     uint64_t rejected       = 0;
     uint64_t startTime      = 0;
+    ReloadStatus reload;
     Upstreams upstreams;
 };
 
@@ -55,9 +55,18 @@ public:
     }
 
 
-    inline size_t tickTime() const { return m_tickTime; }
-    inline void add(T count)       { m_pending += count; }
-    inline void tick()             { m_data.push_back(m_pending); m_pending = 0; }
+    inline const std::vector<T> &data() const { return m_data; }
+    inline size_t tickTime() const            { return m_tickTime; }
+    inline void add(T count)                  { m_pending += count; }
+    inline void tick()                        { m_data.push_back(m_pending); m_pending = 0; }
+
+
+    // Previously saved samples followed by empty samples for the time the counter was not ticking.
+    inline void restore(const T *data, size_t size, size_t gap)
+    {
+        m_data.assign(data, data + size);
+        m_data.insert(m_data.end(), gap, 0);
+    }
 
 private:
     size_t m_tickTime;
@@ -0,0 +1,784 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "proxy/Upgrade.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Arguments.h"
+#include "base/tools/Handle.h"
+#include "base/tools/Timer.h"
+#include "proxy/interfaces/IUpgradeListener.h"
+#include "proxy/Miner.h"
+#include "proxy/Miners.h"
+#include "proxy/Server.h"
+
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <uv.h>
+
+
+extern char **environ;
+
+
+namespace xmrig {
+
+
+static const char *kEnvName         = "XMRIG_UPGRADE_FD";
+static const uint32_t kMaxMessage   = 256 * 1024;
+static const uint32_t kNullString   = 0xFFFFFFFFU;
+
+
+enum MessageType : uint32_t {
+    HelloMessage,
+    ListenerMessage,
+    MinerMessage,
+    EndMessage,
+    AckMessage
+};
+
+
+struct MessageHeader
+{
+    uint32_t type;
+    uint32_t size;
+};
+
+
+class MessageReader
+{
+public:
+    inline explicit MessageReader(const std::string &data) : m_data(data) {}
+
+    inline bool isFailed() const { return !m_valid; }
+    inline bool isValid() const  { return m_valid && m_pos == m_data.size(); }
+
+    template<typename T>
+    inline T get()
+    {
+        T value{};
+        if (!take(sizeof(T))) {
+            return value;
+        }
+
+        memcpy(&value, m_data.data() + m_pos - sizeof(T), sizeof(T));
+
+        return value;
+    }
+
+    inline String getString()
+    {
+        const auto size = get<uint32_t>();
+        if (size == kNullString || !take(size)) {
+            return {};
+        }
+
+        return { m_data.data() + m_pos - size, size };
+    }
+
+    inline std::string getData()
+    {
+        const auto size = get<uint32_t>();
+        if (!take(size)) {
+            return {};
+        }
+
+        return m_data.substr(m_pos - size, size);
+    }
+
+private:
+    inline bool take(size_t size)
+    {
+        if (!m_valid || m_data.size() - m_pos < size) {
+            m_valid = false;
+
+            return false;
+        }
+
+        m_pos += size;
+
+        return true;
+    }
+
+    bool m_valid = true;
+    const std::string &m_data;
+    size_t m_pos = 0;
+};
+
+
+template<typename T>
+static inline void put(std::string &out, T value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+
+static inline void put(std::string &out, const String &value)
+{
+    put<uint32_t>(out, value.isNull() ? kNullString : static_cast<uint32_t>(value.size()));
+    out.append(value.isNull() ? "" : value.data(), value.size());
+}
+
+
+static inline void put(std::string &out, const std::string &value)
+{
+    put<uint32_t>(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+
+static bool wait(int channel, int timeout)
+{
+    pollfd pfd{};
+    pfd.fd     = channel;
+    pfd.events = POLLIN;
+
+    int rc = 0;
+    do {
+        rc = poll(&pfd, 1, timeout);
+    } while (rc < 0 && errno == EINTR);
+
+    return rc > 0;
+}
+
+
+static std::string message(uint32_t type, const std::string &payload)
+{
+    const MessageHeader header{ type, static_cast<uint32_t>(payload.size()) };
+
+    std::string data(reinterpret_cast<const char *>(&header), sizeof(header));
+    data.append(payload);
+
+    return data;
+}
+
+
+/**
+ * The descriptor is attached to the first chunk of a message, the rest of the stream is written as is.
+ */
+static ssize_t sendData(int channel, const char *data, size_t size, int fd)
+{
+    iovec iov{};
+    iov.iov_base = const_cast<char *>(data);
+    iov.iov_len  = size;
+
+    char control[CMSG_SPACE(sizeof(int))]{};
+
+    msghdr msg{};
+    msg.msg_iov    = &iov;
+    msg.msg_iovlen = 1;
+
+    if (fd >= 0) {
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        cmsghdr *cmsg   = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t rc = 0;
+    do {
+        rc = sendmsg(channel, &msg, MSG_NOSIGNAL);
+    } while (rc < 0 && errno == EINTR);
+
+    return rc;
+}
+
+
+static bool writeMessage(int channel, MessageType type, const std::string &payload, int fd = -1)
+{
+    const std::string data = message(type, payload);
+    size_t written         = 0;
+
+    while (written < data.size()) {
+        const ssize_t rc = sendData(channel, data.data() + written, data.size() - written, written == 0 ? fd : -1);
+        if (rc <= 0) {
+            return false;
+        }
+
+        written += static_cast<size_t>(rc);
+    }
+
+    return true;
+}
+
+
+static void closeFd(int &fd)
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+
+static bool receiveMessage(int channel, int timeout, uint32_t &type, std::string &payload, int &fd)
+{
+    MessageHeader header{};
+    size_t received = 0;
+
+    while (received < sizeof(header)) {
+        if (!wait(channel, timeout)) {
+            return false;
+        }
+
+        iovec iov{};
+        iov.iov_base = reinterpret_cast<char *>(&header) + received;
+        iov.iov_len  = sizeof(header) - received;
+
+        char control[CMSG_SPACE(sizeof(int))]{};
+
+        msghdr msg{};
+        msg.msg_iov        = &iov;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        const ssize_t rc = recvmsg(channel, &msg, 0);
+        if (rc < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+
+        if (rc <= 0) {
+            return false;
+        }
+
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && fd < 0) {
+                memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+        }
+
+        received += static_cast<size_t>(rc);
+    }
+
+    if (header.size > kMaxMessage) {
+        return false;
+    }
+
+    type = header.type;
+    payload.resize(header.size);
+    received = 0;
+
+    while (received < payload.size()) {
+        if (!wait(channel, timeout)) {
+            return false;
+        }
+
+        const ssize_t rc = recv(channel, &payload[received], payload.size() - received, 0);
+        if (rc < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+
+        if (rc <= 0) {
+            return false;
+        }
+
+        received += static_cast<size_t>(rc);
+    }
+
+    return true;
+}
+
+
+/**
+ * A descriptor received with a message that can't be read completely is closed, the caller gets it only on success.
+ */
+static bool readMessage(int channel, int timeout, uint32_t &type, std::string &payload, int &fd)
+{
+    fd = -1;
+
+    if (receiveMessage(channel, timeout, type, payload, fd)) {
+        return true;
+    }
+
+    closeFd(fd);
+
+    return false;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Upgrade::~Upgrade()
+{
+    Handle::close(m_poll);
+    delete m_timer;
+
+    closeFd(m_channel);
+
+    for (auto &listener : m_listeners) {
+        closeFd(listener.fd);
+    }
+
+    for (auto &miner : m_miners) {
+        closeFd(miner.fd);
+    }
+}
+
+
+bool xmrig::Upgrade::isChild()
+{
+    return getenv(kEnvName) != nullptr;
+}
+
+
+bool xmrig::Upgrade::receive()
+{
+    m_channel = atoi(getenv(kEnvName));
+    unsetenv(kEnvName);
+
+    if (m_channel <= STDERR_FILENO || fcntl(m_channel, F_SETFD, FD_CLOEXEC) != 0) {
+        m_channel = -1;
+
+        return false;
+    }
+
+    std::string payload;
+    put(payload, kVersion);
+
+    if (!writeMessage(m_channel, HelloMessage, payload)) {
+        return false;
+    }
+
+    uint32_t type = 0;
+    int fd        = -1;
+
+    while (readMessage(m_channel, kTimeout, type, payload, fd)) {
+        MessageReader reader(payload);
+
+        if (type == ListenerMessage) {
+            Listener listener{ fd, {}, 0 };
+            listener.port = reader.get<uint16_t>();
+            listener.host = reader.getString();
+
+            m_listeners.emplace_back(std::move(listener));
+        }
+        else if (type == MinerMessage) {
+            MinerHandoff state;
+            state.fd         = fd;
+            state.loginId    = reader.get<int64_t>();
+            state.localPort  = reader.get<uint16_t>();
+            state.slots      = reader.get<uint16_t>();
+            state.customDiff = reader.get<uint64_t>();
+            state.rx         = reader.get<uint64_t>();
+            state.timestamp  = reader.get<uint64_t>();
+            state.tx         = reader.get<uint64_t>();
+            state.rpcId      = reader.getString();
+            state.user       = reader.getString();
+            state.password   = reader.getString();
+            state.agent      = reader.getString();
+            state.rigId      = reader.getString();
+            state.buffered   = reader.getData();
+            state.cascade    = reader.get<uint8_t>() != 0;
+            state.mux        = reader.get<uint8_t>() != 0;
+
+            const auto algorithms = reader.get<uint32_t>();
+            for (uint32_t i = 0; i < algorithms && !reader.isFailed(); ++i) {
+                const String name = reader.getString();
+                const Algorithm algorithm(name.data());
+                if (algorithm.isValid()) {
+                    state.algorithms.emplace_back(algorithm);
+                }
+            }
+
+            m_miners.emplace_back(std::move(state));
+        }
+        else if (type == EndMessage && fd < 0) {
+            if (reader.get<uint32_t>() != m_miners.size() || !reader.isValid()) {
+                return false;
+            }
+
+            payload.clear();
+            put(payload, static_cast<uint32_t>(m_miners.size()));
+
+            if (!writeMessage(m_channel, AckMessage, payload)) {
+                return false;
+            }
+
+            closeFd(m_channel);
+
+            LOG_INFO("%s " WHITE_BOLD("upgrade") " received " CYAN_BOLD("%zu") " listeners and " CYAN_BOLD("%zu") " miners from the previous process",
+                     Tags::proxy(), m_listeners.size(), m_miners.size());
+
+            return true;
+        }
+        else {
+            closeFd(fd);
+
+            return false;
+        }
+
+        if (fd < 0 || !reader.isValid()) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+bool xmrig::Upgrade::send(const Arguments &arguments, const std::vector<Server *> &servers, const Miners *miners, IUpgradeListener *listener)
+{
+    if (!spawn(arguments)) {
+        return false;
+    }
+
+    m_listener = listener;
+    m_servers  = &servers;
+    m_source   = miners;
+    m_step     = HelloStep;
+
+    m_poll       = new uv_poll_t;
+    m_poll->data = this;
+
+    uv_poll_init(uv_default_loop(), m_poll, m_channel);
+    uv_poll_start(m_poll, UV_READABLE, onPoll);
+
+    m_timer = new Timer(this);
+    m_timer->singleShot(kTimeout);
+
+    return true;
+}
+
+
+int xmrig::Upgrade::takeListener(const char *host, uint16_t port)
+{
+    for (auto &listener : m_listeners) {
+        if (listener.fd >= 0 && listener.port == port && listener.host == host) {
+            const int fd = listener.fd;
+            listener.fd  = -1;
+
+            return fd;
+        }
+    }
+
+    return -1;
+}
+
+
+size_t xmrig::Upgrade::restore()
+{
+    size_t count = 0;
+
+    for (auto &state : m_miners) {
+        auto miner = new Miner(nullptr, state.localPort, false);
+
+        if (!miner->restore(state)) {
+            delete miner;
+            continue;
+        }
+
+        state.fd = -1;
+        ++count;
+    }
+
+    return count;
+}
+
+
+bool xmrig::Upgrade::spawn(const Arguments &arguments)
+{
+    int fds[2] = { -1, -1 };
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        LOG_ERR("%s " RED("upgrade failed: socketpair error: \"%s\""), Tags::proxy(), strerror(errno));
+
+        return false;
+    }
+
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    const std::string prefix = std::string(kEnvName) + "=";
+    const std::string value  = prefix + "3";
+
+    std::vector<char *> env;
+    for (char **i = environ; *i; ++i) {
+        if (strncmp(*i, prefix.c_str(), prefix.size()) != 0) {
+            env.push_back(*i);
+        }
+    }
+
+    env.push_back(const_cast<char *>(value.c_str()));
+    env.push_back(nullptr);
+
+    uv_stdio_container_t stdio[4]{};
+    for (int i = 0; i < 3; ++i) {
+        stdio[i].flags   = UV_INHERIT_FD;
+        stdio[i].data.fd = i;
+    }
+
+    stdio[3].flags   = UV_INHERIT_FD;
+    stdio[3].data.fd = fds[1];
+
+    uv_process_options_t options{};
+    options.file        = arguments.argv()[0];
+    options.args        = arguments.argv();
+    options.env         = env.data();
+    options.stdio       = stdio;
+    options.stdio_count = 4;
+    options.exit_cb     = [](uv_process_t *process, int64_t, int) { Handle::close(process); };
+
+    m_process = new uv_process_t;
+
+    const int rc = uv_spawn(uv_default_loop(), m_process, &options);
+    ::close(fds[1]);
+
+    if (rc != 0) {
+        LOG_ERR("%s " RED("upgrade failed: unable to start \"%s\": \"%s\""), Tags::proxy(), options.file, uv_strerror(rc));
+
+        Handle::close(m_process);
+        m_process = nullptr;
+        ::close(fds[0]);
+
+        return false;
+    }
+
+    uv_unref(reinterpret_cast<uv_handle_t *>(m_process));
+    m_channel = fds[0];
+
+    // A stalled new process must not block the event loop, writes are driven by the poll handle.
+    fcntl(m_channel, F_SETFL, fcntl(m_channel, F_GETFL) | O_NONBLOCK);
+
+    LOG_INFO("%s " WHITE_BOLD("upgrade") " started new process " CYAN_BOLD("%d"), Tags::proxy(), m_process->pid);
+
+    return true;
+}
+
+
+void xmrig::Upgrade::finish(bool success)
+{
+    if (!m_poll) {
+        return;
+    }
+
+    Handle::close(m_poll);
+    m_poll = nullptr;
+    m_timer->stop();
+
+    // Descriptors of queued messages belong to the servers and miners.
+    m_queue.clear();
+    m_offset = 0;
+
+    if (success) {
+        LOG_INFO("%s " WHITE_BOLD("upgrade") " handed " CYAN_BOLD("%zu") " listeners and " CYAN_BOLD("%zu") "/" CYAN_BOLD("%zu") " miners to the new process",
+                 Tags::proxy(), m_servers->size(), m_handed.size(), m_total);
+    }
+    else {
+        kill();
+
+        for (Server *server : *m_servers) {
+            server->resume();
+        }
+
+        for (Miner *miner : m_handed) {
+            miner->resume();
+        }
+
+        if (m_step == HelloStep) {
+            LOG_ERR("%s " RED("upgrade failed: new process did not respond"), Tags::proxy());
+        }
+        else {
+            LOG_ERR("%s " RED("upgrade failed: handoff to the new process was not acknowledged"), Tags::proxy());
+        }
+    }
+
+    m_handed.clear();
+    m_listener->onUpgrade(success);
+}
+
+
+void xmrig::Upgrade::handoff()
+{
+    std::string payload;
+    m_step = AckStep;
+    m_timer->singleShot(kTimeout);
+
+    // The old process stops accepting as soon as the listeners are handed over, connections that arrive from now
+    // on wait in the backlog for the new process and are not dropped when this one exits.
+    for (Server *server : *m_servers) {
+        if (!server->pause()) {
+            return finish(false);
+        }
+
+        payload.clear();
+        put(payload, server->port());
+        put(payload, server->host());
+
+        post(ListenerMessage, payload, server->fd());
+    }
+
+    const std::vector<Miner *> miners = m_source->miners();
+    m_handed.reserve(miners.size());
+    m_total = miners.size();
+
+    for (Miner *miner : miners) {
+        MinerHandoff state;
+        if (!miner->handoff(state)) {
+            continue;
+        }
+
+        // Until the new process answers the connection is neither written to nor closed by this one.
+        m_handed.push_back(miner);
+        miner->release();
+
+        payload.clear();
+        put(payload, state.loginId);
+        put(payload, state.localPort);
+        put(payload, state.slots);
+        put(payload, state.customDiff);
+        put(payload, state.rx);
+        put(payload, state.timestamp);
+        put(payload, state.tx);
+        put(payload, state.rpcId);
+        put(payload, state.user);
+        put(payload, state.password);
+        put(payload, state.agent);
+        put(payload, state.rigId);
+        put(payload, state.buffered);
+        put<uint8_t>(payload, state.cascade);
+        put<uint8_t>(payload, state.mux);
+        put(payload, static_cast<uint32_t>(state.algorithms.size()));
+
+        // Algorithms are passed by name, the new binary may number them differently.
+        for (const Algorithm &algorithm : state.algorithms) {
+            put(payload, String(algorithm.name()));
+        }
+
+        post(MinerMessage, payload, state.fd);
+    }
+
+    payload.clear();
+    put(payload, static_cast<uint32_t>(m_handed.size()));
+
+    post(EndMessage, payload);
+    write();
+}
+
+
+void xmrig::Upgrade::kill()
+{
+    closeFd(m_channel);
+
+    if (m_process) {
+        uv_process_kill(m_process, SIGTERM);
+        m_process = nullptr;
+    }
+}
+
+
+void xmrig::Upgrade::post(uint32_t type, const std::string &payload, int fd)
+{
+    m_queue.push_back({ fd, message(type, payload) });
+}
+
+
+void xmrig::Upgrade::onTimer(const Timer *)
+{
+    finish(false);
+}
+
+
+/**
+ * Only the first bytes of a message wake the loop up, the rest of it is already on the way.
+ */
+void xmrig::Upgrade::read(int status)
+{
+    uint32_t type = 0;
+    int fd        = -1;
+    std::string payload;
+
+    if (status < 0 || !readMessage(m_channel, kReadTimeout, type, payload, fd)) {
+        closeFd(fd);
+
+        return finish(false);
+    }
+
+    closeFd(fd);
+
+    if (m_step == HelloStep) {
+        if (type != HelloMessage || MessageReader(payload).get<uint32_t>() != kVersion) {
+            return finish(false);
+        }
+
+        return handoff();
+    }
+
+    finish(type == AckMessage && MessageReader(payload).get<uint32_t>() == m_handed.size());
+}
+
+
+/**
+ * Writes the queued messages until the channel is full, the rest is written when the poll reports it writable.
+ * The whole handoff is bounded by the timer, a new process that stops reading can't stall this one.
+ */
+void xmrig::Upgrade::write()
+{
+    while (!m_queue.empty()) {
+        const Message &message = m_queue.front();
+        const ssize_t rc       = sendData(m_channel, message.data.data() + m_offset, message.data.size() - m_offset, m_offset == 0 ? message.fd : -1);
+
+        if (rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            uv_poll_start(m_poll, UV_READABLE | UV_WRITABLE, onPoll);
+
+            return;
+        }
+
+        if (rc <= 0) {
+            return finish(false);
+        }
+
+        m_offset += static_cast<size_t>(rc);
+
+        if (m_offset == message.data.size()) {
+            m_queue.pop_front();
+            m_offset = 0;
+        }
+    }
+
+    uv_poll_start(m_poll, UV_READABLE, onPoll);
+}
+
+
+void xmrig::Upgrade::onPoll(uv_poll_t *handle, int status, int events)
+{
+    auto upgrade = static_cast<Upgrade *>(handle->data);
+
+    if (status == 0 && (events & UV_WRITABLE)) {
+        upgrade->write();
+
+        if (!upgrade->isActive() || !(events & UV_READABLE)) {
+            return;
+        }
+    }
+
+    upgrade->read(status);
+}
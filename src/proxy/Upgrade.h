@@ -0,0 +1,157 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_UPGRADE_H
+#define XMRIG_UPGRADE_H
+
+
+#include <deque>
+#include <string>
+#include <vector>
+
+
+#include "base/crypto/Algorithm.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+using uv_poll_t    = struct uv_poll_s;
+using uv_process_t = struct uv_process_s;
+
+
+namespace xmrig {
+
+
+class Arguments;
+class IUpgradeListener;
+class Miner;
+class Miners;
+class Server;
+class Timer;
+
+
+struct MinerHandoff
+{
+    Algorithms algorithms;
+    bool cascade        = false;
+    bool mux            = false;
+    int fd              = -1;
+    int64_t loginId     = 0;
+    std::string buffered;
+    String agent;
+    String password;
+    String rigId;
+    String rpcId;
+    String user;
+    uint16_t localPort  = 0;
+    uint16_t slots      = 0;
+    uint64_t customDiff = 0;
+    uint64_t rx         = 0;
+    uint64_t timestamp  = 0;
+    uint64_t tx         = 0;
+};
+
+
+/**
+ * Hot binary upgrade (SIGUSR2).
+ *
+ * The running process spawns a new copy of itself and passes the listening sockets and logged in plain TCP
+ * miner connections over a Unix domain socket (SCM_RIGHTS), the new process replays the miners logins and
+ * the old one exits without closing the connections. Upstream sessions are not transferred, so miners get
+ * a new job (and a new fixed byte in NiceHash mode) from the new process.
+ *
+ * The old process keeps serving miners while it waits for the new one, the channel is non-blocking and polled
+ * by the event loop, both for the replies and for the queued handoff messages, and the result is reported to
+ * the listener.
+ */
+class Upgrade : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(Upgrade)
+
+    Upgrade() = default;
+    ~Upgrade() override;
+
+    static bool isChild();
+
+    inline bool isActive() const { return m_poll != nullptr; }
+
+    bool receive();
+    bool send(const Arguments &arguments, const std::vector<Server *> &servers, const Miners *miners, IUpgradeListener *listener);
+    int takeListener(const char *host, uint16_t port);
+    size_t restore();
+
+protected:
+    void onTimer(const Timer *timer) override;
+
+private:
+    constexpr static uint32_t kVersion  = 2;
+    constexpr static int kReadTimeout   = 100;
+    constexpr static int kTimeout       = 10 * 1000;
+
+    enum Step {
+        HelloStep,
+        AckStep
+    };
+
+    struct Listener
+    {
+        int fd;
+        String host;
+        uint16_t port;
+    };
+
+    struct Message
+    {
+        int fd;
+        std::string data;
+    };
+
+    bool spawn(const Arguments &arguments);
+    void finish(bool success);
+    void handoff();
+    void kill();
+    void post(uint32_t type, const std::string &payload, int fd = -1);
+    void read(int status);
+    void write();
+
+    static void onPoll(uv_poll_t *handle, int status, int events);
+
+    const Miners *m_source                  = nullptr;
+    const std::vector<Server *> *m_servers  = nullptr;
+    int m_channel                           = -1;
+    IUpgradeListener *m_listener            = nullptr;
+    Step m_step                             = HelloStep;
+    std::vector<Listener> m_listeners;
+    std::vector<Miner *> m_handed;
+    std::vector<MinerHandoff> m_miners;
+    size_t m_offset                         = 0;
+    size_t m_total                          = 0;
+    std::deque<Message> m_queue;
+    Timer *m_timer                          = nullptr;
+    uv_poll_t *m_poll                       = nullptr;
+    uv_process_t *m_process                 = nullptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_UPGRADE_H */
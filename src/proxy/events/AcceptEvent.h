@@ -35,12 +35,15 @@
 namespace xmrig {
 
 
+class Pool;
+
+
 class AcceptEvent : public MinerEvent
 {
 public:
-    static inline bool start(size_t mapperId, Miner *miner, const SubmitResult &result, bool donate, bool customDiff, const char *error = nullptr)
+    static inline bool start(size_t mapperId, Miner *miner, const SubmitResult &result, bool donate, bool customDiff, const char *error = nullptr, const Pool *pool = nullptr)
     {
-        return exec(new (m_buf) AcceptEvent(mapperId, miner, result, donate, customDiff, error));
+        return exec(new (m_buf) AcceptEvent(mapperId, miner, result, donate, customDiff, error, pool));
     }
 
 
@@ -51,17 +54,19 @@ public:
     inline bool isDonate() const            { return m_donate; }
     inline bool isRejected() const override { return m_error != nullptr; }
     inline const char *error() const        { return m_error; }
+    inline const Pool *pool() const         { return m_pool; }
     inline size_t mapperId() const          { return m_mapperId; }
     inline uint64_t statsDiff() const       { return (miner() && miner()->customDiff() ? std::min(miner()->customDiff(), result.diff) : result.diff); }
 
 
 protected:
-    inline AcceptEvent(size_t mapperId, Miner *miner, const SubmitResult &result, bool donate, bool customDiff, const char *error)
+    inline AcceptEvent(size_t mapperId, Miner *miner, const SubmitResult &result, bool donate, bool customDiff, const char *error, const Pool *pool)
         : MinerEvent(AcceptType, miner),
           result(result),
           m_customDiff(customDiff),
           m_donate(donate),
           m_error(error),
+          m_pool(pool),
           m_mapperId(mapperId)
     {}
 
@@ -70,6 +75,7 @@ private:
     bool m_customDiff;
     bool m_donate;
     const char *m_error;
+    const Pool *m_pool;
     size_t m_mapperId;
 };
 
@@ -67,11 +67,37 @@ public:
 };
 
 
+class ReloadStatus
+{
+public:
+    enum State {
+        IdleState,
+        RollingState,
+        HaltedState,
+        DoneState
+    };
+
+    static inline const char *stateName(State state)
+    {
+        static const char *names[] = { "idle", "rolling", "halted", "done" };
+
+        return names[state];
+    }
+
+    State state      = IdleState;
+    uint64_t done    = 0;
+    uint64_t failed  = 0;
+    uint64_t pending = 0;
+    uint64_t total   = 0;
+};
+
+
 class ISplitter
 {
 public:
     virtual ~ISplitter() = default;
 
+    virtual ReloadStatus reloadStatus() const = 0;
     virtual Upstreams upstreams() const      = 0;
     virtual void connect()                   = 0;
     virtual void gc()                        = 0;
@@ -45,6 +45,8 @@ xmrig::AccessLog::AccessLog(Controller *controller)
     const char *fileName = controller->config()->accessLog();
     if (fileName) {
         m_writer.open(fileName);
+        m_writer.setFsync(controller->config()->logFsync());
+        m_writer.setRotate(controller->config()->logRotateSize(), controller->config()->logRotateInterval(), controller->config()->isLogRotateCompress());
     }
 }
 
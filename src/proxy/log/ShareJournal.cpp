@@ -0,0 +1,359 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "proxy/log/ShareJournal.h"
+#include "base/io/Env.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "proxy/events/AcceptEvent.h"
+#include "proxy/log/ShareRecord.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+
+namespace xmrig {
+
+
+struct ShareJournal::Segment
+{
+    inline ShareJournalHeader *header() const   { return reinterpret_cast<ShareJournalHeader *>(data); }
+    inline ShareRecord *records() const         { return reinterpret_cast<ShareRecord *>(data + sizeof(ShareJournalHeader)); }
+    inline bool isFull() const                  { return count == capacity; }
+
+    std::string path;
+    uint8_t *data   = nullptr;
+    size_t capacity = 0;
+    size_t count    = 0;
+    size_t size     = 0;
+
+#   ifdef _WIN32
+    HANDLE file     = INVALID_HANDLE_VALUE;
+    HANDLE mapping  = nullptr;
+#   else
+    int fd          = -1;
+#   endif
+};
+
+
+} // namespace xmrig
+
+
+xmrig::ShareJournal::ShareJournal(Controller *controller)
+{
+    const Config *config = controller->config();
+    if (config->shareJournal().isNull()) {
+        return;
+    }
+
+    m_prefix  = Env::expand(config->shareJournal()).data();
+    m_size    = static_cast<size_t>(std::max(config->shareJournalSegment(), 1U)) * 1024 * 1024;
+    m_started = Chrono::currentMSecsSinceEpoch();
+
+    rotate();
+
+    if (!m_current) {
+        return;
+    }
+
+    m_thread = std::thread(&ShareJournal::run, this);
+}
+
+
+xmrig::ShareJournal::~ShareJournal()
+{
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_cv.notify_one();
+        m_thread.join();
+    }
+
+    for (Segment *segment : m_closing) {
+        close(segment);
+    }
+
+    close(m_current);
+    close(m_next);
+}
+
+
+void xmrig::ShareJournal::onEvent(IEvent *event)
+{
+    if (event->type() == IEvent::AcceptType) {
+        add(static_cast<AcceptEvent *>(event));
+    }
+}
+
+
+void xmrig::ShareJournal::onRejectedEvent(IEvent *event)
+{
+    if (event->type() == IEvent::AcceptType) {
+        add(static_cast<AcceptEvent *>(event));
+    }
+}
+
+
+xmrig::ShareJournal::Segment *xmrig::ShareJournal::create(const std::string &path, size_t size)
+{
+    auto segment      = new Segment();
+    segment->path     = path;
+    segment->size     = size;
+    segment->capacity = (size - sizeof(ShareJournalHeader)) / sizeof(ShareRecord);
+
+#   ifdef _WIN32
+    segment->file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (segment->file != INVALID_HANDLE_VALUE) {
+        segment->mapping = CreateFileMappingA(segment->file, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+    }
+
+    if (segment->mapping) {
+        segment->data = static_cast<uint8_t *>(MapViewOfFile(segment->mapping, FILE_MAP_WRITE, 0, 0, size));
+    }
+#   else
+    segment->fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (segment->fd >= 0) {
+#       ifdef __linux__
+        // Allocate blocks up front, so the event loop never waits for the filesystem on a page fault.
+        const bool allocated = posix_fallocate(segment->fd, 0, static_cast<off_t>(size)) == 0;
+#       else
+        constexpr bool allocated = false;
+#       endif
+
+        if (allocated || ftruncate(segment->fd, static_cast<off_t>(size)) == 0) {
+            int flags = MAP_SHARED;
+#           ifdef MAP_POPULATE
+            flags |= MAP_POPULATE;
+#           endif
+
+            void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, segment->fd, 0);
+            if (data != MAP_FAILED) {
+                segment->data = static_cast<uint8_t *>(data);
+            }
+        }
+    }
+#   endif
+
+    if (!segment->data) {
+#       ifdef _WIN32
+        LOG_ERR("%s " RED("failed to create share journal segment \"%s\", error %lu"), Tags::proxy(), path.c_str(), GetLastError());
+#       else
+        LOG_ERR("%s " RED("failed to create share journal segment \"%s\": %s"), Tags::proxy(), path.c_str(), strerror(errno));
+#       endif
+
+        close(segment);
+
+        return nullptr;
+    }
+
+    ShareJournalHeader *header = segment->header();
+    memcpy(header->magic, ShareJournalHeader::kMagic, sizeof(header->magic));
+    header->version    = ShareJournalHeader::kVersion;
+    header->recordSize = sizeof(ShareRecord);
+
+    return segment;
+}
+
+
+void xmrig::ShareJournal::close(Segment *segment)
+{
+    if (!segment) {
+        return;
+    }
+
+    const size_t used = sizeof(ShareJournalHeader) + segment->count * sizeof(ShareRecord);
+
+#   ifdef _WIN32
+    if (segment->data) {
+        FlushViewOfFile(segment->data, 0);
+        UnmapViewOfFile(segment->data);
+    }
+
+    if (segment->mapping) {
+        CloseHandle(segment->mapping);
+    }
+
+    if (segment->file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER offset;
+        offset.QuadPart = static_cast<LONGLONG>(used);
+
+        if (SetFilePointerEx(segment->file, offset, nullptr, FILE_BEGIN)) {
+            SetEndOfFile(segment->file);
+        }
+
+        FlushFileBuffers(segment->file);
+        CloseHandle(segment->file);
+
+        if (segment->count == 0) {
+            DeleteFileA(segment->path.c_str());
+        }
+    }
+#   else
+    if (segment->data) {
+        msync(segment->data, segment->size, MS_SYNC);
+        munmap(segment->data, segment->size);
+    }
+
+    if (segment->fd >= 0) {
+        if (ftruncate(segment->fd, static_cast<off_t>(used)) == 0) {
+            fsync(segment->fd);
+        }
+
+        ::close(segment->fd);
+
+        if (segment->count == 0) {
+            unlink(segment->path.c_str());
+        }
+    }
+#   endif
+
+    delete segment;
+}
+
+
+std::string xmrig::ShareJournal::nextPath()
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "-%" PRIu64 "-%06" PRIu64 ".jrnl", m_started, m_sequence++);
+
+    return m_prefix + buf;
+}
+
+
+void xmrig::ShareJournal::add(const AcceptEvent *event)
+{
+    if (m_prefix.empty()) {
+        return;
+    }
+
+    if (!m_current || m_current->isFull()) {
+        rotate();
+
+        if (!m_current) {
+            return;
+        }
+    }
+
+    const Miner *miner = event->miner();
+    ShareRecord &record = m_current->records()[m_current->count];
+
+    record.timestamp  = Chrono::currentMSecsSinceEpoch();
+    record.minerId    = miner ? miner->id() : -1;
+    record.workerHash = miner ? ShareRecord::hash(miner->rigId(true).data()) : 0;
+    record.diff       = event->result.diff;
+    record.actualDiff = event->result.actualDiff;
+    record.mapperId   = static_cast<uint32_t>(event->mapperId());
+    record.latency    = static_cast<uint32_t>(std::min<uint64_t>(event->result.elapsed, UINT32_MAX));
+    record.result     = event->isRejected() ? ShareRecord::Rejected : ShareRecord::Accepted;
+    record.flags      = (event->isDonate() ? ShareRecord::Donate : 0) | (event->isCustomDiff() ? ShareRecord::CustomDiff : 0);
+
+    m_current->header()->count = ++m_current->count;
+}
+
+
+void xmrig::ShareJournal::rotate()
+{
+    const bool retire = m_current != nullptr;
+    Segment *next     = nullptr;
+    std::string path;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (retire) {
+            m_closing.push_back(m_current);
+        }
+
+        std::swap(next, m_next);
+
+        if (!next && (retire || !m_thread.joinable())) {
+            path = nextPath();
+        }
+    }
+
+    m_cv.notify_one();
+
+    // Slow path, only if the background thread could not keep up or failed to prepare a segment.
+    if (!next && !path.empty()) {
+        next = create(path, m_size);
+    }
+
+    m_current = next;
+
+    if (m_current) {
+        m_current->header()->created = Chrono::currentMSecsSinceEpoch();
+    }
+}
+
+
+void xmrig::ShareJournal::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_closing.empty() || !m_next; });
+
+        std::vector<Segment *> closing;
+        closing.swap(m_closing);
+
+        const bool stop          = m_stop;
+        const std::string path   = (!m_next && !stop) ? nextPath() : std::string();
+
+        lock.unlock();
+
+        for (Segment *segment : closing) {
+            close(segment);
+        }
+
+        Segment *next = path.empty() ? nullptr : create(path, m_size);
+
+        lock.lock();
+
+        if (next) {
+            m_next = next;
+        }
+        else if (!path.empty()) {
+            m_cv.wait_for(lock, std::chrono::seconds(5), [this] { return m_stop; });
+        }
+
+        if (stop && m_closing.empty()) {
+            break;
+        }
+    }
+}
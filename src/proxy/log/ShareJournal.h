@@ -0,0 +1,88 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_SHAREJOURNAL_H
+#define XMRIG_SHAREJOURNAL_H
+
+
+#include "base/tools/Object.h"
+#include "proxy/interfaces/IEventListener.h"
+
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class AcceptEvent;
+class Controller;
+
+
+/**
+ * Append-only binary journal of every accepted and rejected share.
+ *
+ * Records are copied into a memory-mapped segment file on the event loop, nothing else happens there:
+ * the next segment is created and preallocated ahead of time by a background thread, and full segments
+ * are synced, truncated and closed by the same thread.
+ */
+class ShareJournal : public IEventListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ShareJournal)
+
+    ShareJournal(Controller *controller);
+    ~ShareJournal() override;
+
+protected:
+    void onEvent(IEvent *event) override;
+    void onRejectedEvent(IEvent *event) override;
+
+private:
+    struct Segment;
+
+    static Segment *create(const std::string &path, size_t size);
+    static void close(Segment *segment);
+
+    std::string nextPath();
+    void add(const AcceptEvent *event);
+    void rotate();
+    void run();
+
+    bool m_stop         = false;
+    Segment *m_current  = nullptr;
+    Segment *m_next     = nullptr;
+    size_t m_size       = 0;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+    std::string m_prefix;
+    std::thread m_thread;
+    std::vector<Segment *> m_closing;
+    uint64_t m_sequence = 0;
+    uint64_t m_started  = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SHAREJOURNAL_H */
@@ -0,0 +1,93 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_SHARERECORD_H
+#define XMRIG_SHARERECORD_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * On-disk layout of the share journal, see doc/SHARE_JOURNAL.md.
+ *
+ * The header is kept free of other dependencies so the reader tool can include it directly.
+ * All fields are little endian, both structures are exactly 64 bytes.
+ */
+struct ShareJournalHeader
+{
+    constexpr static const char *kMagic = "XMRIGSJ1";
+    constexpr static uint32_t kVersion  = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t created;       // ms since epoch
+    uint64_t count;         // number of committed records, updated after every record
+    uint8_t reserved[32];
+};
+
+
+struct ShareRecord
+{
+    enum Result : uint8_t {
+        Accepted,
+        Rejected
+    };
+
+    enum Flags : uint8_t {
+        Donate     = 1,
+        CustomDiff = 2
+    };
+
+    uint64_t timestamp;     // ms since epoch
+    int64_t minerId;
+    uint64_t workerHash;    // FNV-1a 64 of the worker name
+    uint64_t diff;
+    uint64_t actualDiff;
+    uint32_t mapperId;
+    uint32_t latency;       // ms between submit to pool and result
+    uint8_t result;
+    uint8_t flags;
+    uint8_t reserved[14];
+
+    static inline uint64_t hash(const char *str)
+    {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        while (str && *str) {
+            h ^= static_cast<uint8_t>(*str++);
+            h *= 0x100000001b3ULL;
+        }
+
+        return h;
+    }
+};
+
+
+static_assert(sizeof(ShareJournalHeader) == 64, "Invalid share journal header size");
+static_assert(sizeof(ShareRecord) == 64, "Invalid share record size");
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SHARERECORD_H */
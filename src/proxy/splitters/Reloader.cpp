@@ -0,0 +1,150 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "proxy/splitters/Reloader.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "proxy/interfaces/IReloadListener.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+
+
+xmrig::Reloader::Reloader(IReloadListener *listener) :
+    m_listener(listener)
+{
+}
+
+
+void xmrig::Reloader::start(std::vector<uint64_t> &&ids, uint32_t batch, uint32_t delay)
+{
+    // Upstreams still waiting for the previous pools are reloaded again with the new ones.
+    m_queue.assign(m_pending.begin(), m_pending.end());
+    m_queue.insert(m_queue.end(), ids.begin(), ids.end());
+    m_pending.clear();
+
+    std::sort(m_queue.begin(), m_queue.end());
+    m_queue.erase(std::unique(m_queue.begin(), m_queue.end()), m_queue.end());
+
+    m_status        = {};
+    m_status.state  = ReloadStatus::RollingState;
+    m_status.total  = m_queue.size();
+    m_batch         = batch ? batch : m_queue.size();
+    m_delay         = static_cast<uint64_t>(delay) * 1000;
+
+    if (m_queue.size() > m_batch) {
+        LOG_INFO("%s " WHITE_BOLD("reload ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" upstreams, ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" at a time"), Tags::proxy(), m_status.total, m_batch);
+    }
+
+    next(Chrono::steadyMSecs());
+}
+
+
+void xmrig::Reloader::tick(uint64_t now)
+{
+    if (m_status.state != ReloadStatus::RollingState) {
+        return;
+    }
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        const auto status = m_listener->onReloadStatus(*it);
+        if (status == IReloadListener::ReloadPending) {
+            if (now - m_started < kTimeout) {
+                ++it;
+                continue;
+            }
+
+            m_listener->onReloadCancel(*it);
+            m_status.failed++;
+        }
+        else if (status == IReloadListener::ReloadDone) {
+            m_status.done++;
+        }
+        else {
+            m_status.total--;
+        }
+
+        it = m_pending.erase(it);
+    }
+
+    m_status.pending = m_pending.size();
+
+    if (!m_pending.empty()) {
+        return;
+    }
+
+    if (m_status.failed) {
+        LOG_ERR("%s " RED_BOLD("reload halted: ") RED("%" PRIu64 " upstreams failed to login, %zu left on previous pools"), Tags::proxy(), m_status.failed, m_queue.size());
+
+        m_status.state = ReloadStatus::HaltedState;
+        m_queue.clear();
+
+        return;
+    }
+
+    if (m_queue.empty()) {
+        if (m_status.total > m_batch) {
+            LOG_INFO("%s " WHITE_BOLD("reload done, ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" upstreams"), Tags::proxy(), m_status.done);
+        }
+
+        m_status.state = ReloadStatus::DoneState;
+
+        return;
+    }
+
+    if (!m_next) {
+        m_next = now + m_delay;
+    }
+
+    if (now >= m_next) {
+        next(now);
+    }
+}
+
+
+void xmrig::Reloader::next(uint64_t now)
+{
+    m_next    = 0;
+    m_started = now;
+
+    // Only upstreams with a new pool connection in flight count against the batch size.
+    while (m_pending.size() < m_batch && !m_queue.empty()) {
+        const uint64_t id = m_queue.front();
+        m_queue.pop_front();
+
+        const auto status = m_listener->onReload(id);
+        if (status == IReloadListener::ReloadPending) {
+            m_pending.push_back(id);
+        }
+        else if (status == IReloadListener::ReloadDone) {
+            m_status.done++;
+        }
+        else {
+            m_status.total--;
+        }
+    }
+
+    m_status.pending = m_pending.size();
+
+    if (m_pending.empty() && m_queue.empty()) {
+        m_status.state = ReloadStatus::DoneState;
+    }
+}
@@ -0,0 +1,75 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RELOADER_H
+#define XMRIG_RELOADER_H
+
+
+#include <deque>
+#include <vector>
+
+
+#include "base/tools/Object.h"
+#include "proxy/interfaces/ISplitter.h"
+
+
+namespace xmrig {
+
+
+class IReloadListener;
+
+
+/**
+ * Rolling reload of upstreams after a pools change.
+ *
+ * At most "reload-batch" upstreams switch to the new pools at the same time, the next batch starts
+ * "reload-delay" seconds after the previous one has logged in. If any upstream of a batch fails to login
+ * the rollout stops and the remaining upstreams stay on the previous pools.
+ */
+class Reloader
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Reloader)
+
+    constexpr static uint64_t kTimeout = 30 * 1000;
+
+    Reloader(IReloadListener *listener);
+
+    inline const ReloadStatus &status() const { return m_status; }
+
+    void start(std::vector<uint64_t> &&ids, uint32_t batch, uint32_t delay);
+    void tick(uint64_t now);
+
+private:
+    void next(uint64_t now);
+
+    IReloadListener *m_listener;
+    ReloadStatus m_status;
+    std::deque<uint64_t> m_queue;
+    std::vector<uint64_t> m_pending;
+    uint64_t m_batch    = 0;
+    uint64_t m_delay    = 0;
+    uint64_t m_next     = 0;
+    uint64_t m_started  = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RELOADER_H */
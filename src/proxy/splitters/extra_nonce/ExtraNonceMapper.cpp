@@ -230,7 +230,7 @@ void xmrig::ExtraNonceMapper::onResultAccepted(IStrategy *, IClient *client, con
 {
     const SubmitCtx ctx = submitCtx(result.seq);
 
-    AcceptEvent::start(0, ctx.miner, result, client->id() == -1, false, error);
+    AcceptEvent::start(0, ctx.miner, result, client->id() == -1, false, error, &client->pool());
 
     if (!ctx.miner) {
         return;
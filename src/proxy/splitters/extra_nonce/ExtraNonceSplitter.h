@@ -52,6 +52,8 @@ public:
 protected:
     ExtraNonceSplitter(Controller* controller);
 
+    inline ReloadStatus reloadStatus() const override { return {}; }
+
     Upstreams upstreams() const override;
     void connect() override;
     void gc() override;
@@ -23,7 +23,9 @@
  */
 
 #include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
 #include "proxy/Counters.h"
+#include "proxy/Metrics.h"
 #include "proxy/Miner.h"
 #include "proxy/splitters/extra_nonce/ExtraNonceStorage.h"
 
@@ -94,10 +96,18 @@ void xmrig::ExtraNonceStorage::setJob(const Job &job)
 
     m_extraNonce = 0;
 
+    if (m_miners.empty()) {
+        return;
+    }
+
+    const double start = Chrono::highResolutionMSecs();
+
     for (const auto& m : m_miners) {
         m.second->setJob(m_job, m_extraNonce);
         ++m_extraNonce;
     }
+
+    Metrics::addJob(m_job, start, Chrono::highResolutionMSecs(), m_miners.size());
 }
 
 
@@ -0,0 +1,65 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "proxy/splitters/nicehash/JobCache.h"
+
+
+#include <cstring>
+
+
+std::shared_ptr<const xmrig::JobTemplate> xmrig::JobCache::intern(Job &job)
+{
+    // Miner signatures use per connection keys, such jobs are never shared and can't be rendered in advance.
+    if (job.hasMinerSignature()) {
+        return nullptr;
+    }
+
+    for (const Entry &entry : m_entries) {
+        if (!job.share(entry.job)) {
+            continue;
+        }
+
+        if (isSameNotification(job, entry.job)) {
+            m_hits++;
+
+            return entry.tpl;
+        }
+    }
+
+    std::shared_ptr<const JobTemplate> tpl = std::make_shared<JobTemplate>(job);
+
+    if (m_entries.size() < kMaxEntries) {
+        m_entries.push_back({ job, tpl });
+    }
+    else {
+        m_entries[m_next] = { job, tpl };
+        m_next = (m_next + 1) % kMaxEntries;
+    }
+
+    return tpl;
+}
+
+
+bool xmrig::JobCache::isSameNotification(const Job &a, const Job &b)
+{
+    return a.id() == b.id() &&
+           a.algorithm() == b.algorithm() &&
+           a.height() == b.height() &&
+           strcmp(a.rawTarget(), b.rawTarget()) == 0;
+}
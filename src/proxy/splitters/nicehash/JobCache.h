@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_JOBCACHE_H
+#define XMRIG_JOBCACHE_H
+
+
+#include <memory>
+#include <vector>
+
+
+#include "base/net/stratum/Job.h"
+#include "base/tools/Object.h"
+#include "proxy/JobTemplate.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Recent upstream jobs of all nicehash mappers. Pools often hand out the same template to every login,
+ * a mapper that receives a job already seen by another mapper shares its payload and rendered notification.
+ */
+class JobCache
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(JobCache)
+
+    JobCache() = default;
+    ~JobCache() = default;
+
+    std::shared_ptr<const JobTemplate> intern(Job &job);
+
+    inline uint64_t hits() const { return m_hits; }
+
+private:
+    constexpr static size_t kMaxEntries = 16;
+
+    struct Entry
+    {
+        Job job;
+        std::shared_ptr<const JobTemplate> tpl;
+    };
+
+    static bool isSameNotification(const Job &a, const Job &b);
+
+    std::vector<Entry> m_entries;
+    uint64_t m_hits = 0;
+    size_t m_next   = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_JOBCACHE_H */
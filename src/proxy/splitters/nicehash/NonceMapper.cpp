@@ -22,11 +22,13 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
 
 
 #include "proxy/splitters/nicehash/NonceMapper.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/net/stratum/Client.h"
@@ -42,11 +44,17 @@
 #include "proxy/splitters/nicehash/NonceStorage.h"
 
 
-xmrig::NonceMapper::NonceMapper(size_t id, Controller *controller) :
+xmrig::NonceMapper::NonceMapper(size_t id, Controller *controller, JobCache *jobs) :
     m_controller(controller),
     m_id(id)
 {
-    m_storage  = new NonceStorage();
+    // Cascaded upstream grants at most the requested number of slots, don't accept more miners before the first job.
+    int slots = 0;
+    for (const Pool &pool : controller->config()->pools().data()) {
+        slots = std::max(slots, pool.cascade());
+    }
+
+    m_storage  = new NonceStorage(slots > 0 ? static_cast<size_t>(slots) : 256, jobs);
     m_strategy = controller->config()->pools().createStrategy(this);
 
     if (controller->config()->pools().donateLevel() > 0) {
@@ -69,6 +77,7 @@ bool xmrig::NonceMapper::add(Miner *miner)
     if (!miner->hasExtension(Miner::EXT_NICEHASH)) {
         miner->setExtension(Miner::EXT_ALGO,     m_controller->config()->hasAlgoExt());
         miner->setExtension(Miner::EXT_NICEHASH, true);
+        miner->setExtension(Miner::EXT_CASCADE,  miner->requestedSlots() > 0);
     }
 
     if (!m_storage->add(miner)) {
@@ -105,12 +114,29 @@ void xmrig::NonceMapper::gc()
 }
 
 
-void xmrig::NonceMapper::reload(const Pools &pools)
+bool xmrig::NonceMapper::reload(const Pools &pools)
 {
-    delete m_pending;
+    cancelReload();
+
+    // Suspended upstream has no pool connection, the new pools are used on the next connect.
+    if (isSuspended()) {
+        delete m_strategy;
+        m_strategy = pools.createStrategy(this);
+
+        return false;
+    }
 
     m_pending = pools.createStrategy(this);
     m_pending->connect();
+
+    return true;
+}
+
+
+void xmrig::NonceMapper::cancelReload()
+{
+    delete m_pending;
+    m_pending = nullptr;
 }
 
 
@@ -153,6 +179,10 @@ void xmrig::NonceMapper::tick(uint64_t, uint64_t now)
 {
     m_strategy->tick(now);
 
+    if (m_pending) {
+        m_pending->tick(now);
+    }
+
     if (m_donate) {
         m_donate->tick(now);
 
@@ -220,9 +250,11 @@ void xmrig::NonceMapper::onJob(IStrategy *, IClient *client, const Job &job, con
 }
 
 
-void xmrig::NonceMapper::onLogin(IStrategy *strategy, IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+void xmrig::NonceMapper::onLogin(IStrategy *, IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
 {
-
+    if (client->pool().cascade() > 0) {
+        params.AddMember("cascade", client->pool().cascade(), doc.GetAllocator());
+    }
 }
 
 
@@ -240,7 +272,7 @@ void xmrig::NonceMapper::onResultAccepted(IStrategy *, IClient *client, const Su
 {
     const SubmitCtx ctx = submitCtx(result.seq);
 
-    AcceptEvent::start(m_id, ctx.miner, result, client->id() == -1, false, error);
+    AcceptEvent::start(m_id, ctx.miner, result, client->id() == -1, false, error, &client->pool());
 
     if (!ctx.miner) {
         return;
@@ -42,6 +42,7 @@ namespace xmrig {
 class Controller;
 class DonateStrategy;
 class IStrategy;
+class JobCache;
 class JobResult;
 class Miner;
 class NonceStorage;
@@ -66,18 +67,20 @@ class NonceMapper : public IStrategyListener
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(NonceMapper)
 
-    NonceMapper(size_t id, Controller *controller);
+    NonceMapper(size_t id, Controller *controller, JobCache *jobs = nullptr);
     ~NonceMapper() override;
 
     bool add(Miner *miner);
     bool isActive() const;
     void gc();
-    void reload(const Pools &pools);
+    bool reload(const Pools &pools);
+    void cancelReload();
     void remove(const Miner *miner);
     void start();
     void submit(SubmitEvent *event);
     void tick(uint64_t ticks, uint64_t now);
 
+    inline bool isReloading() const { return m_pending != nullptr; }
     inline bool isSuspended() const { return m_suspended > 0; }
     inline int suspended() const    { return m_suspended; }
 
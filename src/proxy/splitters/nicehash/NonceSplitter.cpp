@@ -41,7 +41,8 @@
 #define LABEL(x) " \x1B[01;30m" x ":\x1B[0m "
 
 
-xmrig::NonceSplitter::NonceSplitter(Controller *controller) : Splitter(controller)
+xmrig::NonceSplitter::NonceSplitter(Controller *controller) : Splitter(controller),
+    m_reloader(this)
 {
 }
 
@@ -77,7 +78,7 @@ xmrig::Upstreams xmrig::NonceSplitter::upstreams() const
 
 void xmrig::NonceSplitter::connect()
 {
-    auto *upstream = new NonceMapper(m_upstreams.size(), m_controller);
+    auto *upstream = new NonceMapper(m_upstreams.size(), m_controller, &m_jobs);
     m_upstreams.push_back(upstream);
 
     upstream->start();
@@ -118,6 +119,8 @@ void xmrig::NonceSplitter::tick(uint64_t ticks)
     for (NonceMapper *mapper : m_upstreams) {
         mapper->tick(ticks, now);
     }
+
+    m_reloader.tick(now);
 }
 
 
@@ -136,9 +139,12 @@ void xmrig::NonceSplitter::onConfigChanged(Config *config, Config *previousConfi
     if (config->pools() != previousConfig->pools()) {
         config->pools().print();
 
-        for (NonceMapper *mapper : m_upstreams) {
-            mapper->reload(config->pools());
+        std::vector<uint64_t> ids(m_upstreams.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            ids[i] = i;
         }
+
+        m_reloader.start(std::move(ids), config->reloadBatch(), config->reloadDelay());
     }
 }
 
@@ -165,6 +171,43 @@ void xmrig::NonceSplitter::onEvent(IEvent *event)
 }
 
 
+xmrig::IReloadListener::Status xmrig::NonceSplitter::onReload(uint64_t id)
+{
+    NonceMapper *mapper = upstream(id);
+    if (!mapper) {
+        return ReloadGone;
+    }
+
+    return mapper->reload(m_controller->config()->pools()) ? ReloadPending : ReloadDone;
+}
+
+
+xmrig::IReloadListener::Status xmrig::NonceSplitter::onReloadStatus(uint64_t id) const
+{
+    const NonceMapper *mapper = upstream(id);
+    if (!mapper) {
+        return ReloadGone;
+    }
+
+    return mapper->isReloading() ? ReloadPending : ReloadDone;
+}
+
+
+void xmrig::NonceSplitter::onReloadCancel(uint64_t id)
+{
+    NonceMapper *mapper = upstream(id);
+    if (mapper) {
+        mapper->cancelReload();
+    }
+}
+
+
+xmrig::NonceMapper *xmrig::NonceSplitter::upstream(uint64_t id) const
+{
+    return id < m_upstreams.size() ? m_upstreams[id] : nullptr;
+}
+
+
 void xmrig::NonceSplitter::login(LoginEvent *event)
 {
     if (event->miner()->routeId() != -1) {
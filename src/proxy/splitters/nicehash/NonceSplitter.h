@@ -31,6 +31,9 @@
 
 
 #include "base/tools/Object.h"
+#include "proxy/splitters/nicehash/JobCache.h"
+#include "proxy/interfaces/IReloadListener.h"
+#include "proxy/splitters/Reloader.h"
 #include "proxy/splitters/Splitter.h"
 
 
@@ -45,7 +48,7 @@ class Stats;
 class SubmitEvent;
 
 
-class NonceSplitter : public Splitter
+class NonceSplitter : public Splitter, public IReloadListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(NonceSplitter)
@@ -54,6 +57,8 @@ public:
     ~NonceSplitter() override;
 
 protected:
+    inline ReloadStatus reloadStatus() const override { return m_reloader.status(); }
+
     Upstreams upstreams() const override;
     void connect() override;
     void gc() override;
@@ -68,11 +73,18 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
     void onEvent(IEvent *event) override;
 
+    Status onReload(uint64_t id) override;
+    Status onReloadStatus(uint64_t id) const override;
+    void onReloadCancel(uint64_t id) override;
+
 private:
+    NonceMapper *upstream(uint64_t id) const;
     void login(LoginEvent *event);
     void remove(Miner *miner);
     void submit(SubmitEvent *event);
 
+    JobCache m_jobs;
+    Reloader m_reloader;
     std::vector<NonceMapper*> m_upstreams;
 };
 
@@ -23,18 +23,27 @@
  */
 
 #include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
 #include "proxy/Counters.h"
+#include "proxy/Metrics.h"
+#include "proxy/JobTemplate.h"
 #include "proxy/Miner.h"
+#include "proxy/splitters/nicehash/JobCache.h"
 #include "proxy/splitters/nicehash/NonceStorage.h"
 
 
+#include <algorithm>
 #include <cinttypes>
 
 
-xmrig::NonceStorage::NonceStorage() :
+xmrig::NonceStorage::NonceStorage(size_t slots, JobCache *jobs) :
     m_active(false),
+    m_jobs(jobs),
+    m_count(slots),
     m_used(256, 0),
-    m_index(rand() % 256)
+    m_first(0),
+    m_index(rand() % slots)
 {
 }
 
@@ -44,19 +53,14 @@ xmrig::NonceStorage::~NonceStorage() = default;
 
 bool xmrig::NonceStorage::add(Miner *miner)
 {
-    const int index = nextIndex(0);
-    if (index == -1) {
+    if (!allocate(miner)) {
         return false;
     }
 
-    miner->setFixedByte(index);
-
-    m_index = index;
-    m_used[index] = miner->id();
     m_miners[miner->id()] = miner;
 
     if (isActive()) {
-        miner->setJob(m_job);
+        miner->setJob(m_job, m_template.get());
     }
 
     return true;
@@ -65,13 +69,7 @@ bool xmrig::NonceStorage::add(Miner *miner)
 
 bool xmrig::NonceStorage::isUsed() const
 {
-    for (size_t i = 0; i < 256; ++i) {
-     if (m_used[i] > 0) {
-         return true;
-     }
-    }
-
-    return false;
+    return std::any_of(m_used.begin(), m_used.end(), [](int64_t id) { return id > 0; });
 }
 
 
@@ -102,7 +100,7 @@ xmrig::Miner *xmrig::NonceStorage::miner(int64_t id)
 
 void xmrig::NonceStorage::remove(const Miner *miner)
 {
-    m_used[miner->fixedByte()] = -miner->id();
+    std::replace(m_used.begin(), m_used.end(), miner->id(), -miner->id());
 
     auto it = m_miners.find(miner->id());
     if (it != m_miners.end()) {
@@ -132,19 +130,27 @@ void xmrig::NonceStorage::setJob(const Job &job)
         m_prevJob.reset();
     }
 
-    m_job = job;
+    m_job      = job;
+    m_template = m_jobs ? m_jobs->intern(m_job) : nullptr;
 
-    for (size_t i = 0; i < 256; ++i) {
-        const int64_t index = m_used[i];
-        if (index == 0) {
-            continue;
-        }
+    if (job.slots() > 0) {
+        setRange(job.fixedByte(), job.slots());
+    }
+    else {
+        setRange(0, 256);
+    }
 
-        Miner *miner = this->miner(index);
-        if (miner) {
-            miner->setJob(m_job);
-        }
+    if (m_miners.empty()) {
+        return;
     }
+
+    const double start = Chrono::highResolutionMSecs();
+
+    for (const auto &kv : m_miners) {
+        kv.second->setJob(m_job, m_template.get());
+    }
+
+    Metrics::addJob(m_job, start, Chrono::highResolutionMSecs(), m_miners.size());
 }
 
 
@@ -153,7 +159,8 @@ void xmrig::NonceStorage::printState(size_t id)
 {    int available = 0;
      int dead      = 0;
 
-     for (const int64_t v : m_used) {
+     for (size_t i = 0; i < m_count; ++i) {
+         const int64_t v = m_used[i];
          if (v == 0) {
              available++;
          }
@@ -162,28 +169,95 @@ void xmrig::NonceStorage::printState(size_t id)
          }
      }
 
-     int miners = 256 - available - dead;
+     int miners = static_cast<int>(m_count) - available - dead;
 
      LOG_INFO("#%03u - \x1B[32m%03d \x1B[33m%03d \x1B[35m%03d\x1B[0m - 0x%02hhX, % 5.1f%%",
-              id, available, dead, miners, m_index, (double) miners / 256 * 100.0);
+              id, available, dead, miners, m_index, (double) miners / m_count * 100.0);
 
 }
 #endif
 
 
-int xmrig::NonceStorage::nextIndex(int start) const
+bool xmrig::NonceStorage::allocate(Miner *miner)
 {
-    for (size_t i = m_index; i < m_used.size(); ++i) {
-        if (m_used[i] == 0) {
-            return (int) i;
-        }
+    // Cascaded proxy takes a block of consecutive slots, the block is trimmed to what is still free in this mapper,
+    // the request is kept so the block can grow back after the miners are packed again.
+    const size_t width = std::max<size_t>(1, std::min<size_t>(miner->requestedSlots(), freeBlock()));
+    const int index    = nextIndex(width);
+    if (index == -1) {
+        return false;
     }
 
-    for (size_t i = start; i < m_index; ++i) {
-        if (m_used[i] == 0) {
+    miner->setRange(static_cast<uint8_t>(m_first + index), miner->hasExtension(Miner::EXT_CASCADE) ? static_cast<uint16_t>(width) : miner->requestedSlots());
+
+    m_index = static_cast<uint8_t>(index);
+    std::fill_n(m_used.begin() + index, width, miner->id());
+
+    return true;
+}
+
+
+int xmrig::NonceStorage::nextIndex(size_t width) const
+{
+    for (size_t n = 0; n < m_count; ++n) {
+        const size_t i = (m_index + n) % m_count;
+        if (i + width > m_count) {
+            continue;
+        }
+
+        if (std::all_of(m_used.begin() + i, m_used.begin() + i + width, [](int64_t id) { return id == 0; })) {
             return (int) i;
         }
     }
 
     return -1;
 }
+
+
+size_t xmrig::NonceStorage::freeBlock() const
+{
+    size_t best = 0;
+    size_t run  = 0;
+
+    for (size_t i = 0; i < m_count; ++i) {
+        run  = m_used[i] == 0 ? run + 1 : 0;
+        best = std::max(best, run);
+    }
+
+    return best;
+}
+
+
+void xmrig::NonceStorage::setRange(uint8_t first, size_t count)
+{
+    if (first == m_first && count == m_count) {
+        return;
+    }
+
+    m_first = first;
+    m_count = count;
+    m_index = 0;
+
+    std::fill(m_used.begin(), m_used.end(), 0);
+
+    // Upstream granted a different block of slots, miners are packed again and those that no longer fit are disconnected.
+    std::vector<Miner *> evicted;
+
+    for (auto it = m_miners.begin(); it != m_miners.end();) {
+        if (allocate(it->second)) {
+            ++it;
+            continue;
+        }
+
+        evicted.push_back(it->second);
+        it = m_miners.erase(it);
+    }
+
+    if (!evicted.empty()) {
+        LOG_WARN("%s " YELLOW("nonce space reduced to %zu slots, %zu miners disconnected"), Tags::network(), count, evicted.size());
+    }
+
+    for (Miner *miner : evicted) {
+        miner->close();
+    }
+}
@@ -27,6 +27,7 @@
 
 
 #include <map>
+#include <memory>
 #include <vector>
 
 
@@ -37,6 +38,8 @@
 namespace xmrig {
 
 
+class JobCache;
+class JobTemplate;
 class Miner;
 
 
@@ -45,7 +48,7 @@ class NonceStorage
 public:
     XMRIG_DISABLE_COPY_MOVE(NonceStorage)
 
-    NonceStorage();
+    NonceStorage(size_t slots = 256, JobCache *jobs = nullptr);
     ~NonceStorage();
 
     bool add(Miner *miner);
@@ -65,13 +68,20 @@ public:
 #   endif
 
 private:
-    int nextIndex(int start) const;
+    bool allocate(Miner *miner);
+    int nextIndex(size_t width) const;
+    size_t freeBlock() const;
+    void setRange(uint8_t first, size_t count);
 
     bool m_active;
+    JobCache *m_jobs;
+    size_t m_count;
     Job m_job;
     Job m_prevJob;
+    std::shared_ptr<const JobTemplate> m_template;
     std::map<int64_t, Miner*> m_miners;
     std::vector<int64_t> m_used;
+    uint8_t m_first;
     uint8_t m_index;
 };
 
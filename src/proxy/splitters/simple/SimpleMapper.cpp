@@ -69,12 +69,21 @@ void xmrig::SimpleMapper::add(Miner *miner)
 }
 
 
-void xmrig::SimpleMapper::reload(const Pools &pools)
+bool xmrig::SimpleMapper::reload(const Pools &pools)
 {
-    delete m_pending;
+    cancelReload();
 
     m_pending = pools.createStrategy(this);
     m_pending->connect();
+
+    return true;
+}
+
+
+void xmrig::SimpleMapper::cancelReload()
+{
+    delete m_pending;
+    m_pending = nullptr;
 }
 
 
@@ -136,6 +145,10 @@ void xmrig::SimpleMapper::tick(uint64_t, uint64_t now)
 {
     m_strategy->tick(now);
 
+    if (m_pending) {
+        m_pending->tick(now);
+    }
+
     if (!m_miner) {
         m_idleTime++;
     }
@@ -206,7 +219,7 @@ void xmrig::SimpleMapper::onPause(IStrategy *strategy)
 
 void xmrig::SimpleMapper::onResultAccepted(IStrategy *, IClient *client, const SubmitResult &result, const char *error)
 {
-    AcceptEvent::start(m_id, m_miner, result, client->id() == -1, false, error);
+    AcceptEvent::start(m_id, m_miner, result, client->id() == -1, false, error, &client->pool());
 
     if (!m_miner) {
         return;
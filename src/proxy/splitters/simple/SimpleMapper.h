@@ -58,7 +58,8 @@ public:
     ~SimpleMapper() override;
 
     void add(Miner *miner);
-    void reload(const Pools &pools);
+    bool reload(const Pools &pools);
+    void cancelReload();
     void remove(const Miner *miner);
     void reuse(Miner *miner);
     void stop();
@@ -66,6 +67,7 @@ public:
     void tick(uint64_t ticks, uint64_t now);
 
     inline bool isActive() const     { return m_active && m_miner; }
+    inline bool isReloading() const  { return m_pending != nullptr; }
     inline bool isReusable() const   { return m_active && !m_miner && !m_dirty; }
     inline uint64_t id() const       { return m_id; }
     inline uint64_t idleTime() const { return m_idleTime; }
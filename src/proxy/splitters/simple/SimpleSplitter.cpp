@@ -42,6 +42,7 @@
 
 
 xmrig::SimpleSplitter::SimpleSplitter(xmrig::Controller *controller) : Splitter(controller),
+    m_reloader(this),
     m_reuseTimeout(static_cast<uint64_t>(controller->config()->reuseTimeout()))
 {
 }
@@ -113,6 +114,8 @@ void xmrig::SimpleSplitter::tick(uint64_t ticks)
         kv.second->tick(ticks, now);
     }
 
+    m_reloader.tick(now);
+
     if (m_released.empty()) {
         return;
     }
@@ -137,9 +140,14 @@ void xmrig::SimpleSplitter::onConfigChanged(Config *config, Config *previousConf
     if (config->pools() != previousConfig->pools()) {
         config->pools().print();
 
+        std::vector<uint64_t> ids;
+        ids.reserve(m_upstreams.size());
+
         for (auto const &kv : m_upstreams) {
-            kv.second->reload(config->pools());
+            ids.push_back(kv.first);
         }
+
+        m_reloader.start(std::move(ids), config->reloadBatch(), config->reloadDelay());
     }
 }
 
@@ -166,6 +174,45 @@ void xmrig::SimpleSplitter::onEvent(IEvent *event)
 }
 
 
+xmrig::IReloadListener::Status xmrig::SimpleSplitter::onReload(uint64_t id)
+{
+    SimpleMapper *mapper = upstream(id);
+    if (!mapper) {
+        return ReloadGone;
+    }
+
+    return mapper->reload(m_controller->config()->pools()) ? ReloadPending : ReloadDone;
+}
+
+
+xmrig::IReloadListener::Status xmrig::SimpleSplitter::onReloadStatus(uint64_t id) const
+{
+    const SimpleMapper *mapper = upstream(id);
+    if (!mapper) {
+        return ReloadGone;
+    }
+
+    return mapper->isReloading() ? ReloadPending : ReloadDone;
+}
+
+
+void xmrig::SimpleSplitter::onReloadCancel(uint64_t id)
+{
+    SimpleMapper *mapper = upstream(id);
+    if (mapper) {
+        mapper->cancelReload();
+    }
+}
+
+
+xmrig::SimpleMapper *xmrig::SimpleSplitter::upstream(uint64_t id) const
+{
+    const auto it = m_upstreams.find(id);
+
+    return it != m_upstreams.end() ? it->second : nullptr;
+}
+
+
 void xmrig::SimpleSplitter::login(LoginEvent *event)
 {
     if (event->miner()->routeId() != -1) {
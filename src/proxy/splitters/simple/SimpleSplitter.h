@@ -30,6 +30,8 @@
 #include <vector>
 
 
+#include "proxy/interfaces/IReloadListener.h"
+#include "proxy/splitters/Reloader.h"
 #include "proxy/splitters/Splitter.h"
 
 
@@ -43,13 +45,15 @@ class Stats;
 class SubmitEvent;
 
 
-class SimpleSplitter : public Splitter
+class SimpleSplitter : public Splitter, public IReloadListener
 {
 public:
     SimpleSplitter(Controller *controller);
     ~SimpleSplitter() override;
 
 protected:
+    inline ReloadStatus reloadStatus() const override { return m_reloader.status(); }
+
     Upstreams upstreams() const override;
     void connect() override;
     void gc() override;
@@ -64,7 +68,12 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
     void onEvent(IEvent *event) override;
 
+    Status onReload(uint64_t id) override;
+    Status onReloadStatus(uint64_t id) const override;
+    void onReloadCancel(uint64_t id) override;
+
 private:
+    SimpleMapper *upstream(uint64_t id) const;
     void login(LoginEvent *event);
     void remove(Miner *miner);
     void removeIdle(uint64_t id);
@@ -72,6 +81,7 @@ private:
     void stop(SimpleMapper *mapper);
     void submit(SubmitEvent *event);
 
+    Reloader m_reloader;
     std::map<uint64_t, SimpleMapper *> m_idles;
     std::map<uint64_t, SimpleMapper *> m_upstreams;
     std::vector<SimpleMapper *> m_released;
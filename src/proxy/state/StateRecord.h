@@ -0,0 +1,90 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_STATERECORD_H
+#define XMRIG_STATERECORD_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * On-disk layout of the state snapshot, all fields are little endian.
+ *
+ * The header is followed by the proxy hashrate samples (uint32_t[statsHistory]) and, at the given offsets,
+ * the worker records, the workers hashrate samples and the worker names and IPs (not null terminated).
+ * Hashrate samples are stored without leading zero samples and cover at most 24 hours.
+ */
+struct StateHeader
+{
+    constexpr static const char *kMagic = "XMRIGST1";
+    constexpr static uint32_t kVersion  = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t size;              // size of the whole file
+    uint64_t created;           // ms since epoch
+    uint64_t accepted;
+    uint64_t donateHashes;
+    uint64_t expired;
+    uint64_t hashes;
+    uint64_t invalid;
+    uint64_t maxMiners;
+    uint64_t rejected;
+    uint64_t topDiff[10];
+    uint64_t workersOffset;
+    uint64_t historyOffset;
+    uint64_t stringsOffset;
+    uint32_t tickTime;          // seconds per hashrate sample
+    uint32_t statsHistory;
+    uint32_t workersMode;
+    uint32_t workersCount;
+    uint8_t reserved[48];
+};
+
+
+struct StateWorker
+{
+    uint64_t accepted;
+    uint64_t hashes;
+    uint64_t invalid;
+    uint64_t rejected;
+    uint64_t lastHash;          // ms since epoch
+    uint64_t history;           // index of the first sample in the workers hashrate samples
+    uint64_t name;              // offset in the strings, the IP follows the name
+    uint32_t historySize;
+    uint16_t nameSize;
+    uint8_t ipSize;
+    uint8_t reserved;
+};
+
+
+static_assert(sizeof(StateHeader) == 256, "Invalid state header size");
+static_assert(sizeof(StateWorker) == 64, "Invalid state worker record size");
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_STATERECORD_H */
@@ -0,0 +1,477 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "proxy/state/StateSnapshot.h"
+#include "base/io/Env.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "proxy/Counters.h"
+#include "proxy/state/StateRecord.h"
+#include "proxy/Stats.h"
+#include "proxy/workers/Workers.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+
+namespace xmrig {
+
+
+static constexpr size_t kHistoryWindow = 24 * 3600;
+
+
+static inline size_t align8(size_t size)
+{
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+
+// Samples which still matter for the 24 hour window, leading zero samples don't change any average.
+static inline std::pair<const uint32_t *, size_t> historyTail(const std::vector<uint32_t> &data, size_t tickTime)
+{
+    const size_t max = kHistoryWindow / tickTime;
+    size_t first     = data.size() > max ? data.size() - max : 0;
+
+    while (first < data.size() && data[first] == 0) {
+        ++first;
+    }
+
+    return { data.data() + first, data.size() - first };
+}
+
+
+class MappedFile
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(MappedFile)
+
+    inline MappedFile(const std::string &path)
+    {
+#       ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            return;
+        }
+
+        m_size    = static_cast<size_t>(size.QuadPart);
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (m_mapping) {
+            m_data = static_cast<const uint8_t *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+#       else
+        m_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            return;
+        }
+
+        struct stat st{};
+        if (fstat(m_fd, &st) != 0 || st.st_size <= 0) {
+            return;
+        }
+
+        m_size = static_cast<size_t>(st.st_size);
+
+        void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (data != MAP_FAILED) {
+            m_data = static_cast<const uint8_t *>(data);
+        }
+#       endif
+    }
+
+
+    inline ~MappedFile()
+    {
+#       ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+#       else
+        if (m_data) {
+            munmap(const_cast<uint8_t *>(m_data), m_size);
+        }
+
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#       endif
+    }
+
+
+    inline const uint8_t *data() const  { return m_data; }
+    inline size_t size() const          { return m_size; }
+
+private:
+    const uint8_t *m_data   = nullptr;
+    size_t m_size           = 0;
+
+#   ifdef _WIN32
+    HANDLE m_file           = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping        = nullptr;
+#   else
+    int m_fd                = -1;
+#   endif
+};
+
+
+} // namespace xmrig
+
+
+xmrig::StateSnapshot::StateSnapshot(Controller *controller)
+{
+    const Config *config = controller->config();
+    if (config->stateFile().isNull()) {
+        return;
+    }
+
+    m_path = Env::expand(config->stateFile()).data();
+
+#   ifdef _WIN32
+    m_temp = m_path + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+#   else
+    m_temp = m_path + "." + std::to_string(getpid()) + ".tmp";
+#   endif
+
+    m_thread = std::thread(&StateSnapshot::run, this);
+}
+
+
+xmrig::StateSnapshot::~StateSnapshot()
+{
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_cv.notify_one();
+        m_thread.join();
+    }
+}
+
+
+void xmrig::StateSnapshot::load(Stats *stats, Workers *workers) const
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    const uint64_t start = Chrono::steadyMSecs();
+    const MappedFile file(m_path);
+    if (!file.data()) {
+        return;
+    }
+
+    const uint8_t *data = file.data();
+    const size_t size   = file.size();
+    const auto header   = reinterpret_cast<const StateHeader *>(data);
+
+    // Offsets are checked against the file size first, so the size checks below can't overflow.
+    const bool valid = size >= sizeof(StateHeader) &&
+                       memcmp(header->magic, StateHeader::kMagic, sizeof(header->magic)) == 0 &&
+                       header->version == StateHeader::kVersion &&
+                       header->headerSize == sizeof(StateHeader) &&
+                       header->size == size &&
+                       header->tickTime > 0 &&
+                       header->stringsOffset <= size &&
+                       header->historyOffset <= header->stringsOffset &&
+                       header->workersOffset <= header->historyOffset &&
+                       header->workersOffset >= sizeof(StateHeader) &&
+                       header->workersOffset % 8 == 0 &&
+                       header->historyOffset % 8 == 0 &&
+                       header->statsHistory <= (header->workersOffset - sizeof(StateHeader)) / sizeof(uint32_t) &&
+                       header->workersCount <= (header->historyOffset - header->workersOffset) / sizeof(StateWorker);
+
+    if (!valid) {
+        LOG_WARN("%s " YELLOW("state snapshot \"%s\" is invalid or has unsupported version, ignored"), Tags::proxy(), m_path.c_str());
+
+        return;
+    }
+
+    // Samples older than the 24 hour window don't change any average, after a longer gap only the totals are restored.
+    const uint64_t now   = Chrono::currentMSecsSinceEpoch();
+    const uint64_t ticks = now > header->created ? (now - header->created) / 1000 / header->tickTime : 0;
+    const bool history   = header->tickTime == stats->tickTime() && ticks < kHistoryWindow / header->tickTime;
+    const size_t gap     = history ? static_cast<size_t>(ticks) : 0;
+
+    stats->restore(*header, history ? reinterpret_cast<const uint32_t *>(data + sizeof(StateHeader)) : nullptr, gap);
+
+    size_t count = 0;
+
+    if (header->workersMode == static_cast<uint32_t>(workers->mode()) && workers->mode() != Workers::None) {
+        const auto records  = reinterpret_cast<const StateWorker *>(data + header->workersOffset);
+        const auto samples  = reinterpret_cast<const uint32_t *>(data + header->historyOffset);
+        const size_t total  = (header->stringsOffset - header->historyOffset) / sizeof(uint32_t);
+        const size_t strings = size - header->stringsOffset;
+        const char *text    = reinterpret_cast<const char *>(data + header->stringsOffset);
+
+        std::vector<Worker> list;
+        list.reserve(header->workersCount);
+
+        for (size_t i = 0; i < header->workersCount; ++i) {
+            const StateWorker &record = records[i];
+
+            if (record.history > total || record.historySize > total - record.history || record.name > strings || record.nameSize + record.ipSize > strings - record.name) {
+                LOG_WARN("%s " YELLOW("state snapshot \"%s\" has invalid worker records, workers ignored"), Tags::proxy(), m_path.c_str());
+                list.clear();
+                break;
+            }
+
+            list.emplace_back(list.size(),
+                              std::string(text + record.name, record.nameSize),
+                              std::string(text + record.name + record.nameSize, record.ipSize),
+                              record,
+                              history ? samples + record.history : nullptr,
+                              gap);
+        }
+
+        count = list.size();
+        workers->restore(std::move(list));
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("state") " restored from " CYAN("\"%s\"") ", " CYAN_BOLD("%zu") " workers " BLACK_BOLD("(%" PRIu64 " ms)"),
+             Tags::proxy(), m_path.c_str(), count, Chrono::steadyMSecs() - start);
+}
+
+
+void xmrig::StateSnapshot::save(const Stats &stats, const Workers &workers, bool sync)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::vector<uint8_t> data = serialize(stats, workers);
+
+    if (sync) {
+        write(data);
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.swap(data);
+    }
+
+    m_cv.notify_one();
+}
+
+
+std::vector<uint8_t> xmrig::StateSnapshot::serialize(const Stats &stats, const Workers &workers)
+{
+    static const std::vector<Worker> empty;
+
+    const size_t tickTime           = stats.tickTime();
+    const std::vector<Worker> &list = workers.mode() == Workers::None ? empty : workers.workers();
+    const auto statsHistory         = historyTail(stats.history(), tickTime);
+
+    size_t samples = 0;
+    size_t strings = 0;
+
+    for (const Worker &worker : list) {
+        samples += historyTail(worker.history(), tickTime).second;
+        strings += std::min<size_t>(strlen(worker.name()), UINT16_MAX) + std::min<size_t>(strlen(worker.ip()), UINT8_MAX);
+    }
+
+    const size_t workersOffset = align8(sizeof(StateHeader) + statsHistory.second * sizeof(uint32_t));
+    const size_t historyOffset = workersOffset + list.size() * sizeof(StateWorker);
+    const size_t stringsOffset = align8(historyOffset + samples * sizeof(uint32_t));
+
+    std::vector<uint8_t> data(stringsOffset + strings);
+
+    const StatsData &stat = stats.data();
+    auto header           = reinterpret_cast<StateHeader *>(data.data());
+
+    memcpy(header->magic, StateHeader::kMagic, sizeof(header->magic));
+    header->version       = StateHeader::kVersion;
+    header->headerSize    = sizeof(StateHeader);
+    header->size          = data.size();
+    header->created       = Chrono::currentMSecsSinceEpoch();
+    header->accepted      = stat.accepted;
+    header->donateHashes  = stat.donateHashes;
+    header->expired       = Counters::expired;
+    header->hashes        = stat.hashes;
+    header->invalid       = stat.invalid;
+    header->maxMiners     = Counters::maxMiners();
+    header->rejected      = stat.rejected;
+    header->workersOffset = workersOffset;
+    header->historyOffset = historyOffset;
+    header->stringsOffset = stringsOffset;
+    header->tickTime      = static_cast<uint32_t>(tickTime);
+    header->statsHistory  = static_cast<uint32_t>(statsHistory.second);
+    header->workersMode   = static_cast<uint32_t>(workers.mode());
+    header->workersCount  = static_cast<uint32_t>(list.size());
+
+    std::copy(stat.topDiff.begin(), stat.topDiff.end(), header->topDiff);
+    memcpy(data.data() + sizeof(StateHeader), statsHistory.first, statsHistory.second * sizeof(uint32_t));
+
+    auto records = reinterpret_cast<StateWorker *>(data.data() + workersOffset);
+    auto history = reinterpret_cast<uint32_t *>(data.data() + historyOffset);
+    char *text   = reinterpret_cast<char *>(data.data() + stringsOffset);
+
+    samples = 0;
+    strings = 0;
+
+    for (size_t i = 0; i < list.size(); ++i) {
+        const Worker &worker  = list[i];
+        StateWorker &record   = records[i];
+        const auto tail       = historyTail(worker.history(), tickTime);
+
+        record.accepted    = worker.accepted();
+        record.hashes      = worker.hashes();
+        record.invalid     = worker.invalid();
+        record.rejected    = worker.rejected();
+        record.lastHash    = worker.lastHash();
+        record.history     = samples;
+        record.historySize = static_cast<uint32_t>(tail.second);
+        record.name        = strings;
+        record.nameSize    = static_cast<uint16_t>(std::min<size_t>(strlen(worker.name()), UINT16_MAX));
+        record.ipSize      = static_cast<uint8_t>(std::min<size_t>(strlen(worker.ip()), UINT8_MAX));
+
+        memcpy(history + samples, tail.first, tail.second * sizeof(uint32_t));
+        memcpy(text + strings, worker.name(), record.nameSize);
+        memcpy(text + strings + record.nameSize, worker.ip(), record.ipSize);
+
+        samples += tail.second;
+        strings += record.nameSize + record.ipSize;
+    }
+
+    return data;
+}
+
+
+bool xmrig::StateSnapshot::write(const std::vector<uint8_t> &data)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+#   ifdef _WIN32
+    HANDLE file = CreateFileA(m_temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    bool ok     = file != INVALID_HANDLE_VALUE;
+
+    for (size_t written = 0; ok && written < data.size();) {
+        DWORD chunk = 0;
+        ok = WriteFile(file, data.data() + written, static_cast<DWORD>(std::min<size_t>(data.size() - written, 1U << 30)), &chunk, nullptr) && chunk > 0;
+        written += chunk;
+    }
+
+    ok = ok && FlushFileBuffers(file);
+
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+
+    ok = ok && MoveFileExA(m_temp.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+
+    if (!ok) {
+        LOG_ERR("%s " RED("failed to write state snapshot \"%s\", error %lu"), Tags::proxy(), m_path.c_str(), GetLastError());
+        DeleteFileA(m_temp.c_str());
+    }
+#   else
+    const int fd = open(m_temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    bool ok      = fd >= 0;
+
+    for (size_t written = 0; ok && written < data.size();) {
+        const ssize_t rc = ::write(fd, data.data() + written, data.size() - written);
+        if (rc < 0 && errno == EINTR) {
+            continue;
+        }
+
+        ok       = rc > 0;
+        written += ok ? static_cast<size_t>(rc) : 0;
+    }
+
+    ok = ok && fsync(fd) == 0;
+
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    ok = ok && rename(m_temp.c_str(), m_path.c_str()) == 0;
+
+    if (!ok) {
+        LOG_ERR("%s " RED("failed to write state snapshot \"%s\": %s"), Tags::proxy(), m_path.c_str(), strerror(errno));
+        unlink(m_temp.c_str());
+
+        return false;
+    }
+
+    // Make the rename itself durable.
+    const size_t slash    = m_path.rfind('/');
+    const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : m_path.substr(0, slash));
+    const int dirfd       = open(dir.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (dirfd >= 0) {
+        fsync(dirfd);
+        close(dirfd);
+    }
+#   endif
+
+    return ok;
+}
+
+
+void xmrig::StateSnapshot::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+
+        if (m_stop) {
+            break;
+        }
+
+        std::vector<uint8_t> data;
+        data.swap(m_pending);
+
+        lock.unlock();
+        write(data);
+        lock.lock();
+    }
+}
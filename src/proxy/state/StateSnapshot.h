@@ -0,0 +1,82 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_STATESNAPSHOT_H
+#define XMRIG_STATESNAPSHOT_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Controller;
+class Stats;
+class Workers;
+
+
+/**
+ * Periodic snapshot of the proxy statistics and per worker state for warm restarts.
+ *
+ * The snapshot is serialized on the event loop and written by a background thread to a temporary file,
+ * which is synced and renamed over the previous one, so a crash never leaves a partial snapshot behind.
+ * At startup the file is memory-mapped and records are restored in place without parsing.
+ */
+class StateSnapshot
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(StateSnapshot)
+
+    StateSnapshot(Controller *controller);
+    ~StateSnapshot();
+
+    inline bool isEnabled() const { return !m_path.empty(); }
+
+    void load(Stats *stats, Workers *workers) const;
+    void save(const Stats &stats, const Workers &workers, bool sync = false);
+
+private:
+    static std::vector<uint8_t> serialize(const Stats &stats, const Workers &workers);
+
+    bool write(const std::vector<uint8_t> &data);
+    void run();
+
+    bool m_stop = false;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+    std::mutex m_writeMutex;
+    std::string m_path;
+    std::string m_temp;
+    std::thread m_thread;
+    std::vector<uint8_t> m_pending;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_STATESNAPSHOT_H */
@@ -25,18 +25,42 @@
 
 
 #include "proxy/tls/MinerTls.h"
+#include "base/io/log/Log.h"
+
+
+#include <uv.h>
 
 
 xmrig::Miner::Tls::Tls(SSL_CTX *ctx, Miner *miner) :
     ServerTls(ctx),
     m_miner(miner)
 {
+#   ifndef _WIN32
+    uv_os_fd_t fd;
+    if (uv_fileno(reinterpret_cast<const uv_handle_t *>(miner->m_socket), &fd) == 0) {
+        setSocket(fd);
+    }
+#   endif
 }
 
 
-bool xmrig::Miner::Tls::write(BIO *bio)
+bool xmrig::Miner::Tls::isWriteQueued() const
 {
-    return m_miner->send(bio);
+    return reinterpret_cast<const uv_stream_t *>(m_miner->m_socket)->write_queue_size > 0;
+}
+
+
+bool xmrig::Miner::Tls::write(const char *data, size_t size)
+{
+    LOG_DEBUG("[%s] TLS send     (%zu bytes)", m_miner->m_ip, size);
+
+    if (!m_miner->write(data, size)) {
+        return false;
+    }
+
+    m_miner->m_tx += size;
+
+    return true;
 }
 
 
@@ -36,7 +36,8 @@ public:
     Tls(SSL_CTX *ctx, Miner *miner);
 
 protected:
-    bool write(BIO *bio) override;
+    bool isWriteQueued() const override;
+    bool write(const char *data, size_t size) override;
     void parse(char *data, size_t size) override;
     void shutdown() override;
 
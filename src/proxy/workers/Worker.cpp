@@ -26,6 +26,7 @@
 
 
 #include "base/net/stratum/SubmitResult.h"
+#include "proxy/state/StateRecord.h"
 #include "proxy/workers/Worker.h"
 
 
@@ -57,6 +58,24 @@ xmrig::Worker::Worker(size_t id, const std::string &name, const std::string &ip)
 }
 
 
+xmrig::Worker::Worker(size_t id, std::string &&name, std::string &&ip, const StateWorker &state, const uint32_t *history, size_t gap) :
+    m_id(id),
+    m_ip(std::move(ip)),
+    m_name(std::move(name)),
+    m_hashrate(4),
+    m_accepted(state.accepted),
+    m_connections(0),
+    m_hashes(state.hashes),
+    m_invalid(state.invalid),
+    m_lastHash(state.lastHash),
+    m_rejected(state.rejected)
+{
+    if (history) {
+        m_hashrate.restore(history, state.historySize, gap);
+    }
+}
+
+
 void xmrig::Worker::add(uint64_t diff)
 {
     m_accepted++;
@@ -35,17 +35,22 @@
 namespace xmrig {
 
 
+struct StateWorker;
+
+
 class Worker
 {
 public:
     Worker();
     Worker(size_t id, const std::string &name, const std::string &ip);
+    Worker(size_t id, std::string &&name, std::string &&ip, const StateWorker &state, const uint32_t *history, size_t gap);
 
     void add(uint64_t diff);
     void tick(uint64_t ticks);
 
     inline const char *ip() const             { return m_ip.c_str(); }
     inline const char *name() const           { return m_name.c_str(); }
+    inline const std::vector<uint32_t> &history() const { return m_hashrate.data(); }
     inline double hashrate(int seconds) const { return m_hashrate.calc(seconds); }
     inline size_t id() const                  { return m_id; }
     inline uint64_t accepted() const          { return m_accepted; }
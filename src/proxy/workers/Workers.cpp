@@ -124,6 +124,20 @@ void xmrig::Workers::reset()
 }
 
 
+void xmrig::Workers::restore(std::vector<Worker> &&workers)
+{
+    if (!m_workers.empty()) {
+        return;
+    }
+
+    m_workers = std::move(workers);
+
+    for (const Worker &worker : m_workers) {
+        m_map[worker.name()] = worker.id();
+    }
+}
+
+
 void xmrig::Workers::tick(uint64_t ticks)
 {
     if ((ticks % 4) != 0) {
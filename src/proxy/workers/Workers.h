@@ -65,6 +65,7 @@ public:
 
     void printWorkers();
     void reset();
+    void restore(std::vector<Worker> &&workers);
     void tick(uint64_t ticks);
 
     inline const std::vector<Worker> &workers() const { return m_workers; }
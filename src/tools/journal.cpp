@@ -0,0 +1,134 @@
+/* XMRig
+ * Copyright (c) 2018-2026 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2026 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * xmrig-proxy-journal: converts share journal segments (see doc/SHARE_JOURNAL.md) to CSV or JSON lines.
+ */
+
+
+#include "proxy/log/ShareRecord.h"
+
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+
+using namespace xmrig;
+
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [--csv|--json] <segment.jrnl>...\n", name);
+}
+
+
+static void print(const ShareRecord &record, bool json)
+{
+    if (json) {
+        printf("{\"timestamp\":%" PRIu64 ",\"miner_id\":%" PRId64 ",\"worker\":\"%016" PRIx64 "\",\"diff\":%" PRIu64 ",\"actual_diff\":%" PRIu64
+               ",\"mapper_id\":%u,\"result\":\"%s\",\"latency\":%u,\"donate\":%s,\"custom_diff\":%s}\n",
+               record.timestamp, record.minerId, record.workerHash, record.diff, record.actualDiff, record.mapperId,
+               record.result == ShareRecord::Accepted ? "accepted" : "rejected", record.latency,
+               (record.flags & ShareRecord::Donate) ? "true" : "false", (record.flags & ShareRecord::CustomDiff) ? "true" : "false");
+    }
+    else {
+        printf("%" PRIu64 ",%" PRId64 ",%016" PRIx64 ",%" PRIu64 ",%" PRIu64 ",%u,%s,%u,%d,%d\n",
+               record.timestamp, record.minerId, record.workerHash, record.diff, record.actualDiff, record.mapperId,
+               record.result == ShareRecord::Accepted ? "accepted" : "rejected", record.latency,
+               (record.flags & ShareRecord::Donate) ? 1 : 0, (record.flags & ShareRecord::CustomDiff) ? 1 : 0);
+    }
+}
+
+
+static bool dump(const char *fileName, bool json)
+{
+    FILE *fp = fopen(fileName, "rb");
+    if (!fp) {
+        fprintf(stderr, "%s: %s\n", fileName, strerror(errno));
+
+        return false;
+    }
+
+    ShareJournalHeader header{};
+    if (fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, ShareJournalHeader::kMagic, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "%s: not a share journal segment\n", fileName);
+        fclose(fp);
+
+        return false;
+    }
+
+    if (header.version != ShareJournalHeader::kVersion || header.recordSize != sizeof(ShareRecord)) {
+        fprintf(stderr, "%s: unsupported version %u\n", fileName, header.version);
+        fclose(fp);
+
+        return false;
+    }
+
+    // The count in the header is authoritative, a segment left by a crashed process is still full size and zero filled after the last record.
+    ShareRecord record{};
+    for (uint64_t i = 0; i < header.count && fread(&record, sizeof(record), 1, fp) == 1; ++i) {
+        print(record, json);
+    }
+
+    fclose(fp);
+
+    return true;
+}
+
+
+int main(int argc, char **argv)
+{
+    bool json = false;
+    int first = 1;
+
+    for (; first < argc && argv[first][0] == '-'; ++first) {
+        if (strcmp(argv[first], "--json") == 0) {
+            json = true;
+        }
+        else if (strcmp(argv[first], "--csv") == 0) {
+            json = false;
+        }
+        else {
+            usage(argv[0]);
+
+            return 1;
+        }
+    }
+
+    if (first == argc) {
+        usage(argv[0]);
+
+        return 1;
+    }
+
+    if (!json) {
+        printf("timestamp,miner_id,worker,diff,actual_diff,mapper_id,result,latency,donate,custom_diff\n");
+    }
+
+    int rc = 0;
+    for (int i = first; i < argc; ++i) {
+        if (!dump(argv[i], json)) {
+            rc = 1;
+        }
+    }
+
+    return rc;
+}